@@ -0,0 +1,190 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/minisql/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/minisql/src/CMakeLists.txt"
+  "/root/repo/minisql/test/CMakeLists.txt"
+  "/root/repo/minisql/thirdparty/glog/CMakeLists.txt"
+  "/root/repo/minisql/thirdparty/glog/cmake/DetermineGflagsNamespace.cmake"
+  "/root/repo/minisql/thirdparty/glog/cmake/FindUnwind.cmake"
+  "/root/repo/minisql/thirdparty/glog/cmake/GetCacheVariables.cmake"
+  "/root/repo/minisql/thirdparty/glog/glog-config.cmake.in"
+  "/root/repo/minisql/thirdparty/glog/glog-modules.cmake.in"
+  "/root/repo/minisql/thirdparty/glog/libglog.pc.in"
+  "/root/repo/minisql/thirdparty/glog/src/config.h.cmake.in"
+  "/root/repo/minisql/thirdparty/glog/src/glog/logging.h.in"
+  "/root/repo/minisql/thirdparty/glog/src/glog/raw_logging.h.in"
+  "/root/repo/minisql/thirdparty/glog/src/glog/stl_logging.h.in"
+  "/root/repo/minisql/thirdparty/glog/src/glog/vlog_is_on.h.in"
+  "/root/repo/minisql/thirdparty/googletest/CMakeLists.txt"
+  "/root/repo/minisql/thirdparty/googletest/cmake/Config.cmake.in"
+  "/root/repo/minisql/thirdparty/googletest/cmake/gtest.pc.in"
+  "/root/repo/minisql/thirdparty/googletest/cmake/gtest_main.pc.in"
+  "/root/repo/minisql/thirdparty/googletest/cmake/internal_utils.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-AnyNewerVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMajorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseArguments.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckFunctionExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckStructHasMember.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/GenerateExportHeader.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  "/usr/share/cmake-3.25/Modules/exportheader.cmake.in"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "googletest-build/generated/GTestConfigVersion.cmake"
+  "googletest-build/generated/GTestConfig.cmake"
+  "googletest-build/generated/gtest.pc"
+  "googletest-build/generated/gtest_main.pc"
+  "googletest-build/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "glog-build/DartConfiguration.tcl"
+  "glog-build/config.h"
+  "glog-build/glog/logging.h"
+  "glog-build/glog/raw_logging.h"
+  "glog-build/glog/stl_logging.h"
+  "glog-build/glog/vlog_is_on.h"
+  "glog-build/glog/export.h"
+  "glog-build/libglog.pc"
+  "glog-build/glog-config.cmake"
+  "glog-build/glog-config-version.cmake"
+  "glog-build/glog-modules.cmake"
+  "glog-build/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bin/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "googletest-build/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "googletest-build/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/glogbase.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/glog.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/glogtest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/logging_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/stl_logging_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/symbolize_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/demangle_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/stacktrace_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/utilities_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/signalhandler_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/cleanup_immediately_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/cleanup_with_absolute_prefix_unittest.dir/DependInfo.cmake"
+  "glog-build/CMakeFiles/cleanup_with_relative_prefix_unittest.dir/DependInfo.cmake"
+  "bin/CMakeFiles/zSql.dir/DependInfo.cmake"
+  "bin/CMakeFiles/main.dir/DependInfo.cmake"
+  "test/CMakeFiles/minisql_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/minisql_test_main.dir/DependInfo.cmake"
+  "test/CMakeFiles/buffer_pool_manager_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/clock_replacer_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/lru_k_replacer_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/lru_replacer_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/page_table_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/two_queue_replacer_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/catalog_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/lock_manager_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/executor_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/b_plus_tree_index_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/b_plus_tree_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/index_iterator_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/index_roots_page_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tuple_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/recovery_manager_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/disk_manager_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/table_heap_test.dir/DependInfo.cmake"
+  )
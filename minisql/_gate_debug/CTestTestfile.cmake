@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/minisql
+# Build directory: /root/repo/minisql/_gate_debug
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("googletest-build")
+subdirs("glog-build")
+subdirs("bin")
+subdirs("test")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cleanup_immediately_unittest.dir/src/cleanup_immediately_unittest.cc.o"
+  "CMakeFiles/cleanup_immediately_unittest.dir/src/cleanup_immediately_unittest.cc.o.d"
+  "cleanup_immediately_unittest"
+  "cleanup_immediately_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cleanup_immediately_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cleanup_with_absolute_prefix_unittest.dir/src/cleanup_with_absolute_prefix_unittest.cc.o"
+  "CMakeFiles/cleanup_with_absolute_prefix_unittest.dir/src/cleanup_with_absolute_prefix_unittest.cc.o.d"
+  "cleanup_with_absolute_prefix_unittest"
+  "cleanup_with_absolute_prefix_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cleanup_with_absolute_prefix_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demangle_unittest.dir/src/demangle_unittest.cc.o"
+  "CMakeFiles/demangle_unittest.dir/src/demangle_unittest.cc.o.d"
+  "demangle_unittest"
+  "demangle_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demangle_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
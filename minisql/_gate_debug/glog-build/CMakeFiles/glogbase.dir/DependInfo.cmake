@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/minisql/thirdparty/glog/src/demangle.cc" "glog-build/CMakeFiles/glogbase.dir/src/demangle.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/demangle.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/logging.cc" "glog-build/CMakeFiles/glogbase.dir/src/logging.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/logging.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/raw_logging.cc" "glog-build/CMakeFiles/glogbase.dir/src/raw_logging.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/raw_logging.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/signalhandler.cc" "glog-build/CMakeFiles/glogbase.dir/src/signalhandler.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/signalhandler.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/symbolize.cc" "glog-build/CMakeFiles/glogbase.dir/src/symbolize.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/symbolize.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/utilities.cc" "glog-build/CMakeFiles/glogbase.dir/src/utilities.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/utilities.cc.o.d"
+  "/root/repo/minisql/thirdparty/glog/src/vlog_is_on.cc" "glog-build/CMakeFiles/glogbase.dir/src/vlog_is_on.cc.o" "gcc" "glog-build/CMakeFiles/glogbase.dir/src/vlog_is_on.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/glogbase.dir/src/demangle.cc.o"
+  "CMakeFiles/glogbase.dir/src/demangle.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/logging.cc.o"
+  "CMakeFiles/glogbase.dir/src/logging.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/raw_logging.cc.o"
+  "CMakeFiles/glogbase.dir/src/raw_logging.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/signalhandler.cc.o"
+  "CMakeFiles/glogbase.dir/src/signalhandler.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/symbolize.cc.o"
+  "CMakeFiles/glogbase.dir/src/symbolize.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/utilities.cc.o"
+  "CMakeFiles/glogbase.dir/src/utilities.cc.o.d"
+  "CMakeFiles/glogbase.dir/src/vlog_is_on.cc.o"
+  "CMakeFiles/glogbase.dir/src/vlog_is_on.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/glogbase.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
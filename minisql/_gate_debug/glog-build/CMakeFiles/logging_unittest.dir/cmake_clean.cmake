@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/logging_unittest.dir/src/logging_unittest.cc.o"
+  "CMakeFiles/logging_unittest.dir/src/logging_unittest.cc.o.d"
+  "logging_unittest"
+  "logging_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/logging_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
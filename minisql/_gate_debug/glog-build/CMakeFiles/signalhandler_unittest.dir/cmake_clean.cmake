@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/signalhandler_unittest.dir/src/signalhandler_unittest.cc.o"
+  "CMakeFiles/signalhandler_unittest.dir/src/signalhandler_unittest.cc.o.d"
+  "signalhandler_unittest"
+  "signalhandler_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/signalhandler_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
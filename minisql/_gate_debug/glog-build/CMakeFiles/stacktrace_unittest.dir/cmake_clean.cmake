@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stacktrace_unittest.dir/src/stacktrace_unittest.cc.o"
+  "CMakeFiles/stacktrace_unittest.dir/src/stacktrace_unittest.cc.o.d"
+  "stacktrace_unittest"
+  "stacktrace_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stacktrace_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stl_logging_unittest.dir/src/stl_logging_unittest.cc.o"
+  "CMakeFiles/stl_logging_unittest.dir/src/stl_logging_unittest.cc.o.d"
+  "stl_logging_unittest"
+  "stl_logging_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stl_logging_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
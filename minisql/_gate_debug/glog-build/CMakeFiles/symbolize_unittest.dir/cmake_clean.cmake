@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/symbolize_unittest.dir/src/symbolize_unittest.cc.o"
+  "CMakeFiles/symbolize_unittest.dir/src/symbolize_unittest.cc.o.d"
+  "symbolize_unittest"
+  "symbolize_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/symbolize_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/utilities_unittest.dir/src/utilities_unittest.cc.o"
+  "CMakeFiles/utilities_unittest.dir/src/utilities_unittest.cc.o.d"
+  "utilities_unittest"
+  "utilities_unittest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utilities_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
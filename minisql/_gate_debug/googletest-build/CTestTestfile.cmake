@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/minisql/thirdparty/googletest
+# Build directory: /root/repo/minisql/_gate_debug/googletest-build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/minisql/test/index/b_plus_tree_index_test.cpp" "test/CMakeFiles/b_plus_tree_index_test.dir/index/b_plus_tree_index_test.cpp.o" "gcc" "test/CMakeFiles/b_plus_tree_index_test.dir/index/b_plus_tree_index_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/minisql/_gate_debug/bin/CMakeFiles/zSql.dir/DependInfo.cmake"
+  "/root/repo/minisql/_gate_debug/test/CMakeFiles/minisql_test_main.dir/DependInfo.cmake"
+  "/root/repo/minisql/_gate_debug/glog-build/CMakeFiles/glog.dir/DependInfo.cmake"
+  "/root/repo/minisql/_gate_debug/googletest-build/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/index_iterator_test.dir/index/index_iterator_test.cpp.o"
+  "CMakeFiles/index_iterator_test.dir/index/index_iterator_test.cpp.o.d"
+  "index_iterator_test"
+  "index_iterator_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/index_iterator_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
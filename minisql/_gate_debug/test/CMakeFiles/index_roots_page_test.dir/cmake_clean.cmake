@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/index_roots_page_test.dir/page/index_roots_page_test.cpp.o"
+  "CMakeFiles/index_roots_page_test.dir/page/index_roots_page_test.cpp.o.d"
+  "index_roots_page_test"
+  "index_roots_page_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/index_roots_page_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/lru_replacer_test.dir/buffer/lru_replacer_test.cpp.o"
+  "CMakeFiles/lru_replacer_test.dir/buffer/lru_replacer_test.cpp.o.d"
+  "lru_replacer_test"
+  "lru_replacer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/lru_replacer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/minisql/test/buffer/buffer_pool_manager_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/buffer_pool_manager_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/buffer_pool_manager_test.cpp.o.d"
+  "/root/repo/minisql/test/buffer/clock_replacer_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/clock_replacer_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/clock_replacer_test.cpp.o.d"
+  "/root/repo/minisql/test/buffer/lru_k_replacer_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/lru_k_replacer_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/lru_k_replacer_test.cpp.o.d"
+  "/root/repo/minisql/test/buffer/lru_replacer_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/lru_replacer_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/lru_replacer_test.cpp.o.d"
+  "/root/repo/minisql/test/buffer/page_table_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/page_table_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/page_table_test.cpp.o.d"
+  "/root/repo/minisql/test/buffer/two_queue_replacer_test.cpp" "test/CMakeFiles/minisql_test.dir/buffer/two_queue_replacer_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/buffer/two_queue_replacer_test.cpp.o.d"
+  "/root/repo/minisql/test/catalog/catalog_test.cpp" "test/CMakeFiles/minisql_test.dir/catalog/catalog_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/catalog/catalog_test.cpp.o.d"
+  "/root/repo/minisql/test/concurrency/lock_manager_test.cpp" "test/CMakeFiles/minisql_test.dir/concurrency/lock_manager_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/concurrency/lock_manager_test.cpp.o.d"
+  "/root/repo/minisql/test/execution/executor_test.cpp" "test/CMakeFiles/minisql_test.dir/execution/executor_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/execution/executor_test.cpp.o.d"
+  "/root/repo/minisql/test/index/b_plus_tree_index_test.cpp" "test/CMakeFiles/minisql_test.dir/index/b_plus_tree_index_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/index/b_plus_tree_index_test.cpp.o.d"
+  "/root/repo/minisql/test/index/b_plus_tree_test.cpp" "test/CMakeFiles/minisql_test.dir/index/b_plus_tree_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/index/b_plus_tree_test.cpp.o.d"
+  "/root/repo/minisql/test/index/index_iterator_test.cpp" "test/CMakeFiles/minisql_test.dir/index/index_iterator_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/index/index_iterator_test.cpp.o.d"
+  "/root/repo/minisql/test/main_test.cpp" "test/CMakeFiles/minisql_test.dir/main_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/main_test.cpp.o.d"
+  "/root/repo/minisql/test/page/index_roots_page_test.cpp" "test/CMakeFiles/minisql_test.dir/page/index_roots_page_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/page/index_roots_page_test.cpp.o.d"
+  "/root/repo/minisql/test/record/tuple_test.cpp" "test/CMakeFiles/minisql_test.dir/record/tuple_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/record/tuple_test.cpp.o.d"
+  "/root/repo/minisql/test/recovery/recovery_manager_test.cpp" "test/CMakeFiles/minisql_test.dir/recovery/recovery_manager_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/recovery/recovery_manager_test.cpp.o.d"
+  "/root/repo/minisql/test/storage/disk_manager_test.cpp" "test/CMakeFiles/minisql_test.dir/storage/disk_manager_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/storage/disk_manager_test.cpp.o.d"
+  "/root/repo/minisql/test/storage/table_heap_test.cpp" "test/CMakeFiles/minisql_test.dir/storage/table_heap_test.cpp.o" "gcc" "test/CMakeFiles/minisql_test.dir/storage/table_heap_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/minisql/_gate_debug/bin/CMakeFiles/zSql.dir/DependInfo.cmake"
+  "/root/repo/minisql/_gate_debug/glog-build/CMakeFiles/glog.dir/DependInfo.cmake"
+  "/root/repo/minisql/_gate_debug/googletest-build/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
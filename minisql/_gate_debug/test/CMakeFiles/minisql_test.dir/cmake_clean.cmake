@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/minisql_test.dir/buffer/buffer_pool_manager_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/buffer_pool_manager_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/buffer/clock_replacer_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/clock_replacer_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/buffer/lru_k_replacer_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/lru_k_replacer_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/buffer/lru_replacer_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/lru_replacer_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/buffer/page_table_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/page_table_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/buffer/two_queue_replacer_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/buffer/two_queue_replacer_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/catalog/catalog_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/catalog/catalog_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/concurrency/lock_manager_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/concurrency/lock_manager_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/execution/executor_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/execution/executor_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/index/b_plus_tree_index_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/index/b_plus_tree_index_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/index/b_plus_tree_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/index/b_plus_tree_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/index/index_iterator_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/index/index_iterator_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/main_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/main_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/page/index_roots_page_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/page/index_roots_page_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/record/tuple_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/record/tuple_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/recovery/recovery_manager_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/recovery/recovery_manager_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/storage/disk_manager_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/storage/disk_manager_test.cpp.o.d"
+  "CMakeFiles/minisql_test.dir/storage/table_heap_test.cpp.o"
+  "CMakeFiles/minisql_test.dir/storage/table_heap_test.cpp.o.d"
+  "minisql_test"
+  "minisql_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/minisql_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
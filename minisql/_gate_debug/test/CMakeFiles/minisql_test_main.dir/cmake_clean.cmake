@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/minisql_test_main.dir/main_test.cpp.o"
+  "CMakeFiles/minisql_test_main.dir/main_test.cpp.o.d"
+  "libminisql_test_main.pdb"
+  "libminisql_test_main.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/minisql_test_main.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/page_table_test.dir/buffer/page_table_test.cpp.o"
+  "CMakeFiles/page_table_test.dir/buffer/page_table_test.cpp.o.d"
+  "page_table_test"
+  "page_table_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/page_table_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/recovery_manager_test.dir/recovery/recovery_manager_test.cpp.o"
+  "CMakeFiles/recovery_manager_test.dir/recovery/recovery_manager_test.cpp.o.d"
+  "recovery_manager_test"
+  "recovery_manager_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/recovery_manager_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
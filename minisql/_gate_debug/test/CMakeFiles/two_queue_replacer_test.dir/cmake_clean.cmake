@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/two_queue_replacer_test.dir/buffer/two_queue_replacer_test.cpp.o"
+  "CMakeFiles/two_queue_replacer_test.dir/buffer/two_queue_replacer_test.cpp.o.d"
+  "two_queue_replacer_test"
+  "two_queue_replacer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/two_queue_replacer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/minisql/test
+# Build directory: /root/repo/minisql/_gate_debug/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(buffer_pool_manager_test "/root/repo/minisql/_gate_debug/test/buffer_pool_manager_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/buffer_pool_manager_test.xml")
+set_tests_properties(buffer_pool_manager_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(clock_replacer_test "/root/repo/minisql/_gate_debug/test/clock_replacer_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/clock_replacer_test.xml")
+set_tests_properties(clock_replacer_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(lru_k_replacer_test "/root/repo/minisql/_gate_debug/test/lru_k_replacer_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/lru_k_replacer_test.xml")
+set_tests_properties(lru_k_replacer_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(lru_replacer_test "/root/repo/minisql/_gate_debug/test/lru_replacer_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/lru_replacer_test.xml")
+set_tests_properties(lru_replacer_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(page_table_test "/root/repo/minisql/_gate_debug/test/page_table_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/page_table_test.xml")
+set_tests_properties(page_table_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(two_queue_replacer_test "/root/repo/minisql/_gate_debug/test/two_queue_replacer_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/two_queue_replacer_test.xml")
+set_tests_properties(two_queue_replacer_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(catalog_test "/root/repo/minisql/_gate_debug/test/catalog_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/catalog_test.xml")
+set_tests_properties(catalog_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(lock_manager_test "/root/repo/minisql/_gate_debug/test/lock_manager_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/lock_manager_test.xml")
+set_tests_properties(lock_manager_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(executor_test "/root/repo/minisql/_gate_debug/test/executor_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/executor_test.xml")
+set_tests_properties(executor_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(b_plus_tree_index_test "/root/repo/minisql/_gate_debug/test/b_plus_tree_index_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/b_plus_tree_index_test.xml")
+set_tests_properties(b_plus_tree_index_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(b_plus_tree_test "/root/repo/minisql/_gate_debug/test/b_plus_tree_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/b_plus_tree_test.xml")
+set_tests_properties(b_plus_tree_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(index_iterator_test "/root/repo/minisql/_gate_debug/test/index_iterator_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/index_iterator_test.xml")
+set_tests_properties(index_iterator_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(index_roots_page_test "/root/repo/minisql/_gate_debug/test/index_roots_page_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/index_roots_page_test.xml")
+set_tests_properties(index_roots_page_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(tuple_test "/root/repo/minisql/_gate_debug/test/tuple_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/tuple_test.xml")
+set_tests_properties(tuple_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(recovery_manager_test "/root/repo/minisql/_gate_debug/test/recovery_manager_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/recovery_manager_test.xml")
+set_tests_properties(recovery_manager_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(disk_manager_test "/root/repo/minisql/_gate_debug/test/disk_manager_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/disk_manager_test.xml")
+set_tests_properties(disk_manager_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
+add_test(table_heap_test "/root/repo/minisql/_gate_debug/test/table_heap_test" "--gtest_color=yes" "--gtest_output=xml:/root/repo/minisql/_gate_debug/test/table_heap_test.xml")
+set_tests_properties(table_heap_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/minisql/test/CMakeLists.txt;30;add_test;/root/repo/minisql/test/CMakeLists.txt;0;")
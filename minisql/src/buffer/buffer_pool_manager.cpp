@@ -1,25 +1,88 @@
 #include "buffer/buffer_pool_manager.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+#include "buffer/two_queue_replacer.h"
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
 
 static const char EMPTY_PAGE_DATA[PAGE_SIZE] = {0};
 
-BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
+static Replacer *CreateReplacer(ReplacerType replacer_type, size_t num_pages) {
+  switch (replacer_type) {
+    case ReplacerType::kClock:
+      return new CLOCKReplacer(num_pages);
+    case ReplacerType::kLRUK:
+      return new LRUKReplacer(num_pages);
+    case ReplacerType::k2Q:
+      return new TwoQueueReplacer(num_pages);
+    case ReplacerType::kLRU:
+    default:
+      return new LRUReplacer(num_pages);
+  }
+}
+
+BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_shards,
+                                     ReplacerType replacer_type)
     : pool_size_(pool_size), disk_manager_(disk_manager) {
+  ASSERT(num_shards > 0 && num_shards <= pool_size, "Invalid number of buffer pool shards.");
+  if (disk_manager_->IsReadOnly()) {
+    // No frames, pages are handed out straight from the mapping.
+    read_only_ = true;
+    num_mapped_pages_ = disk_manager_->GetLogicalPageCount();
+    mapped_pages_ = new std::atomic<Page *>[num_mapped_pages_]();
+    pages_ = nullptr;
+    return;
+  }
   pages_ = new Page[pool_size_];
-  replacer_ = new LRUReplacer(pool_size_);
-  for (size_t i = 0; i < pool_size_; i++) {
-    free_list_.emplace_back(i);
+  // Split the frames as evenly as possible, the first (pool_size % num_shards) shards get one extra frame.
+  size_t offset = 0;
+  for (size_t i = 0; i < num_shards; i++) {
+    auto *shard = new Shard(pages_ + offset, pool_size_ / num_shards + (i < pool_size_ % num_shards ? 1 : 0));
+    shard->replacer_ = CreateReplacer(replacer_type, shard->pool_size_);
+    // Pins bypass the replacer, so it has to ask. Claiming the frame here keeps a concurrent hit from pinning it.
+    Page *pages = shard->pages_;
+    shard->replacer_->SetEvictionFilter([pages](frame_id_t frame_id) {
+      int expected = 0;
+      return pages[frame_id].pin_count_.compare_exchange_strong(expected, FRAME_LOCKED, std::memory_order_acquire);
+    });
+    for (size_t j = 0; j < shard->pool_size_; j++) {
+      shard->pages_[j].pin_count_ = FRAME_LOCKED;
+      shard->free_list_.emplace_back(j);
+    }
+    offset += shard->pool_size_;
+    shards_.push_back(shard);
   }
 }
 
 BufferPoolManager::~BufferPoolManager() {
-  for (auto page : page_table_) {
-    FlushPage(page.first);
+  StopFlusher();
+  if (prefetcher_.joinable()) {
+    {
+      std::scoped_lock<std::mutex> prefetch_lock(prefetch_latch_);
+      prefetch_stop_ = true;
+    }
+    prefetch_cv_.notify_one();
+    prefetcher_.join();
+  }
+  for (size_t i = 0; pages_ != nullptr && i < pool_size_; i++) {
+    if (pages_[i].page_id_ != INVALID_PAGE_ID) {
+      FlushPage(pages_[i].page_id_);
+    }
+  }
+  for (size_t i = 0; i < num_mapped_pages_; i++) {
+    delete mapped_pages_[i].load(std::memory_order_relaxed);
+  }
+  delete[] mapped_pages_;
+  for (auto shard : shards_) {
+    delete shard->replacer_;
+    delete shard;
   }
   delete[] pages_;
-  delete replacer_;
 }
 
 /**
@@ -34,39 +97,60 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
     // 3.     Delete R from the page table and insert P.
     // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
 
-    frame_id_t frame_id = 0;
-
     if (page_id > MAX_VALID_PAGE_ID || page_id <= INVALID_PAGE_ID)
         return nullptr;
-    
-    if (page_table_.find(page_id) != page_table_.end()) { // If P exists, pin it and return it immediately.
-        frame_id = page_table_[page_id];
-        replacer_->Pin(frame_id);  // Don't forget to unpin it!
-        pages_[frame_id].pin_count_++; // Recording the number of threads pinning this page.
-        return &pages_[frame_id];
+    if (read_only_)
+        return FetchMappedPage(page_id);
+
+    Shard &shard = GetShard(page_id);
+
+    // Optimistic hit path: no latch. The page table entry may be stale, so pin first and then make sure the frame
+    // still holds P. Eviction only takes frames whose pin count it can swing from 0 to FRAME_LOCKED, so once the pin
+    // succeeded and the page id matches, the page stays put until it is unpinned.
+    frame_id_t frame_id = shard.page_table_.Find(page_id);
+    if (frame_id != INVALID_FRAME_ID) {
+        Page &page = shard.pages_[frame_id];
+        if (TryPin(page)) {
+            if (page.page_id_.load(std::memory_order_acquire) == page_id) {
+                RecordHit(shard, frame_id);
+                return &page;
+            }
+            page.pin_count_.fetch_sub(1, std::memory_order_release); // The frame was reused for another page.
+        }
     }
 
-    // If P does not exist, find a replacement page (R) from either the free list or the replacer.
-    if (!free_list_.empty()) { // Buffer pool is not full.
-        frame_id = free_list_.front();
-        free_list_.pop_front();
-    }
-    else { // Buffer pool is full
-        if (!(replacer_->Victim(&frame_id))) // LRU strategy.
-            return nullptr;
-        if (pages_[frame_id].IsDirty()) 
-            disk_manager_->WritePage(pages_[frame_id].GetPageId(), pages_[frame_id].GetData());
-        page_table_.erase(pages_[frame_id].GetPageId());
+    std::unique_lock<std::recursive_mutex> lock(shard.latch_);
+    DrainAccesses(shard);
+
+    frame_id = shard.page_table_.Find(page_id);
+    while (frame_id != INVALID_FRAME_ID) { // If P exists, pin it and return it immediately.
+        Page &page = shard.pages_[frame_id];
+        if (TryPin(page)) { // Don't forget to unpin it!
+            shard.replacer_->RecordAccess(frame_id);
+            shard.hits_.fetch_add(1, std::memory_order_relaxed);
+            return &page;
+        }
+        // A mapped frame is only locked while a background read or write of it is in flight, wait for it to finish.
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+        frame_id = shard.page_table_.Find(page_id);
     }
+    shard.misses_.fetch_add(1, std::memory_order_relaxed);
 
-    pages_[frame_id].ResetMemory();
-    page_table_[page_id] = frame_id;
-    pages_[frame_id].pin_count_ = 1;
-    pages_[frame_id].page_id_ = page_id;
-    pages_[frame_id].is_dirty_ = false;
-    disk_manager_->ReadPage(page_id, pages_[frame_id].data_);
+    // If P does not exist, find a replacement page (R) from either the free list or the replacer.
+    if (!TryToFindFreePage(shard, &frame_id))
+        return nullptr;
+
+    Page &page = shard.pages_[frame_id];
+    page.ResetMemory();
+    if (!disk_manager_->ReadPage(page_id, page.data_)) { // Corrupted on disk, do not hand it out.
+        shard.free_list_.push_back(frame_id);
+        return nullptr;
+    }
+    InstallPage(shard, frame_id, page_id);
 
-    return &pages_[frame_id];
+    return &page;
 }
 
 /**
@@ -79,36 +163,50 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
     // 3.   Update P's metadata, zero out memory and add P to the page table.
     // 4.   Set the page ID output parameter. Return a pointer to P.
 
-    frame_id_t frame_id = 0;
-    
-    if (!free_list_.empty()) { // Pick a victim page P from the free list.
-        frame_id = free_list_.front();
-        free_list_.pop_front();
+    // The page id decides which shard owns the page, so it has to be allocated before a frame is picked.
+    if (read_only_)
+        return nullptr;
+    page_id_t new_page_id = AllocatePage(); // Make sure you call AllocatePage!
+    if (new_page_id == INVALID_PAGE_ID)
+        return nullptr;
 
-        // std::cout << "[DEBUG] Pick a victim page P from the free list." << std::endl;
+    Shard &shard = GetShard(new_page_id);
+    std::unique_lock<std::recursive_mutex> lock(shard.latch_);
+
+    // A prefetch may have read the page between its allocation and now, drop that stale copy.
+    frame_id_t frame_id = shard.page_table_.Find(new_page_id);
+    while (frame_id != INVALID_FRAME_ID) {
+        Page &stale = shard.pages_[frame_id];
+        int expected = 0;
+        if (stale.pin_count_.compare_exchange_strong(expected, FRAME_LOCKED, std::memory_order_acquire)) {
+            shard.replacer_->Pin(frame_id);
+            shard.page_table_.Erase(new_page_id);
+            stale.page_id_ = INVALID_PAGE_ID;
+            shard.free_list_.push_back(frame_id);
+            break;
+        }
+        if (expected > 0)
+            break;
+        // The prefetch read is still in flight.
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+        frame_id = shard.page_table_.Find(new_page_id);
     }
-    else {  // Pick a victim page P from the replacer.
-
-        // std::cout << "[DEBUG] Pick a victim page P from the replacer." << std::endl;
 
-        if (!(replacer_->Victim(&frame_id))) // If all the pages in the buffer pool are pinned, return nullptr.
-            return nullptr;
-        if (pages_[frame_id].IsDirty())
-            disk_manager_->WritePage(pages_[frame_id].GetPageId(), pages_[frame_id].GetData());
-        page_table_.erase(pages_[frame_id].GetPageId());
+    if (!TryToFindFreePage(shard, &frame_id)) { // If all the pages in the shard are pinned, give the page id back.
+        lock.unlock();
+        DeallocatePage(new_page_id);
+        return nullptr;
     }
-    
-    page_id = AllocatePage(); // Make sure you call AllocatePage!
-    // std::cout << "[DEBUG] AllocatePage returned: " << page_id << std::endl;
 
     // Update P's metadata, zero out memory and add P to the page table.
-    pages_[frame_id].ResetMemory();
-    page_table_[page_id] = frame_id;
-    pages_[frame_id].pin_count_ = 1;
-    pages_[frame_id].page_id_ = page_id;
-    pages_[frame_id].is_dirty_ = false;
+    Page &page = shard.pages_[frame_id];
+    page.ResetMemory();
+    InstallPage(shard, frame_id, new_page_id);
 
-    return &pages_[frame_id];
+    page_id = new_page_id;
+    return &page;
 }
 
 /**
@@ -121,24 +219,31 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
     // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
     // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
 
-    if (page_table_.find(page_id) != page_table_.end()) // If P does not exist, return true.
-        return true;
-
-    frame_id_t frame_id = page_table_[page_id]; // Search the page table for the requested page (P).
-
-    if (pages_[frame_id].pin_count_ > 0) // If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+    if (read_only_)
         return false;
+    Shard &shard = GetShard(page_id);
+    std::unique_lock<std::recursive_mutex> lock(shard.latch_);
+
+    frame_id_t frame_id = shard.page_table_.Find(page_id); // Search the page table for the requested page (P).
+    if (frame_id != INVALID_FRAME_ID) {
+        Page &page = shard.pages_[frame_id];
+        int expected = 0;
+        // If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+        if (!page.pin_count_.compare_exchange_strong(expected, FRAME_LOCKED, std::memory_order_acquire))
+            return false;
+
+        // Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
+        // The frame stays locked while it sits in the free list.
+        shard.replacer_->Pin(frame_id); // Take the frame out of the replacer.
+        shard.page_table_.Erase(page_id);
+        page.ResetMemory();
+        page.page_id_ = INVALID_PAGE_ID;
+        page.is_dirty_ = false;
+        shard.free_list_.push_back(frame_id);
+    }
+    lock.unlock();
 
-    // Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-    page_table_.erase(page_id);
-    pages_[frame_id].ResetMemory();
-    pages_[frame_id].pin_count_ = 0;
-    pages_[frame_id].page_id_ = INVALID_PAGE_ID;
-    pages_[frame_id].is_dirty_ = false;
-    free_list_.push_back(frame_id);
-
-    disk_manager_->DeAllocatePage(page_id); // Make sure you call DeallocatePage!
-    
+    DeallocatePage(page_id); // Make sure you call DeallocatePage!
     return true;
 }
 
@@ -146,22 +251,40 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
  * TODO: Student Implement
  */
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
-    
-    if (page_table_.find(page_id) == page_table_.end()) // If page P dosen't exist.
+    if (read_only_) {
+        if (page_id < 0 || static_cast<size_t>(page_id) >= num_mapped_pages_)
+            return false;
+        Page *page = mapped_pages_[page_id].load(std::memory_order_acquire);
+        if (page == nullptr || page->pin_count_.load(std::memory_order_relaxed) <= 0)
+            return false;
+        if (is_dirty)
+            LOG(ERROR) << "Page " << page_id << " of a read-only database unpinned as dirty.";
+        page->pin_count_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+    Shard &shard = GetShard(page_id);
+
+    // The caller holds a pin, so P cannot move and the lock-free lookup is exact unless the table is being rebuilt.
+    frame_id_t frame_id = shard.page_table_.Find(page_id);
+    if (frame_id == INVALID_FRAME_ID) {
+        std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
+        frame_id = shard.page_table_.Find(page_id);
+    }
+    if (frame_id == INVALID_FRAME_ID) // If page P dosen't exist.
         return false;
-      
-    frame_id_t frame_id = page_table_[page_id];
 
-    if (pages_[frame_id].pin_count_ == 0) // Return true when P is unpinned already.
-        return true;
+    Page &page = shard.pages_[frame_id];
+    if (page.page_id_.load(std::memory_order_acquire) != page_id)
+        return false;
 
-    // Unpin
-    pages_[frame_id].pin_count_--; 
-    replacer_->Unpin(frame_id);
+    if (is_dirty)
+        page.is_dirty_.store(true, std::memory_order_release); // True if the page is dirty, published by the unpin below.
 
-    if (is_dirty) 
-        pages_[frame_id].is_dirty_ = true; // True if the page is dirty.
-    
+    // Return true when P is unpinned already. The replacer already tracks the frame, eviction checks the pin count.
+    int pin_count = page.pin_count_.load(std::memory_order_relaxed);
+    while (pin_count > 0 &&
+           !page.pin_count_.compare_exchange_weak(pin_count, pin_count - 1, std::memory_order_release)) {
+    }
     return true;
 }
 
@@ -169,16 +292,474 @@ bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
  * TODO: Student Implement
  */
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
+    if (read_only_)
+        return false;
+    Shard &shard = GetShard(page_id);
+    std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
 
-    if (page_table_.find(page_id) == page_table_.end()) // If page P dosen't exist.
-          return false;
-      
-    frame_id_t frame_id = page_table_[page_id];
+    frame_id_t frame_id = shard.page_table_.Find(page_id);
+    if (frame_id == INVALID_FRAME_ID) // If page P dosen't exist.
+        return false;
 
-    disk_manager_->WritePage(page_id, pages_[frame_id].GetData());
+    Page &page = shard.pages_[frame_id];
+    // Clean before the write, so that an unpin marking the page dirty while it is written is not lost.
+    page.is_dirty_.exchange(false, std::memory_order_acq_rel);
+    if (!disk_manager_->WritePage(page_id, page.GetData())) {
+        page.is_dirty_.store(true, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+bool BufferPoolManager::TryToFindFreePage(Shard &shard, frame_id_t *frame_id) {
+  if (!shard.free_list_.empty()) {  // Buffer pool is not full.
+    *frame_id = shard.free_list_.front();
+    shard.free_list_.pop_front();
     return true;
+  }
+  // The eviction filter has already locked the victim.
+  if (!shard.replacer_->Victim(frame_id)) {  // Every frame of the shard is pinned.
+    return false;
+  }
+  Page &victim = shard.pages_[*frame_id];
+  if (victim.IsDirty()) {
+    if (!WriteBackVictim(shard, victim)) {
+      // Keep the page rather than lose it, a later eviction or flush tries again.
+      victim.pin_count_.store(0, std::memory_order_release);
+      shard.replacer_->Unpin(*frame_id);
+      return false;
+    }
+    // If the flusher is running it is falling behind, do not wait for its next round.
+    std::scoped_lock<std::mutex> flusher_lock(flusher_latch_);
+    flusher_wakeup_ = true;
+    flusher_cv_.notify_one();
+  }
+  shard.page_table_.Erase(victim.GetPageId());
+  victim.page_id_ = INVALID_PAGE_ID;
+  return true;
+}
+
+bool BufferPoolManager::WriteBackVictim(Shard &shard, Page &victim) {
+  // Lock a dirty unpinned neighbour so that nobody writes to it while it is on its way to disk.
+  auto lock_neighbour = [this, &shard](page_id_t page_id) -> Page * {
+    if (page_id < 0 || &GetShard(page_id) != &shard) {
+      return nullptr;  // Neighbours live in other shards unless there is only one.
+    }
+    frame_id_t frame_id = shard.page_table_.Find(page_id);
+    if (frame_id == INVALID_FRAME_ID) {
+      return nullptr;
+    }
+    Page &page = shard.pages_[frame_id];
+    int expected = 0;
+    if (!page.IsDirty() || !page.pin_count_.compare_exchange_strong(expected, FRAME_LOCKED, std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &page;
+  };
+  page_id_t first_page_id = victim.GetPageId();
+  std::deque<Page *> run{&victim};
+  while (run.size() < MAX_COALESCED_PAGES) {
+    page_id_t last_page_id = first_page_id + static_cast<page_id_t>(run.size()) - 1;
+    Page *page = DiskManager::IsNextPhysicalPage(last_page_id, last_page_id + 1) ? lock_neighbour(last_page_id + 1)
+                                                                                 : nullptr;
+    if (page == nullptr) {
+      break;
+    }
+    run.push_back(page);
+  }
+  while (run.size() < MAX_COALESCED_PAGES) {
+    Page *page = DiskManager::IsNextPhysicalPage(first_page_id - 1, first_page_id) ? lock_neighbour(first_page_id - 1)
+                                                                                   : nullptr;
+    if (page == nullptr) {
+      break;
+    }
+    run.push_front(page);
+    first_page_id--;
+  }
+  vector<char *> data;
+  for (Page *page : run) {
+    page->is_dirty_.exchange(false, std::memory_order_acq_rel);
+    data.push_back(page->GetData());
+  }
+  bool written = disk_manager_->WritePages(first_page_id, run.size(), data.data());
+  for (Page *page : run) {
+    if (!written) {
+      page->is_dirty_.store(true, std::memory_order_release);
+    }
+    if (page != &victim) {
+      page->pin_count_.store(0, std::memory_order_release);  // The neighbours stay resident.
+    }
+  }
+  if (written) {
+    foreground_writes_.fetch_add(run.size(), std::memory_order_relaxed);
+  }
+  return written;
+}
+
+void BufferPoolManager::InstallPage(Shard &shard, frame_id_t frame_id, page_id_t page_id, bool pin) {
+  Page &page = shard.pages_[frame_id];
+  page.page_id_.store(page_id, std::memory_order_relaxed);
+  page.is_dirty_.store(false, std::memory_order_relaxed);
+  page.pin_count_.store(pin ? 1 : 0, std::memory_order_release);  // Publishes the data and the metadata above.
+  shard.page_table_.Insert(page_id, frame_id);
+  shard.replacer_->Unpin(frame_id);
+}
+
+void BufferPoolManager::RecordHit(Shard &shard, frame_id_t frame_id) {
+  shard.hits_.fetch_add(1, std::memory_order_relaxed);
+  size_t slot = shard.num_accesses_.fetch_add(1, std::memory_order_relaxed);
+  if (slot >= Shard::ACCESS_BUFFER_SIZE) {
+    return;
+  }
+  shard.accesses_[slot].store(frame_id, std::memory_order_release);
+  if (slot == Shard::ACCESS_BUFFER_SIZE - 1) {
+    std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
+    DrainAccesses(shard);
+  }
 }
 
+void BufferPoolManager::DrainAccesses(Shard &shard) {
+  size_t count = std::min(shard.num_accesses_.load(std::memory_order_acquire), Shard::ACCESS_BUFFER_SIZE);
+  for (size_t i = 0; i < count; i++) {
+    // A slot whose writer has not stored yet reads as invalid and that hit is lost.
+    frame_id_t frame_id = shard.accesses_[i].exchange(INVALID_FRAME_ID, std::memory_order_acquire);
+    if (frame_id != INVALID_FRAME_ID) {
+      shard.replacer_->RecordAccess(frame_id);
+    }
+  }
+  shard.num_accesses_.store(0, std::memory_order_release);
+}
+
+size_t BufferPoolManager::GetHitCount() const {
+  size_t hits = 0;
+  for (auto shard : shards_) {
+    hits += shard->hits_.load(std::memory_order_relaxed);
+  }
+  return hits;
+}
+
+size_t BufferPoolManager::GetMissCount() const {
+  size_t misses = 0;
+  for (auto shard : shards_) {
+    misses += shard->misses_.load(std::memory_order_relaxed);
+  }
+  return misses;
+}
+
+void BufferPoolManager::Prefetch(page_id_t page_id, size_t count) {
+  if (read_only_ || !read_ahead_.load(std::memory_order_relaxed)) {  // The kernel reads the mapping ahead itself.
+    return;
+  }
+  std::unique_lock<std::mutex> prefetch_lock(prefetch_latch_, std::defer_lock);
+  for (size_t i = 0; i < count; i++, page_id++) {
+    if (page_id > MAX_VALID_PAGE_ID || page_id <= INVALID_PAGE_ID) {
+      break;
+    }
+    if (GetShard(page_id).page_table_.Find(page_id) != INVALID_FRAME_ID) {
+      continue;  // Already resident, or will be checked again by the prefetch thread.
+    }
+    if (!prefetch_lock.owns_lock()) {
+      prefetch_lock.lock();
+    }
+    if (prefetch_queue_.size() >= pool_size_ / 2) {
+      break;  // Prefetching more than half of the pool would only evict pages that were read ahead.
+    }
+    prefetch_queue_.push_back(page_id);
+  }
+  if (!prefetch_lock.owns_lock()) {
+    return;
+  }
+  if (!prefetcher_.joinable()) {
+    prefetcher_ = std::thread(&BufferPoolManager::PrefetchLoop, this);
+  }
+  prefetch_lock.unlock();
+  prefetch_cv_.notify_one();
+}
+
+void BufferPoolManager::PrefetchLoop() {
+  auto io = disk_manager_->CreateAsyncIOContext(ASYNC_IO_QUEUE_DEPTH);
+  vector<page_id_t> batch;
+  vector<pair<Shard *, frame_id_t>> frames;
+  vector<page_id_t> page_ids;
+  vector<iovec> iov;
+  vector<pair<size_t, size_t>> runs;  // [begin, end) of frames read by one request
+  vector<AsyncIOResult> results;
+  // Hand the frames of run r over to FetchPage, or if they were not read, unmap them and let a FetchPage read them
+  // again and report the error.
+  auto release = [this, &frames, &runs](size_t r, bool read) {
+    for (size_t i = runs[r].first; i < runs[r].second; i++) {
+      Shard &shard = *frames[i].first;
+      std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
+      Page &page = shard.pages_[frames[i].second];
+      if (!read) {
+        shard.page_table_.Erase(page.GetPageId());
+        page.page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+        shard.free_list_.push_back(frames[i].second);
+        continue;
+      }
+      page.pin_count_.store(0, std::memory_order_release);
+      shard.replacer_->Unpin(frames[i].second);
+    }
+  };
+  auto complete = [this, &io, &results, &release](size_t min_complete) {
+    results.clear();
+    disk_manager_->CompletePages(io.get(), &results, min_complete);
+    for (auto &result : results) {
+      release(result.tag, result.result >= 0);  // Failed or corrupted reads come back negative.
+    }
+  };
+  std::unique_lock<std::mutex> prefetch_lock(prefetch_latch_);
+  while (true) {
+    prefetch_cv_.wait(prefetch_lock, [this] { return prefetch_stop_ || !prefetch_queue_.empty(); });
+    if (prefetch_stop_) {
+      break;
+    }
+    batch.clear();
+    while (!prefetch_queue_.empty() && batch.size() < io->GetQueueDepth() * MAX_COALESCED_PAGES) {
+      batch.push_back(prefetch_queue_.front());
+      prefetch_queue_.pop_front();
+    }
+    prefetch_lock.unlock();
+    std::sort(batch.begin(), batch.end());
+    batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+
+    // Map every page in a locked frame first, so that a FetchPage of it waits for the read instead of reading it again.
+    frames.clear();
+    page_ids.clear();
+    for (page_id_t page_id : batch) {
+      Shard &shard = GetShard(page_id);
+      std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
+      DrainAccesses(shard);
+      frame_id_t frame_id;
+      if (shard.page_table_.Find(page_id) != INVALID_FRAME_ID || !TryToFindFreePage(shard, &frame_id)) {
+        continue;
+      }
+      Page &page = shard.pages_[frame_id];
+      page.page_id_.store(page_id, std::memory_order_relaxed);
+      page.is_dirty_.store(false, std::memory_order_relaxed);
+      shard.page_table_.Insert(page_id, frame_id);
+      frames.emplace_back(&shard, frame_id);
+      page_ids.push_back(page_id);
+    }
+
+    // Read runs of adjacent pages with one request each.
+    iov.resize(frames.size());
+    runs.clear();
+    for (size_t i = 0; i < frames.size(); i++) {
+      iov[i] = {frames[i].first->pages_[frames[i].second].data_, PAGE_SIZE};
+      if (runs.empty() || runs.back().second - runs.back().first == MAX_COALESCED_PAGES ||
+          !DiskManager::IsNextPhysicalPage(page_ids[i - 1], page_ids[i])) {
+        runs.emplace_back(i, i);
+      }
+      runs.back().second++;
+    }
+    for (size_t r = 0; r < runs.size(); r++) {
+      if (io->GetInFlight() == io->GetQueueDepth()) {
+        complete(1);
+      }
+      if (!disk_manager_->SubmitReadPages(io.get(), page_ids[runs[r].first], iov.data() + runs[r].first,
+                                          runs[r].second - runs[r].first, r)) {
+        release(r, false);  // Nothing will complete them.
+      }
+    }
+    complete(io->GetInFlight());
+    prefetch_lock.lock();
+  }
+}
+
+void BufferPoolManager::StartFlusher(double clean_ratio, std::chrono::milliseconds interval) {
+  if (read_only_ || flusher_.joinable()) {
+    return;
+  }
+  flusher_stop_ = false;
+  flusher_ = std::thread(&BufferPoolManager::FlusherLoop, this, clean_ratio, interval);
+}
+
+void BufferPoolManager::StopFlusher() {
+  if (!flusher_.joinable()) {
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> flusher_lock(flusher_latch_);
+    flusher_stop_ = true;
+  }
+  flusher_cv_.notify_one();
+  flusher_.join();
+}
+
+void BufferPoolManager::FlusherLoop(double clean_ratio, std::chrono::milliseconds interval) {
+  auto io = disk_manager_->CreateAsyncIOContext(ASYNC_IO_QUEUE_DEPTH);
+  std::unique_lock<std::mutex> flusher_lock(flusher_latch_);
+  while (!flusher_stop_) {
+    flusher_cv_.wait_for(flusher_lock, interval, [this] { return flusher_stop_ || flusher_wakeup_; });
+    if (flusher_stop_) {
+      break;
+    }
+    flusher_wakeup_ = false;
+    flusher_lock.unlock();
+    FlushDirtyPages(clean_ratio, io.get());
+    flusher_lock.lock();
+  }
+}
+
+void BufferPoolManager::FlushDirtyPages(double clean_ratio, AsyncIOContext *io) {
+  // Pick the dirty unpinned pages of every shard that is short of clean frames. The scan reads the frame metadata
+  // without latches, every candidate is checked again before it is written.
+  vector<pair<page_id_t, Page *>> candidates;
+  for (auto shard : shards_) {
+    size_t target = static_cast<size_t>(clean_ratio * shard->pool_size_);
+    size_t clean = 0;
+    vector<pair<page_id_t, Page *>> dirty;
+    for (size_t i = 0; i < shard->pool_size_; i++) {
+      Page &page = shard->pages_[i];
+      page_id_t page_id = page.GetPageId();
+      if (page_id == INVALID_PAGE_ID || page.GetPinCount() < 0) {
+        clean++;  // Free or being loaded.
+      } else if (page.GetPinCount() == 0) {
+        if (page.IsDirty()) {
+          dirty.emplace_back(page_id, &page);
+        } else {
+          clean++;
+        }
+      }
+    }
+    for (size_t i = 0; clean + i < target && i < dirty.size(); i++) {
+      candidates.push_back(dirty[i]);
+    }
+  }
+
+  // Write in page id order so that the disk sees a mostly sequential stream.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const pair<page_id_t, Page *> &a, const pair<page_id_t, Page *> &b) { return a.first < b.first; });
+  // Lock every candidate that is still dirty and unpinned. Locking the frame keeps writers and evictions out while it
+  // is on its way to disk, hits wait for the write.
+  vector<page_id_t> page_ids;
+  vector<Page *> pages;
+  for (auto &candidate : candidates) {
+    Shard &shard = GetShard(candidate.first);
+    Page &page = *candidate.second;
+    std::scoped_lock<std::recursive_mutex> lock(shard.latch_);
+    int expected = 0;
+    if (page.GetPageId() != candidate.first || !page.IsDirty() ||
+        !page.pin_count_.compare_exchange_strong(expected, FRAME_LOCKED, std::memory_order_acquire)) {
+      continue;  // Evicted, cleaned or pinned in the meantime.
+    }
+    page.is_dirty_.exchange(false, std::memory_order_acq_rel);
+    page_ids.push_back(candidate.first);
+    pages.push_back(&page);
+  }
+
+  // Write runs of adjacent pages with one request each.
+  vector<iovec> iov(pages.size());
+  vector<pair<size_t, size_t>> runs;  // [begin, end) of pages written by one request
+  for (size_t i = 0; i < pages.size(); i++) {
+    iov[i] = {pages[i]->GetData(), PAGE_SIZE};
+    if (runs.empty() || runs.back().second - runs.back().first == MAX_COALESCED_PAGES ||
+        !DiskManager::IsNextPhysicalPage(page_ids[i - 1], page_ids[i])) {
+      runs.emplace_back(i, i);
+    }
+    runs.back().second++;
+  }
+  vector<AsyncIOResult> results;
+  auto complete = [this, io, &pages, &runs, &results](size_t min_complete) {
+    results.clear();
+    disk_manager_->CompletePages(io, &results, min_complete);
+    for (auto &result : results) {
+      bool written = result.result == static_cast<ssize_t>(result.len);
+      for (size_t i = runs[result.tag].first; i < runs[result.tag].second; i++) {
+        if (!written) {
+          pages[i]->is_dirty_.store(true, std::memory_order_release);  // Try again next round.
+        }
+        pages[i]->pin_count_.store(0, std::memory_order_release);
+      }
+      if (written) {
+        background_writes_.fetch_add(runs[result.tag].second - runs[result.tag].first, std::memory_order_relaxed);
+      }
+    }
+  };
+  for (size_t r = 0; r < runs.size(); r++) {
+    if (io->GetInFlight() == io->GetQueueDepth()) {
+      complete(1);
+    }
+    disk_manager_->SubmitWritePages(io, page_ids[runs[r].first], iov.data() + runs[r].first,
+                                    runs[r].second - runs[r].first, r);
+  }
+  complete(io->GetInFlight());
+}
+
+void BufferPoolManager::Commit() {
+  if (read_only_ || disk_manager_->GetSyncPolicy() != SyncPolicy::kPerCommit) {
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(commit_latch_);
+    if (commit_io_ == nullptr) {
+      commit_io_ = disk_manager_->CreateAsyncIOContext(ASYNC_IO_QUEUE_DEPTH);
+    }
+    FlushDirtyPages(1.0, commit_io_.get());
+  }
+  WaitForInFlightWrites();
+  // Outside the latch, so that the committers that wrote their pages meanwhile join the same fdatasync.
+  disk_manager_->Commit();
+}
+
+void BufferPoolManager::WaitForInFlightWrites() {
+  for (auto shard : shards_) {
+    // Evictions and FlushPage() write under the shard latch, the flusher writes frames it locked.
+    vector<pair<frame_id_t, page_id_t>> locked;
+    {
+      std::scoped_lock<std::recursive_mutex> lock(shard->latch_);
+      for (size_t i = 0; i < shard->pool_size_; i++) {
+        Page &page = shard->pages_[i];
+        page_id_t page_id = page.GetPageId();
+        if (page_id != INVALID_PAGE_ID && page.pin_count_.load(std::memory_order_acquire) == FRAME_LOCKED) {
+          locked.emplace_back(i, page_id);  // Free frames stay locked, they hold nothing to wait for.
+        }
+      }
+    }
+    // A frame is locked until its write completes, an evicted one also changes its page id then.
+    for (auto &frame : locked) {
+      Page &page = shard->pages_[frame.first];
+      while (page.pin_count_.load(std::memory_order_acquire) == FRAME_LOCKED && page.GetPageId() == frame.second) {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+Page *BufferPoolManager::FetchMappedPage(page_id_t page_id) {
+  if (static_cast<size_t>(page_id) >= num_mapped_pages_) {
+    return nullptr;
+  }
+  Page *page = mapped_pages_[page_id].load(std::memory_order_acquire);
+  if (page == nullptr) {
+    char *data = disk_manager_->GetMappedPage(page_id);
+    if (data == nullptr) {
+      return nullptr;  // The extent is not fully written, or the page is corrupted.
+    }
+    auto *created = new Page(data);
+    created->page_id_.store(page_id, std::memory_order_relaxed);
+    // Another thread may have won the race, then use its page.
+    if (mapped_pages_[page_id].compare_exchange_strong(page, created, std::memory_order_acq_rel)) {
+      page = created;
+    } else {
+      delete created;
+    }
+  }
+  // Pins are only counted so that CheckAllUnpinned still finds leaks, nothing is ever evicted.
+  page->pin_count_.fetch_add(1, std::memory_order_acquire);
+  return page;
+}
+
+bool BufferPoolManager::TryPin(Page &page) {
+  int pin_count = page.pin_count_.load(std::memory_order_relaxed);
+  while (pin_count >= 0) {
+    if (page.pin_count_.compare_exchange_weak(pin_count, pin_count + 1, std::memory_order_acquire)) {
+      return true;
+    }
+  }
+  return false;
+}
 
 page_id_t BufferPoolManager::AllocatePage() {
   int next_page_id = disk_manager_->AllocatePage();
@@ -196,11 +777,18 @@ bool BufferPoolManager::IsPageFree(page_id_t page_id) {
 // Only used for debug
 bool BufferPoolManager::CheckAllUnpinned() {
   bool res = true;
-  for (size_t i = 0; i < pool_size_; i++) {
-    if (pages_[i].pin_count_ != 0) {
+  for (size_t i = 0; i < num_mapped_pages_; i++) {
+    Page *page = mapped_pages_[i].load(std::memory_order_acquire);
+    if (page != nullptr && page->pin_count_ > 0) {
+      res = false;
+      LOG(ERROR) << "page " << i << " pin count:" << page->pin_count_ << endl;
+    }
+  }
+  for (size_t i = 0; pages_ != nullptr && i < pool_size_; i++) {
+    if (pages_[i].pin_count_ > 0) {
       res = false;
       LOG(ERROR) << "page " << pages_[i].page_id_ << " pin count:" << pages_[i].pin_count_ << endl;
     }
   }
   return res;
-}
\ No newline at end of file
+}
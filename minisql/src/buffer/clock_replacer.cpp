@@ -0,0 +1,51 @@
+#include "buffer/clock_replacer.h"
+
+CLOCKReplacer::CLOCKReplacer(size_t num_pages)
+    : capacity(num_pages), in_clock(num_pages, false), reference_bits(num_pages, false) {}
+
+CLOCKReplacer::~CLOCKReplacer() = default;
+
+bool CLOCKReplacer::Victim(frame_id_t *frame_id) {
+  // Two sweeps are enough to clear every reference bit.
+  for (size_t steps = 2 * capacity; size > 0 && steps > 0; steps--) {
+    size_t candidate = hand;
+    hand = (hand + 1) % capacity;
+    if (!in_clock[candidate]) {
+      continue;
+    }
+    if (reference_bits[candidate]) {
+      reference_bits[candidate] = false;  // Second chance.
+      continue;
+    }
+    if (IsEvictable(static_cast<frame_id_t>(candidate))) {
+      in_clock[candidate] = false;
+      size--;
+      *frame_id = static_cast<frame_id_t>(candidate);
+      return true;
+    }
+  }
+  return false;
+}
+
+void CLOCKReplacer::Pin(frame_id_t frame_id) {
+  if (in_clock[frame_id]) {
+    in_clock[frame_id] = false;
+    size--;
+  }
+}
+
+void CLOCKReplacer::Unpin(frame_id_t frame_id) {
+  if (!in_clock[frame_id]) {
+    in_clock[frame_id] = true;
+    reference_bits[frame_id] = true;
+    size++;
+  }
+}
+
+void CLOCKReplacer::RecordAccess(frame_id_t frame_id) {
+  if (in_clock[frame_id]) {
+    reference_bits[frame_id] = true;
+  }
+}
+
+size_t CLOCKReplacer::Size() { return size; }
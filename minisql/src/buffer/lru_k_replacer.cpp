@@ -0,0 +1,64 @@
+#include "buffer/lru_k_replacer.h"
+
+#include "common/macros.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k, size_t correlation_period)
+    : k_(k),
+      correlation_period_(correlation_period != 0 ? correlation_period : max<size_t>(1, num_pages / 16)),
+      tracked_(num_pages, false),
+      history_(num_pages),
+      last_admission_(num_pages, 0) {
+  ASSERT(k_ > 0, "LRU-K needs at least one reference per frame.");
+}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+  for (auto *candidates : {&cold_, &hot_}) {
+    for (auto iter = candidates->begin(); iter != candidates->end(); ++iter) {
+      if (IsEvictable(iter->second)) {
+        *frame_id = iter->second;
+        candidates->erase(iter);
+        tracked_[*frame_id] = false;
+        history_[*frame_id].clear();
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  if (!tracked_[frame_id]) {
+    return;
+  }
+  SetOf(frame_id).erase(KeyOf(frame_id));
+  tracked_[frame_id] = false;
+  history_[frame_id].clear();
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  if (tracked_[frame_id]) {
+    return;
+  }
+  tracked_[frame_id] = true;
+  history_[frame_id].push_back(current_timestamp_++);
+  last_admission_[frame_id] = ++admissions_;
+  SetOf(frame_id).insert(KeyOf(frame_id));
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id) {
+  if (!tracked_[frame_id] || admissions_ - last_admission_[frame_id] < correlation_period_) {
+    return;
+  }
+  SetOf(frame_id).erase(KeyOf(frame_id));
+  auto &history = history_[frame_id];
+  history.push_back(current_timestamp_++);
+  if (history.size() > k_) {
+    history.pop_front();
+  }
+  last_admission_[frame_id] = admissions_;
+  SetOf(frame_id).insert(KeyOf(frame_id));
+}
+
+size_t LRUKReplacer::Size() { return cold_.size() + hot_.size(); }
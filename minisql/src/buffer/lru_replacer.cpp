@@ -1,6 +1,9 @@
 #include "buffer/lru_replacer.h"
 
-LRUReplacer::LRUReplacer(size_t num_pages){}
+LRUReplacer::LRUReplacer(size_t num_pages)
+    : head_(static_cast<frame_id_t>(num_pages)), prev_(num_pages + 1), next_(num_pages + 1), in_list_(num_pages, false) {
+    prev_[head_] = next_[head_] = head_; // Empty circular list.
+}
 
 LRUReplacer::~LRUReplacer() = default;
 
@@ -8,22 +11,26 @@ LRUReplacer::~LRUReplacer() = default;
  * Finished
  */
 bool LRUReplacer::Victim(frame_id_t *frame_id) {
-    if (lru_list_.empty())
-        return false;
-    
-    *frame_id = lru_list_.front();
-    lru_list_.pop_front();
-    lru_set_.erase(*frame_id);
-    return true;
+    for (frame_id_t cur = next_[head_]; cur != head_; cur = next_[cur]) {
+        if (IsEvictable(cur)) { // Skip the frames the filter rejects, they keep their position.
+            Unlink(cur);
+            in_list_[cur] = false;
+            size_--;
+            *frame_id = cur;
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
  * Finished
  */
 void LRUReplacer::Pin(frame_id_t frame_id) {
-    if (lru_set_.find(frame_id) != lru_set_.end()) {
-        lru_list_.remove(frame_id);
-        lru_set_.erase(frame_id);
+    if (in_list_[frame_id]) {
+        Unlink(frame_id);
+        in_list_[frame_id] = false;
+        size_--;
     }
 }
 
@@ -31,9 +38,20 @@ void LRUReplacer::Pin(frame_id_t frame_id) {
  * Finished
  */
 void LRUReplacer::Unpin(frame_id_t frame_id) {
-    if (lru_set_.find(frame_id) == lru_set_.end()) {
-        lru_list_.push_back(frame_id);
-        lru_set_.insert(frame_id);
+    if (!in_list_[frame_id]) {
+        Link(frame_id);
+        in_list_[frame_id] = true;
+        size_++;
+    }
+}
+
+/**
+ * Move an accessed frame to the most recently used end.
+ */
+void LRUReplacer::RecordAccess(frame_id_t frame_id) {
+    if (in_list_[frame_id]) {
+        Unlink(frame_id);
+        Link(frame_id);
     }
 }
 
@@ -41,5 +59,5 @@ void LRUReplacer::Unpin(frame_id_t frame_id) {
  * Finished
  */
 size_t LRUReplacer::Size() {
-    return lru_set_.size();
-}
\ No newline at end of file
+    return size_;
+}
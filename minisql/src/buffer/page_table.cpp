@@ -0,0 +1,103 @@
+#include "buffer/page_table.h"
+
+#include <vector>
+
+PageTable::PageTable(size_t num_frames) {
+  // Keep the load factor at or below one half so that probe sequences stay short.
+  uint32_t bits = 2;
+  while ((static_cast<size_t>(1) << bits) < num_frames * 2) {
+    bits++;
+  }
+  capacity_ = static_cast<size_t>(1) << bits;
+  mask_ = capacity_ - 1;
+  shift_ = 32 - bits;
+  slots_ = new std::atomic<uint64_t>[capacity_];
+  for (size_t i = 0; i < capacity_; i++) {
+    slots_[i].store(Pack(EMPTY_KEY, INVALID_FRAME_ID), std::memory_order_relaxed);
+  }
+}
+
+PageTable::~PageTable() { delete[] slots_; }
+
+frame_id_t PageTable::Find(page_id_t page_id) const {
+  size_t pos = HomeSlot(page_id);
+  for (size_t probe = 0; probe < capacity_; probe++) {
+    uint64_t slot = slots_[pos].load(std::memory_order_acquire);
+    page_id_t key = KeyOf(slot);
+    if (key == page_id) {
+      return ValueOf(slot);
+    }
+    if (key == EMPTY_KEY) {
+      break;
+    }
+    pos = (pos + 1) & mask_;
+  }
+  return INVALID_FRAME_ID;
+}
+
+void PageTable::Insert(page_id_t page_id, frame_id_t frame_id) {
+  if ((size_ + tombstones_ + 1) * 4 > capacity_ * 3) {
+    Rebuild();
+  }
+  size_t pos = HomeSlot(page_id);
+  size_t reuse = capacity_;
+  for (size_t probe = 0; probe < capacity_; probe++) {
+    page_id_t key = KeyOf(slots_[pos].load(std::memory_order_relaxed));
+    if (key == page_id) {
+      slots_[pos].store(Pack(page_id, frame_id), std::memory_order_release);
+      return;
+    }
+    if (key == TOMBSTONE_KEY && reuse == capacity_) {
+      reuse = pos;
+    }
+    if (key == EMPTY_KEY) {
+      break;
+    }
+    pos = (pos + 1) & mask_;
+  }
+  if (reuse != capacity_) {
+    pos = reuse;
+    tombstones_--;
+  }
+  slots_[pos].store(Pack(page_id, frame_id), std::memory_order_release);
+  size_++;
+}
+
+bool PageTable::Erase(page_id_t page_id) {
+  size_t pos = HomeSlot(page_id);
+  for (size_t probe = 0; probe < capacity_; probe++) {
+    page_id_t key = KeyOf(slots_[pos].load(std::memory_order_relaxed));
+    if (key == page_id) {
+      slots_[pos].store(Pack(TOMBSTONE_KEY, INVALID_FRAME_ID), std::memory_order_release);
+      size_--;
+      tombstones_++;
+      return true;
+    }
+    if (key == EMPTY_KEY) {
+      break;
+    }
+    pos = (pos + 1) & mask_;
+  }
+  return false;
+}
+
+void PageTable::Rebuild() {
+  std::vector<uint64_t> live;
+  live.reserve(size_);
+  for (size_t i = 0; i < capacity_; i++) {
+    uint64_t slot = slots_[i].load(std::memory_order_relaxed);
+    if (KeyOf(slot) != EMPTY_KEY && KeyOf(slot) != TOMBSTONE_KEY) {
+      live.push_back(slot);
+    }
+    slots_[i].store(Pack(EMPTY_KEY, INVALID_FRAME_ID), std::memory_order_release);
+  }
+  // Lock-free readers running concurrently may miss an entry until it is re-inserted, they fall back to the latch.
+  for (auto slot : live) {
+    size_t pos = HomeSlot(KeyOf(slot));
+    while (KeyOf(slots_[pos].load(std::memory_order_relaxed)) != EMPTY_KEY) {
+      pos = (pos + 1) & mask_;
+    }
+    slots_[pos].store(slot, std::memory_order_release);
+  }
+  tombstones_ = 0;
+}
@@ -0,0 +1,69 @@
+#include "buffer/two_queue_replacer.h"
+
+#include <algorithm>
+
+TwoQueueReplacer::TwoQueueReplacer(size_t num_pages, double a1_ratio, size_t correlation_period)
+    : a1_max_(max<size_t>(1, static_cast<size_t>(num_pages * a1_ratio))),
+      correlation_period_(correlation_period != 0 ? correlation_period : max<size_t>(1, a1_max_ / 4)),
+      queue_(num_pages, Queue::kNone),
+      position_(num_pages),
+      admitted_at_(num_pages, 0) {}
+
+TwoQueueReplacer::~TwoQueueReplacer() = default;
+
+bool TwoQueueReplacer::Victim(frame_id_t *frame_id) {
+  // Drain the probation queue first while it is over its share, otherwise protect it and evict from the main queue.
+  if (a1_.size() > a1_max_ || am_.empty()) {
+    return VictimFrom(a1_, frame_id) || VictimFrom(am_, frame_id);
+  }
+  return VictimFrom(am_, frame_id) || VictimFrom(a1_, frame_id);
+}
+
+void TwoQueueReplacer::Pin(frame_id_t frame_id) {
+  if (queue_[frame_id] == Queue::kNone) {
+    return;
+  }
+  (queue_[frame_id] == Queue::kA1 ? a1_ : am_).erase(position_[frame_id]);
+  queue_[frame_id] = Queue::kNone;
+}
+
+void TwoQueueReplacer::Unpin(frame_id_t frame_id) {
+  if (queue_[frame_id] != Queue::kNone) {
+    return;
+  }
+  position_[frame_id] = a1_.insert(a1_.end(), frame_id);
+  queue_[frame_id] = Queue::kA1;
+  admitted_at_[frame_id] = ++admissions_;
+}
+
+void TwoQueueReplacer::RecordAccess(frame_id_t frame_id) {
+  switch (queue_[frame_id]) {
+    case Queue::kNone:
+      return;
+    case Queue::kA1:
+      if (admissions_ - admitted_at_[frame_id] < correlation_period_) {
+        return;
+      }
+      a1_.erase(position_[frame_id]);
+      queue_[frame_id] = Queue::kAm;
+      break;
+    case Queue::kAm:
+      am_.erase(position_[frame_id]);
+      break;
+  }
+  position_[frame_id] = am_.insert(am_.end(), frame_id);
+}
+
+size_t TwoQueueReplacer::Size() { return a1_.size() + am_.size(); }
+
+bool TwoQueueReplacer::VictimFrom(list<frame_id_t> &queue, frame_id_t *frame_id) {
+  for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+    if (IsEvictable(*iter)) {
+      *frame_id = *iter;
+      queue_[*frame_id] = Queue::kNone;
+      queue.erase(iter);
+      return true;
+    }
+  }
+  return false;
+}
@@ -1,7 +1,9 @@
 #include "catalog/catalog.h"
 
+#include "page/index_roots_page.h"
+
 void CatalogMeta::SerializeTo(char *buf) const {
-  ASSERT(GetSerializedSize() <= PAGE_SIZE, "Failed to serialize catalog metadata to disk.");
+  ASSERT(GetSerializedSize() <= PAGE_SIZE - PAGE_CHECKSUM_SIZE, "Failed to serialize catalog metadata to disk.");
   MACH_WRITE_UINT32(buf, CATALOG_METADATA_MAGIC_NUM);
   buf += 4;
   MACH_WRITE_UINT32(buf, table_meta_pages_.size());
@@ -116,7 +118,9 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
 }
 
 CatalogManager::~CatalogManager() {
-  FlushCatalogMetaPage();
+  if (!buffer_pool_manager_->IsReadOnly()) {
+    FlushCatalogMetaPage();
+  }
   delete catalog_meta_;
   for (auto iter : tables_) {
     delete iter.second;
@@ -163,7 +167,8 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
         }
 
         // Create TableMetadata
-        table_meta = TableMetadata::Create(new_table_id, table_name, heap_root_page_id, schema_copy);
+        table_meta = TableMetadata::Create(new_table_id, table_name, heap_root_page_id, schema_copy,
+                                           table_heap->GetFreeSpaceMapPageId());
 
         // Serialize TableMetadatat to its page
         table_meta->SerializeTo(table_meta_page->GetData());
@@ -538,7 +543,8 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
         } 
 
         page_id_t heap_root_page_id = table_meta->GetFirstPageId();
-        table_heap = TableHeap::Create(buffer_pool_manager_, heap_root_page_id, table_meta->GetSchema(), log_manager_, lock_manager_);
+        table_heap = TableHeap::Create(buffer_pool_manager_, heap_root_page_id, table_meta->GetSchema(), log_manager_, lock_manager_,
+                                       table_meta->GetFreeSpaceMapPageId());
 
         table_info = TableInfo::Create();
         table_info->Init(table_meta, table_heap);
@@ -572,6 +578,7 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
     try {
         IndexMetadata::DeserializeFrom(index_meta_page->GetData(), index_meta);
         buffer_pool_manager_->UnpinPage(page_id, false);
+        index_meta_page = nullptr;
         if (index_meta == nullptr) { return DB_FAILED; }
         if (index_meta->GetIndexId() != index_id) {
             LOG(ERROR) << "Index ID mismatch on load.";
@@ -583,8 +590,27 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
             return DB_TABLE_NOT_EXIST;
         }
 
+        bool stale = index_meta->GetKeyFormat() != IndexMetadata::KEY_FORMAT_VERSION;
+        if (stale && buffer_pool_manager_->IsReadOnly()) {
+            // rebuilding writes the index pages, leave the index out until the database is opened for writing
+            LOG(ERROR) << "CatalogManager: Index '" << index_meta->GetIndexName() << "' was built with key format "
+                       << index_meta->GetKeyFormat() << " and cannot be rebuilt read-only, open the database for "
+                       << "writing once to rebuild it.";
+            return DB_FAILED;
+        }
+        if (stale) {
+            // forget the old root before the tree is opened, it starts out empty
+            Page *roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+            if (roots_page == nullptr) { return DB_FAILED; }
+            reinterpret_cast<IndexRootsPage *>(roots_page->GetData())->Delete(index_id);
+            buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+        }
         index_info = IndexInfo::Create();
         index_info->Init(index_meta, table_info, buffer_pool_manager_);
+        if (stale && RebuildIndex(index_info, index_meta, table_info, page_id) != DB_SUCCESS) {
+            delete index_info;
+            return DB_FAILED;
+        }
         
         indexes_[index_id] = index_info;
         index_names_[table_info->GetTableName()][index_info->GetIndexName()] = index_id;
@@ -595,7 +621,36 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
         LOG(ERROR) << "Exception during index loading: " << e.what();
         if (index_meta_page != nullptr) {
             buffer_pool_manager_->UnpinPage(page_id, false);
-            return DB_FAILED;
         }
+        return DB_FAILED;
     }
-}
\ No newline at end of file
+}
+
+dberr_t CatalogManager::RebuildIndex(IndexInfo *index_info, IndexMetadata *index_meta, TableInfo *table_info,
+                                     const page_id_t page_id) {
+    LOG(WARNING) << "CatalogManager: Index '" << index_info->GetIndexName() << "' was built with key format "
+                 << index_meta->GetKeyFormat() << ", rebuilding it.";
+    TableHeap *table_heap = table_info->GetTableHeap();
+    auto row = table_heap->Begin(nullptr);
+    dberr_t ret = index_info->GetIndex()->BulkLoad([&](Row *key, RowId *rid) {
+        if (row == table_heap->End()) { return false; }
+        vector<Field> key_fields;
+        for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+            key_fields.push_back(*row->GetField(column->GetTableInd()));
+        }
+        *key = Row(key_fields);
+        *rid = row->GetRowId();
+        ++row;
+        return true;
+    });
+    if (ret != DB_SUCCESS) {
+        LOG(ERROR) << "CatalogManager: Failed to rebuild index '" << index_info->GetIndexName() << "'.";
+        return ret;
+    }
+    Page *index_meta_page = buffer_pool_manager_->FetchPage(page_id);
+    if (index_meta_page == nullptr) { return DB_FAILED; }
+    index_meta->SetKeyFormat(IndexMetadata::KEY_FORMAT_VERSION);
+    index_meta->SerializeTo(index_meta_page->GetData());
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    return DB_SUCCESS;
+}
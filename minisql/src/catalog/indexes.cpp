@@ -12,7 +12,7 @@ IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &in
 uint32_t IndexMetadata::SerializeTo(char *buf) const {
   char *p = buf;
   uint32_t ofs = GetSerializedSize();
-  ASSERT(ofs <= PAGE_SIZE, "Failed to serialize index info.");
+  ASSERT(ofs <= PAGE_SIZE - PAGE_CHECKSUM_SIZE, "Failed to serialize index info.");
   // magic num
   MACH_WRITE_UINT32(buf, INDEX_METADATA_MAGIC_NUM);
   buf += 4;
@@ -35,6 +35,9 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     MACH_WRITE_UINT32(buf, col_index);
     buf += 4;
   }
+  // key format
+  MACH_WRITE_UINT32(buf, key_format_);
+  buf += 4;
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
@@ -49,7 +52,8 @@ uint32_t IndexMetadata::GetSerializedSize() const {
            MACH_STR_SERIALIZED_SIZE(index_name_) + // index_name_
            sizeof(table_id_t) + // table_id_
            sizeof(uint32_t) + // key count
-           key_map_.size() * sizeof(uint32_t); // key_map_ data
+           key_map_.size() * sizeof(uint32_t) + // key_map_ data
+           sizeof(uint32_t); // key_format_
 }
 
 uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
@@ -60,7 +64,8 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
   // magic num
   uint32_t magic_num = MACH_READ_UINT32(buf);
   buf += 4;
-  ASSERT(magic_num == INDEX_METADATA_MAGIC_NUM, "Failed to deserialize index info.");
+  ASSERT(magic_num == INDEX_METADATA_MAGIC_NUM || magic_num == INDEX_METADATA_MAGIC_NUM_NO_KEY_FORMAT,
+         "Failed to deserialize index info.");
   // index id
   index_id_t index_id = MACH_READ_FROM(index_id_t, buf);
   buf += 4;
@@ -82,23 +87,21 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
     buf += 4;
     key_map.push_back(key_index);
   }
+  // key format
+  uint32_t key_format = 0;
+  if (magic_num == INDEX_METADATA_MAGIC_NUM) {
+    key_format = MACH_READ_UINT32(buf);
+    buf += 4;
+  }
   // allocate space for index meta data
   index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  index_meta->key_format_ = key_format;
   return buf - p;
 }
 
 Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
-  size_t max_size = 0;
-  uint32_t column_cnt = key_schema_->GetColumns().size();
-  size_t size_bitmap = (column_cnt % 8) ? column_cnt / 8 + 1 : column_cnt / 8;
-  // column_cnt + bitmap
-  max_size += 4 + sizeof(unsigned char) * size_bitmap;
-  for (auto col : key_schema_->GetColumns()) {
-    // length of char column
-    if(col->GetType() == TypeId::kTypeChar)
-      max_size += 4;
-    max_size += col->GetLength();
-  }
+  // bytes of a key as KeyManager encodes it
+  size_t max_size = KeyManager::GetEncodedSize(key_schema_);
 
   if (index_type == "bptree") {
     if (max_size <= 8)
@@ -3,7 +3,7 @@
 uint32_t TableMetadata::SerializeTo(char *buf) const {
   char *p = buf;
   uint32_t ofs = GetSerializedSize();
-  ASSERT(ofs <= PAGE_SIZE, "Failed to serialize table info.");
+  ASSERT(ofs <= PAGE_SIZE - PAGE_CHECKSUM_SIZE, "Failed to serialize table info.");
   // magic num
   MACH_WRITE_UINT32(buf, TABLE_METADATA_MAGIC_NUM);
   buf += 4;
@@ -18,6 +18,9 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // table heap root page id
   MACH_WRITE_TO(page_id_t, buf, root_page_id_);
   buf += 4;
+  // free space map page id
+  MACH_WRITE_TO(page_id_t, buf, free_space_map_page_id_);
+  buf += 4;
   // table schema
   buf += schema_->SerializeTo(buf);
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
@@ -36,6 +39,7 @@ uint32_t TableMetadata::GetSerializedSize() const {
            sizeof(table_id_t) + // table_id_
            MACH_STR_SERIALIZED_SIZE(table_name_) + // table_name_
            sizeof(page_id_t) + // root_page_id_
+           sizeof(page_id_t) + // free_space_map_page_id_
            schema_->GetSerializedSize(); // table schema
 }
 
@@ -51,7 +55,8 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // magic num
   uint32_t magic_num = MACH_READ_UINT32(buf);
   buf += 4;
-  ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM, "Failed to deserialize table info.");
+  ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM || magic_num == TABLE_METADATA_MAGIC_NUM_NO_FSM,
+         "Failed to deserialize table info.");
   // table id
   table_id_t table_id = MACH_READ_FROM(table_id_t, buf);
   buf += 4;
@@ -63,11 +68,17 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // table heap root page id
   page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
   buf += 4;
+  // free space map page id, the map is rebuilt if the table has none
+  page_id_t free_space_map_page_id = INVALID_PAGE_ID;
+  if (magic_num == TABLE_METADATA_MAGIC_NUM) {
+    free_space_map_page_id = MACH_READ_FROM(page_id_t, buf);
+    buf += 4;
+  }
   // table schema
   TableSchema *schema = nullptr;
   buf += TableSchema::DeserializeFrom(buf, schema);
   // allocate space for table metadata
-  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema, free_space_map_page_id);
   return buf - p;
 }
 
@@ -77,10 +88,15 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
  * @param heap Memory heap passed by TableInfo
  */
 TableMetadata *TableMetadata::Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
-                                     TableSchema *schema) {
+                                     TableSchema *schema, page_id_t free_space_map_page_id) {
   // allocate space for table metadata
-  return new TableMetadata(table_id, table_name, root_page_id, schema);
+  return new TableMetadata(table_id, table_name, root_page_id, schema, free_space_map_page_id);
 }
 
-TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema)
-    : table_id_(table_id), table_name_(table_name), root_page_id_(root_page_id), schema_(schema) {}
+TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                             page_id_t free_space_map_page_id)
+    : table_id_(table_id),
+      table_name_(table_name),
+      root_page_id_(root_page_id),
+      free_space_map_page_id_(free_space_map_page_id),
+      schema_(schema) {}
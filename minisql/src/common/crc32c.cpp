@@ -0,0 +1,180 @@
+#include "common/crc32c.h"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace {
+
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;  // reflected Castagnoli polynomial
+
+/** table_[k][b]: CRC of byte b followed by k zero bytes, for slicing-by-8 */
+struct Crc32cTable {
+  uint32_t table_[8][256];
+
+  Crc32cTable() {
+    for (uint32_t b = 0; b < 256; b++) {
+      uint32_t crc = b;
+      for (int i = 0; i < 8; i++) {
+        crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+      }
+      table_[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; b++) {
+      for (int k = 1; k < 8; k++) {
+        table_[k][b] = (table_[k - 1][b] >> 8) ^ table_[0][table_[k - 1][b] & 0xFF];
+      }
+    }
+  }
+};
+
+const Crc32cTable kTable;
+
+/**
+ * The CRC instructions have a latency of several cycles but a throughput of one per cycle, so the hardware path runs
+ * three independent streams over consecutive blocks of BLOCK_SIZE bytes and merges them. Merging needs the CRC register
+ * advanced over BLOCK_SIZE zero bytes, a linear map that is tabulated per byte of the register.
+ */
+constexpr size_t BLOCK_SIZE = 1360;
+
+struct Crc32cShiftTable {
+  uint32_t table_[4][256];
+
+  Crc32cShiftTable() {
+    uint32_t basis[32];
+    for (int bit = 0; bit < 32; bit++) {
+      uint32_t crc = 1u << bit;
+      for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        crc = (crc >> 8) ^ kTable.table_[0][crc & 0xFF];
+      }
+      basis[bit] = crc;
+    }
+    for (int k = 0; k < 4; k++) {
+      for (uint32_t b = 0; b < 256; b++) {
+        uint32_t crc = 0;
+        for (int bit = 0; bit < 8; bit++) {
+          if (b & (1u << bit)) {
+            crc ^= basis[8 * k + bit];
+          }
+        }
+        table_[k][b] = crc;
+      }
+    }
+  }
+
+  /** @return the register crc advanced over BLOCK_SIZE zero bytes */
+  inline uint32_t Shift(uint32_t crc) const {
+    return table_[0][crc & 0xFF] ^ table_[1][(crc >> 8) & 0xFF] ^ table_[2][(crc >> 16) & 0xFF] ^ table_[3][crc >> 24];
+  }
+};
+
+const Crc32cShiftTable kShift;
+
+inline uint64_t LoadLittleEndian64(const unsigned char *p) {
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t Crc32cHardware(const unsigned char *p, size_t len, uint32_t crc) {
+  for (; len >= 3 * BLOCK_SIZE; p += 3 * BLOCK_SIZE, len -= 3 * BLOCK_SIZE) {
+    uint64_t a = crc, b = 0, c = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 8) {
+      uint64_t wa, wb, wc;
+      memcpy(&wa, p + i, sizeof(wa));
+      memcpy(&wb, p + BLOCK_SIZE + i, sizeof(wb));
+      memcpy(&wc, p + 2 * BLOCK_SIZE + i, sizeof(wc));
+      a = _mm_crc32_u64(a, wa);
+      b = _mm_crc32_u64(b, wb);
+      c = _mm_crc32_u64(c, wc);
+    }
+    crc = kShift.Shift(kShift.Shift(static_cast<uint32_t>(a)) ^ static_cast<uint32_t>(b)) ^ static_cast<uint32_t>(c);
+  }
+  uint64_t crc64 = crc;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+  for (; len > 0; p++, len--) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  return crc;
+}
+
+bool DetectHardware() {
+  unsigned int eax, ebx, ecx, edx;
+  return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+}
+#elif defined(__aarch64__) && defined(__linux__)
+__attribute__((target("+crc"))) uint32_t Crc32cHardware(const unsigned char *p, size_t len, uint32_t crc) {
+  for (; len >= 3 * BLOCK_SIZE; p += 3 * BLOCK_SIZE, len -= 3 * BLOCK_SIZE) {
+    uint32_t a = crc, b = 0, c = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 8) {
+      uint64_t wa, wb, wc;
+      memcpy(&wa, p + i, sizeof(wa));
+      memcpy(&wb, p + BLOCK_SIZE + i, sizeof(wb));
+      memcpy(&wc, p + 2 * BLOCK_SIZE + i, sizeof(wc));
+      a = __crc32cd(a, wa);
+      b = __crc32cd(b, wb);
+      c = __crc32cd(c, wc);
+    }
+    crc = kShift.Shift(kShift.Shift(a) ^ b) ^ c;
+  }
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+  for (; len > 0; p++, len--) {
+    crc = __crc32cb(crc, *p);
+  }
+  return crc;
+}
+
+bool DetectHardware() { return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0; }
+#else
+uint32_t Crc32cHardware(const unsigned char *, size_t, uint32_t) { return 0; }
+
+bool DetectHardware() { return false; }
+#endif
+
+const bool kHardware = DetectHardware();
+
+}  // namespace
+
+uint32_t Crc32cSoftware(const void *data, size_t len, uint32_t crc) {
+  auto p = static_cast<const unsigned char *>(data);
+  const auto &t = kTable.table_;
+  crc = ~crc;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word = LoadLittleEndian64(p) ^ crc;
+    crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^ t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+          t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^ t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+  }
+  for (; len > 0; p++, len--) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+  }
+  return ~crc;
+}
+
+uint32_t Crc32c(const void *data, size_t len, uint32_t crc) {
+  if (!kHardware) {
+    return Crc32cSoftware(data, len, crc);
+  }
+  return ~Crc32cHardware(static_cast<const unsigned char *>(data), len, ~crc);
+}
+
+bool Crc32cIsHardware() { return kHardware; }
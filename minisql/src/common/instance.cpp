@@ -3,16 +3,25 @@
 //
 #include "common/instance.h"
 
-DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size)
-    : db_file_name_(std::move(db_name)), init_(init) {
+DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size, bool read_only,
+                                 bool checksums, bool compressed)
+    : db_file_name_(std::move(db_name)), init_(init), read_only_(read_only) {
+  if (init_ && read_only_) {
+    throw logic_error("Cannot create a read-only database.");
+  }
   // Init database file if needed
   db_file_name_ = "./databases/" + db_file_name_;
   if (init_) {
     remove(db_file_name_.c_str());
+    remove(DiskManager::PageMapFile(db_file_name_).c_str());
   }
   // Initialize components
-  disk_mgr_ = new DiskManager(db_file_name_);
+  disk_mgr_ = new DiskManager(db_file_name_, read_only_, compressed);
+  disk_mgr_->EnableChecksums(checksums);
   bpm_ = new BufferPoolManager(buffer_pool_size, disk_mgr_);
+  if (!read_only_) {
+    bpm_->StartFlusher();
+  }
 
   // Allocate static page for db storage engine
   if (init) {
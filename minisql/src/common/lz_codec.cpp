@@ -0,0 +1,180 @@
+#include "common/lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;   // the block ends with at least this many literals
+constexpr size_t MATCH_FIND_LIMIT = 12;  // no match starts in the last bytes of the block
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 12;
+
+inline uint32_t Load32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Load64(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t Hash(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - HASH_BITS); }
+
+/** Append the extension bytes of a length whose nibble saturated. @return false if dst is full */
+inline bool PutLength(size_t length, uint8_t *&op, const uint8_t *oend) {
+  for (; length >= 255; length -= 255) {
+    if (op >= oend) {
+      return false;
+    }
+    *op++ = 255;
+  }
+  if (op >= oend) {
+    return false;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return true;
+}
+
+/** Append a sequence, match_length 0 for the final literals. @return false if dst is full */
+bool PutSequence(const uint8_t *literals, size_t literal_length, size_t offset, size_t match_length, uint8_t *&op,
+                 const uint8_t *oend) {
+  if (op >= oend) {
+    return false;
+  }
+  uint8_t *token = op++;
+  *token = static_cast<uint8_t>((literal_length < 15 ? literal_length : 15) << 4);
+  if (literal_length >= 15 && !PutLength(literal_length - 15, op, oend)) {
+    return false;
+  }
+  if (static_cast<size_t>(oend - op) < literal_length) {
+    return false;
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if (match_length == 0) {
+    return true;
+  }
+  if (oend - op < 2) {
+    return false;
+  }
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  size_t code = match_length - MIN_MATCH;
+  *token |= static_cast<uint8_t>(code < 15 ? code : 15);
+  return code < 15 || PutLength(code - 15, op, oend);
+}
+
+/** Read the extension bytes of a saturated length. @return false if src ends first */
+inline bool GetLength(size_t *length, const uint8_t *&ip, const uint8_t *iend) {
+  uint8_t byte;
+  do {
+    if (ip >= iend) {
+      return false;
+    }
+    byte = *ip++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+}  // namespace
+
+size_t LzCompress(const char *src, size_t len, char *dst, size_t capacity) {
+  auto *base = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *ip = base;
+  const uint8_t *anchor = base;
+  const uint8_t *iend = base + len;
+  auto *op = reinterpret_cast<uint8_t *>(dst);
+  const uint8_t *oend = op + capacity;
+  if (len > MATCH_FIND_LIMIT) {
+    const uint8_t *match_limit = iend - LAST_LITERALS;
+    const uint8_t *find_limit = iend - MATCH_FIND_LIMIT;
+    uint32_t table[1 << HASH_BITS] = {};
+    size_t misses = 0;
+    while (ip < find_limit) {
+      uint32_t sequence = Load32(ip);
+      uint32_t h = Hash(sequence);
+      const uint8_t *ref = base + table[h];
+      table[h] = static_cast<uint32_t>(ip - base);
+      if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_OFFSET || Load32(ref) != sequence) {
+        ip += 1 + (misses++ >> 5);  // skip faster through data that does not compress
+        continue;
+      }
+      misses = 0;
+      const uint8_t *mp = ip + MIN_MATCH;
+      const uint8_t *rp = ref + MIN_MATCH;
+      while (mp + 8 <= match_limit && Load64(mp) == Load64(rp)) {
+        mp += 8;
+        rp += 8;
+      }
+      while (mp < match_limit && *mp == *rp) {
+        mp++;
+        rp++;
+      }
+      if (!PutSequence(anchor, ip - anchor, ip - ref, mp - ip, op, oend)) {
+        return 0;
+      }
+      ip = mp;
+      anchor = ip;
+      if (ip < find_limit) {
+        table[Hash(Load32(ip - 2))] = static_cast<uint32_t>(ip - 2 - base);
+      }
+    }
+  }
+  if (!PutSequence(anchor, iend - anchor, 0, 0, op, oend)) {
+    return 0;
+  }
+  return op - reinterpret_cast<uint8_t *>(dst);
+}
+
+bool LzDecompress(const char *src, size_t len, char *dst, size_t out_len) {
+  auto *ip = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *iend = ip + len;
+  auto *op = reinterpret_cast<uint8_t *>(dst);
+  uint8_t *ostart = op;
+  const uint8_t *oend = op + out_len;
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !GetLength(&literal_length, ip, iend)) {
+      return false;
+    }
+    if (static_cast<size_t>(iend - ip) < literal_length || static_cast<size_t>(oend - op) < literal_length) {
+      return false;
+    }
+    memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if (ip == iend) {
+      break;  // the last sequence has no match
+    }
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    size_t match_length = token & 15;
+    if (match_length == 15 && !GetLength(&match_length, ip, iend)) {
+      return false;
+    }
+    match_length += MIN_MATCH;
+    if (offset == 0 || offset > static_cast<size_t>(op - ostart) || static_cast<size_t>(oend - op) < match_length) {
+      return false;
+    }
+    const uint8_t *match = op - offset;
+    if (offset >= match_length) {
+      memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      for (size_t i = 0; i < match_length; i++) {  // overlapping copy repeats the last offset bytes
+        *op++ = match[i];
+      }
+    }
+  }
+  return op == oend;
+}
@@ -0,0 +1,58 @@
+#include "common/memory_arena.h"
+
+#include <cstdint>
+#include <cstring>
+
+MemoryArena::~MemoryArena() {
+  for (auto block : blocks_) {
+    delete[] block;
+  }
+  for (auto block : large_blocks_) {
+    delete[] block;
+  }
+}
+
+void *MemoryArena::Allocate(size_t size, size_t alignment) {
+  if (size + alignment > BLOCK_SIZE / 4) {
+    // a large request gets a block of its own, the current block stays in use
+    auto block = new char[size + alignment];
+    large_blocks_.push_back(block);
+    allocated_bytes_ += size;
+    auto address = reinterpret_cast<uintptr_t>(block);
+    return block + (alignment - address % alignment) % alignment;
+  }
+  size_t padding = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+  if (cursor_ == nullptr || padding + size > remaining_) {
+    blocks_.push_back(new char[BLOCK_SIZE]);
+    cursor_ = blocks_.back();
+    remaining_ = BLOCK_SIZE;
+    padding = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+  }
+  void *result = cursor_ + padding;
+  cursor_ += padding + size;
+  remaining_ -= padding + size;
+  allocated_bytes_ += size;
+  return result;
+}
+
+char *MemoryArena::CopyBytes(const char *data, size_t size) {
+  auto copy = static_cast<char *>(Allocate(size, 1));
+  memcpy(copy, data, size);
+  return copy;
+}
+
+void MemoryArena::Reset() {
+  for (auto block : large_blocks_) {
+    delete[] block;
+  }
+  large_blocks_.clear();
+  for (size_t i = 1; i < blocks_.size(); i++) {
+    delete[] blocks_[i];
+  }
+  if (!blocks_.empty()) {
+    blocks_.resize(1);
+    cursor_ = blocks_[0];
+    remaining_ = BLOCK_SIZE;
+  }
+  allocated_bytes_ = 0;
+}
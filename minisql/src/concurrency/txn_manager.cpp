@@ -1,5 +1,6 @@
 #include "concurrency/txn_manager.h"
 
+#include "buffer/buffer_pool_manager.h"
 #include "concurrency/lock_manager.h"
 
 TxnManager::TxnManager(LockManager *lock_mgr) : lock_mgr_(lock_mgr) { lock_mgr_->SetTxnMgr(this); }
@@ -16,6 +17,10 @@ Txn *TxnManager::Begin(Txn *txn, IsolationLevel isolationLevel) {
 void TxnManager::Commit(Txn *txn) {
   // change state
   txn->SetState(TxnState::kCommitted);
+  // make the changes durable before anybody else can see them
+  if (bpm_ != nullptr) {
+    bpm_->Commit();
+  }
   // release all locks
   ReleaseLocks(txn);
 }
@@ -1,13 +1,16 @@
 #include "executor/execute_engine.h"
 
 #include <dirent.h>
+#include <strings.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
 #include <chrono>
+#include <sstream>
 
 #include "common/result_writer.h"
 #include "executor/executors/delete_executor.h"
+#include "executor/executors/file_scan_executor.h"
 #include "executor/executors/index_scan_executor.h"
 #include "executor/executors/insert_executor.h"
 #include "executor/executors/seq_scan_executor.h"
@@ -23,7 +26,8 @@ extern "C" {
 #include "parser/parser.h"
 }
 
-ExecuteEngine::ExecuteEngine() {
+ExecuteEngine::ExecuteEngine(bool read_only, SyncPolicy sync_policy, bool checksums, bool compressed)
+    : read_only_(read_only), sync_policy_(sync_policy), checksums_(checksums), compressed_(compressed) {
   char path[] = "./databases";
   DIR *dir;
   if ((dir = opendir(path)) == nullptr) {
@@ -40,7 +44,13 @@ ExecuteEngine::ExecuteEngine() {
         strcmp( stdir->d_name , "..") == 0 ||
         stdir->d_name[0] == '.')
       continue;
-    dbs_[stdir->d_name] = new DBStorageEngine(stdir->d_name, false);
+    // the page map of a compressed database is not a database of its own
+    size_t name_len = strlen(stdir->d_name);
+    if (name_len > 4 && strcmp(stdir->d_name + name_len - 4, ".map") == 0)
+      continue;
+    auto db = new DBStorageEngine(stdir->d_name, false, DEFAULT_BUFFER_POOL_SIZE, read_only_, checksums_);
+    db->disk_mgr_->SetSyncPolicy(sync_policy_);
+    dbs_[stdir->d_name] = db;
   }
   
   closedir(dir);
@@ -77,6 +87,9 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
     case PlanType::Values: {
       return std::make_unique<ValuesExecutor>(exec_ctx, dynamic_cast<const ValuesPlanNode *>(plan.get()));
     }
+    case PlanType::FileScan: {
+      return std::make_unique<FileScanExecutor>(exec_ctx, dynamic_cast<const FileScanPlanNode *>(plan.get()));
+    }
     default:
       throw std::logic_error("Unsupported plan type.");
   }
@@ -93,7 +106,7 @@ dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<
     Row row{};
     while (executor->Next(&row, &rid)) {
       if (result_set != nullptr) {
-        result_set->push_back(row);
+        result_set->push_back(std::move(row));
       }
     }
   } catch (const exception &ex) {
@@ -121,6 +134,24 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   auto start_time = std::chrono::system_clock::now();
   unique_ptr<ExecuteContext> context(nullptr);//创建执行上下文，比如当前的事务（虽然本次任务不要求实现事务）、以及最重要的——目录管理器 (CatalogManager)。目录管理器知道当前数据库中有哪些表、哪些索引等元数据信息。
   if (!current_db_.empty()) context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+  if (read_only_) {
+    switch (ast->type_) {
+      case kNodeCreateDB:
+      case kNodeDropDB:
+      case kNodeCreateTable:
+      case kNodeDropTable:
+      case kNodeCreateIndex:
+      case kNodeDropIndex:
+      case kNodeInsert:
+      case kNodeDelete:
+      case kNodeUpdate:
+      case kNodeCopy:
+        cout << "Databases are opened read-only." << endl;
+        return DB_FAILED;
+      default:
+        break;
+    }
+  }
   switch (ast->type_) {//根据 ast 节点的类型 (ast->type_) 来判断这是一条什么类型的 SQL 命令。
     case kNodeCreateDB:
       return ExecuteCreateDatabase(ast, context.get());
@@ -150,6 +181,8 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteTrxRollback(ast, context.get());
     case kNodeExecFile:
       return ExecuteExecfile(ast, context.get());
+    case kNodeCopy:
+      return ExecuteCopy(ast, context.get());
     case kNodeQuit:
       return ExecuteQuit(ast, context.get());
     default:
@@ -157,11 +190,25 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   }
   // Plan the query.
   Planner planner(context.get());//规划器的任务是将 AST 转换成一个物理查询计划 (一个由 PlanNode 组成的树)。
+  MemoryArena arena;  // declared before the result set, which may live in it
   std::vector<Row> result_set{};
   try {
     planner.PlanQuery(ast);
+    // The rows of a select are kept until they are printed and dropped together, place them in one arena.
+    if (planner.plan_->GetType() == PlanType::SeqScan || planner.plan_->GetType() == PlanType::IndexScan) {
+      context->SetArena(&arena);
+    }
     // Execute the query.
-    ExecutePlan(planner.plan_, &result_set, nullptr, context.get());
+    dberr_t result = ExecutePlan(planner.plan_, &result_set, nullptr, context.get());
+    // Autocommit: a statement that modified the table is durable once it returns, as far as the sync policy asks.
+    // A failed insert still keeps the batches it wrote before the failing one.
+    auto plan_type = planner.plan_->GetType();
+    if (plan_type == PlanType::Insert || plan_type == PlanType::Update || plan_type == PlanType::Delete) {
+      dbs_[current_db_]->bpm_->Commit();
+    }
+    if (result != DB_SUCCESS) {
+      return result;
+    }
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
     return DB_FAILED;
@@ -261,7 +308,9 @@ dberr_t ExecuteEngine::ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *co
   if (dbs_.find(db_name) != dbs_.end()) {
     return DB_ALREADY_EXIST;
   }
-  dbs_.insert(make_pair(db_name, new DBStorageEngine(db_name, true)));
+  auto db = new DBStorageEngine(db_name, true, DEFAULT_BUFFER_POOL_SIZE, false, checksums_, compressed_);
+  db->disk_mgr_->SetSyncPolicy(sync_policy_);
+  dbs_.insert(make_pair(db_name, db));
   return DB_SUCCESS;
 }
 
@@ -274,6 +323,7 @@ dberr_t ExecuteEngine::ExecuteDropDatabase(pSyntaxNode ast, ExecuteContext *cont
     return DB_NOT_EXIST;
   }
   remove(("./databases/" + db_name).c_str());
+  remove(DiskManager::PageMapFile("./databases/" + db_name).c_str());
   delete dbs_[db_name];
   dbs_.erase(db_name);
   if (db_name == current_db_)
@@ -789,24 +839,28 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
     LOG(ERROR) << "Table heap is null for table: " << table_name;
     return DB_FAILED;
   }
-  // 遍历表中的每一行数据，为每一行创建索引条目并将其插入到实际的索引数据结构中-填充索引内容的关键步骤
-  for(auto row = table_heap->Begin(context->GetTransaction()); row != table_heap->End(); ++row) {
-    RowId rid = row->GetRowId();
-    vector<Field> key_fields;
-    // index_info->GetIndexKeySchema() 返回了索引包含哪些列以及这些列的顺序
-    for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
-      auto field = row->GetField(column->GetTableInd());
-      key_fields.push_back(*field);//获取索引键字段
-    }
-
-    // 将索引键 (row_index) 和对应的 RowId (rid) 插入到实际的索引数据结构中
-    // index_info->GetIndex() 返回底层的索引实现 (如B+树)
-    Row row_index(key_fields);
-    ret = index_info->GetIndex()->InsertEntry(row_index, rid, context->GetTransaction());//将索引条目插入到索引中
-    if (ret != DB_SUCCESS) {
-      ExecuteInformation(ret); //如果插入索引失败，输出错误信息
-      return ret;
-    } 
+  // 遍历表中的每一行数据，取出索引键和 RowId 交给索引批量构建-填充索引内容的关键步骤
+  // B+树索引会先把所有条目排序（内存放不下时溢出到临时文件），再自底向上逐层建树，比逐行插入快得多
+  auto row = table_heap->Begin(context->GetTransaction());
+  ret = index_info->GetIndex()->BulkLoad(
+      [&](Row *key, RowId *rid) {
+        if (row == table_heap->End()) {
+          return false;
+        }
+        vector<Field> key_fields;
+        // index_info->GetIndexKeySchema() 返回了索引包含哪些列以及这些列的顺序
+        for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+          key_fields.push_back(*row->GetField(column->GetTableInd()));  //获取索引键字段
+        }
+        *key = Row(key_fields);
+        *rid = row->GetRowId();
+        ++row;
+        return true;
+      },
+      context->GetTransaction());
+  if (ret != DB_SUCCESS) {
+    ExecuteInformation(ret); //如果构建索引失败，输出错误信息
+    return ret;
   }
   cout << "Index " << index_name << " created on table " << table_name << " for columns: ";
   for (const auto &col_name : column_names) {
@@ -911,7 +965,39 @@ dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context)
   }
   //存储当前读取的sql语句
   string sql_statement;
-  dberr_t result = DB_SUCCESS; //跟踪执行结果
+  // 连续插入同一张表的 INSERT 语句合并成一条多行 INSERT 执行，批量写入
+  // 合并的语句不超过 InsertExecutor 的一批，执行失败时整批回滚，不会留下任何一行
+  static_assert(EXECFILE_INSERT_BATCH <= InsertExecutor::INSERT_BATCH_SIZE);
+  string batch_head;
+  vector<string> batch_statements, batch_rows;
+  size_t batch_row_count = 0;
+  auto flush_batch = [&]() {
+    dberr_t result = DB_SUCCESS;
+    if (batch_statements.size() == 1) {
+      result = ExecuteStatement(batch_statements[0]);
+    } else if (!batch_statements.empty()) {
+      string merged = batch_head;
+      for (size_t i = 0; i < batch_rows.size(); i++) {
+        merged += (i == 0 ? " " : ", ") + batch_rows[i];
+      }
+      merged += ";";
+      bool syntax_error = false;
+      result = ExecuteStatement(merged, &syntax_error);
+      if (syntax_error || result != DB_SUCCESS) {
+        // 有语句写错了，合并的语句没有执行；或者执行失败（如重复的键），合并的语句已整批回滚。
+        // 逐条执行，以便只有出错的那一条失败
+        for (const auto &statement : batch_statements) {
+          if ((result = ExecuteStatement(statement)) == DB_QUIT) {
+            break;
+          }
+        }
+      }
+    }
+    batch_statements.clear();
+    batch_rows.clear();
+    batch_row_count = 0;
+    return result;
+  };
   int line_number = 0; //跟踪行号，以定位错误
   char ch;//当前读取字符
   //逐字符读取、构建语句、解析和执行
@@ -928,35 +1014,152 @@ dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context)
         sql_statement.clear();
         continue;
       }
-      MinisqlParserInit();
-      //创建词法分析缓冲区并进行词法分析
-      YY_BUFFER_STATE buffer = yy_scan_string(sql_statement.c_str());
-      if (buffer == nullptr) {
-        LOG(ERROR) << "Failed to create buffer for SQL statement: " << sql_statement;
-        result = DB_FAILED;
-        MinisqlParserFinish();
-        break;
+      string head, rows;
+      size_t row_count;
+      if (SplitInsertStatement(sql_statement, &head, &rows, &row_count)) {
+        if (!batch_statements.empty() &&
+            (head != batch_head || batch_row_count + row_count > EXECFILE_INSERT_BATCH)) {
+          flush_batch();
+        }
+        batch_head = head;
+        batch_statements.push_back(sql_statement);
+        batch_rows.push_back(rows);
+        batch_row_count += row_count;
+        sql_statement.clear();
+        continue;
       }
-      //调用Bison解析器进行语法分析
-      int parse_result = yyparse();
-      // yy_delete_buffer(buffer); //删除词法分析缓冲区
-
-      auto result = Execute(MinisqlGetParserRootNode()); //获取解析结果
-      MinisqlParserFinish(); 
-      yy_delete_buffer(buffer); 
-      yylex_destroy(); //清理解析器状态
-      ExecuteInformation(result); //输出执行结果信息
-      if(result == DB_QUIT){
+      if (flush_batch() == DB_QUIT || ExecuteStatement(sql_statement) == DB_QUIT) {
+        batch_statements.clear();
         break;
       }
       sql_statement.clear(); //清空当前语句，准备下一条
     }
   }
+  flush_batch();
   sql_script_file.close(); 
 
   return DB_SUCCESS; 
 }
 
+dberr_t ExecuteEngine::ExecuteStatement(const string &sql, bool *syntax_error) {
+  MinisqlParserInit();
+  //创建词法分析缓冲区并进行词法分析
+  YY_BUFFER_STATE buffer = yy_scan_string(sql.c_str());
+  if (buffer == nullptr) {
+    LOG(ERROR) << "Failed to create buffer for SQL statement: " << sql;
+    MinisqlParserFinish();
+    return DB_FAILED;
+  }
+  //调用Bison解析器进行语法分析
+  yyparse();
+  dberr_t result = DB_FAILED;
+  if (syntax_error != nullptr && MinisqlParserGetError()) {
+    *syntax_error = true;  // 交给调用者处理，不执行也不输出
+  } else {
+    result = Execute(MinisqlGetParserRootNode()); //获取解析结果
+    ExecuteInformation(result); //输出执行结果信息
+  }
+  MinisqlParserFinish();
+  yy_delete_buffer(buffer);
+  yylex_destroy(); //清理解析器状态
+  return result;
+}
+
+bool ExecuteEngine::SplitInsertStatement(const string &sql, string *head, string *rows, size_t *row_count) {
+  // insert into <table> values (...), ...;
+  std::istringstream in(sql);
+  string insert, into, table, values;
+  if (!(in >> insert >> into >> table >> values) || insert != "insert" || into != "into" || values != "values") {
+    return false;
+  }
+  string rest;
+  getline(in, rest, '\0');
+  rest.erase(0, rest.find_first_not_of(" \t\n\r\f\v"));
+  if (rest.size() < 3 || rest.front() != '(' || rest.back() != ';') {
+    return false;
+  }
+  rest.pop_back();
+  rest.erase(rest.find_last_not_of(" \t\n\r\f\v") + 1);
+  if (rest.back() != ')') {
+    return false;
+  }
+  // 每个不在字符串中的最外层括号是一行
+  *row_count = 0;
+  int depth = 0;
+  bool quoted = false;
+  for (size_t i = 0; i < rest.size(); i++) {
+    if (quoted) {
+      if (rest[i] == '\\') {
+        i++;
+      } else if (rest[i] == '"') {
+        quoted = false;
+      }
+    } else if (rest[i] == '"') {
+      quoted = true;
+    } else if (rest[i] == '(') {
+      *row_count += depth++ == 0;
+    } else if (rest[i] == ')') {
+      depth--;
+    }
+  }
+  *head = "insert into " + table + " values";
+  *rows = rest;
+  return true;
+}
+
+/**
+ * Copy - 将数据文件中的行按批流式写入表中（COPY FROM / LOAD DATA INFILE）。
+ */
+dberr_t ExecuteEngine::ExecuteCopy(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteCopy" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected." << endl;
+    return DB_FAILED;
+  }
+  // AST 结构: kNodeCopy -> child_ (kNodeIdentifier: 表名) -> next_ (kNodeString: 文件名) -> next_ (可选的格式)
+  pSyntaxNode table_node = ast->child_;
+  pSyntaxNode file_node = table_node->next_;
+  bool binary = file_node->next_ != nullptr && strcasecmp(file_node->next_->val_, "binary") == 0;
+  auto start_time = std::chrono::system_clock::now();
+  TableInfo *table_info = nullptr;
+  if (context->GetCatalog()->GetTable(table_node->val_, table_info) != DB_SUCCESS) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  // 文件中的行由 FileScanExecutor 逐块流式读取，按批交给 InsertExecutor 写入表和索引；结果行只计数不保存
+  auto scan_plan = std::make_shared<FileScanPlanNode>(table_info->GetSchema(), file_node->val_, binary);
+  auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, scan_plan, table_info->GetTableName());
+  size_t row_count = 0;
+  bool failed = false;
+  try {
+    auto executor = CreateExecutor(context, insert_plan);
+    executor->Init();
+    Row row;
+    RowId rid;
+    while (executor->Next(&row, &rid)) {
+      row_count++;
+    }
+  } catch (const exception &ex) {
+    std::cout << "Error Encountered in Executor Execution: " << ex.what() << std::endl;
+    failed = true;
+  }
+  // 出错之前已写入的批次留在表中，同样提交
+  dbs_[current_db_]->bpm_->Commit();
+  if (failed) {
+    std::cout << row_count << " row(s) loaded into " << table_info->GetTableName() << " before the error." << std::endl;
+    return DB_FAILED;
+  }
+  auto stop_time = std::chrono::system_clock::now();
+  double duration_time =
+      double((std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time)).count());
+  std::stringstream ss;
+  ResultWriter writer(ss);
+  writer.EndInformation(row_count, duration_time, false);
+  std::cout << writer.stream_.rdbuf();
+  return DB_SUCCESS;
+}
+
 /**
  * Quit
  */
@@ -0,0 +1,264 @@
+#include "executor/executors/file_scan_executor.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+bool FileScanExecutor::WriteBinary(const std::string &file_name, const std::vector<Row> &rows, Schema *schema) {
+  FILE *file = fopen(file_name.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  uint32_t column_count = schema->GetColumnCount();
+  bool ok = fwrite(BINARY_MAGIC, sizeof(BINARY_MAGIC), 1, file) == 1 &&
+            fwrite(&column_count, sizeof(column_count), 1, file) == 1;
+  std::vector<char> buf;
+  for (size_t i = 0; ok && i < rows.size(); i++) {
+    uint32_t size = rows[i].GetSerializedSize(schema);
+    buf.resize(size);
+    rows[i].SerializeTo(buf.data(), schema);
+    ok = fwrite(&size, sizeof(size), 1, file) == 1 && fwrite(buf.data(), size, 1, file) == 1;
+  }
+  return fclose(file) == 0 && ok;
+}
+
+FileScanExecutor::FileScanExecutor(ExecuteContext *exec_ctx, const FileScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+FileScanExecutor::~FileScanExecutor() {
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+}
+
+void FileScanExecutor::Init() {
+  // Row serialization takes a mutable schema, it is not modified.
+  schema_ = const_cast<Schema *>(plan_->OutputSchema());
+  file_ = fopen(plan_->GetFileName().c_str(), "rb");
+  if (file_ == nullptr) {
+    throw std::runtime_error("cannot open file " + plan_->GetFileName());
+  }
+  buffer_.resize(READ_BUFFER_SIZE);
+  if (plan_->IsBinary()) {
+    char magic[sizeof(BINARY_MAGIC)];
+    uint32_t column_count;
+    if (!ReadBytes(magic, sizeof(magic)) || memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) {
+      throw std::runtime_error(plan_->GetFileName() + " is not a binary data file");
+    }
+    if (!ReadBytes(reinterpret_cast<char *>(&column_count), sizeof(column_count)) ||
+        column_count != schema_->GetColumnCount()) {
+      throw std::runtime_error("the rows of " + plan_->GetFileName() + " do not have the columns of the table");
+    }
+  }
+}
+
+bool FileScanExecutor::Next(Row *row, [[maybe_unused]] RowId *rid) {
+  if (plan_->IsBinary()) {
+    return NextBinaryRow(row);
+  }
+  std::string error;
+  while (ReadCsvRecord()) {
+    if (MakeCsvRow(row, &error)) {
+      return true;
+    }
+    std::cout << "line " << record_no_ << ": " << error << ", row skipped" << std::endl;
+  }
+  return false;
+}
+
+bool FileScanExecutor::FillBuffer() {
+  pos_ = 0;
+  end_ = fread(buffer_.data(), 1, buffer_.size(), file_);
+  return end_ > 0;
+}
+
+bool FileScanExecutor::ReadBytes(char *buf, size_t size) {
+  while (size > 0) {
+    if (pos_ == end_ && !FillBuffer()) {
+      return false;
+    }
+    size_t n = std::min(size, end_ - pos_);
+    memcpy(buf, buffer_.data() + pos_, n);
+    pos_ += n;
+    buf += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool FileScanExecutor::ReadCsvRecord() {
+  record_.clear();
+  fields_.clear();
+  unterminated_ = false;
+  int c = GetChar();
+  while (c == '\n' || c == '\r') {
+    if (c == '\n') {
+      line_++;
+    }
+    c = GetChar();
+  }
+  if (c == EOF) {
+    return false;
+  }
+  record_no_ = line_;
+  size_t start = 0;
+  bool quoted = false;
+  while (true) {
+    if (c == '"' && !quoted && record_.size() == start) {
+      // quoted field, runs up to a quote that is not doubled
+      quoted = true;
+      while (true) {
+        c = GetChar();
+        if (c == EOF) {
+          unterminated_ = true;
+          break;
+        }
+        if (c == '"') {
+          c = GetChar();
+          if (c != '"') {
+            break;
+          }
+        } else if (c == '\n') {
+          line_++;
+        }
+        record_.push_back(static_cast<char>(c));
+      }
+      continue;
+    }
+    if (c == '\r') {
+      c = GetChar();
+      if (c != '\n') {
+        record_.push_back('\r');
+        continue;
+      }
+    }
+    if (c == ',' || c == '\n' || c == EOF) {
+      fields_.push_back({start, record_.size() - start, quoted});
+      record_.push_back('\0');
+      if (c != ',') {
+        if (c == '\n') {
+          line_++;
+        }
+        return true;
+      }
+      start = record_.size();
+      quoted = false;
+    } else {
+      record_.push_back(static_cast<char>(c));
+    }
+    c = GetChar();
+  }
+}
+
+bool FileScanExecutor::MakeCsvRow(Row *row, std::string *error) {
+  if (unterminated_) {
+    *error = "unterminated quoted field";
+    return false;
+  }
+  uint32_t column_count = schema_->GetColumnCount();
+  if (fields_.size() != column_count) {
+    *error = "expected " + std::to_string(column_count) + " fields, found " + std::to_string(fields_.size());
+    return false;
+  }
+  std::vector<Field> values;
+  values.reserve(column_count);
+  for (uint32_t i = 0; i < column_count; i++) {
+    const Column *column = schema_->GetColumn(i);
+    const CsvField &csv_field = fields_[i];
+    char *data = &record_[csv_field.offset_];
+    if (csv_field.len_ == 0 && !csv_field.quoted_) {
+      if (!column->IsNullable()) {
+        *error = "column " + column->GetName() + " cannot be null";
+        return false;
+      }
+      values.emplace_back(column->GetType());
+      continue;
+    }
+    char *end = nullptr;
+    errno = 0;
+    switch (column->GetType()) {
+      case kTypeInt: {
+        long value = strtol(data, &end, 10);
+        if (end != data + csv_field.len_ || errno != 0 || value < std::numeric_limits<int32_t>::min() ||
+            value > std::numeric_limits<int32_t>::max()) {
+          *error = "\"" + std::string(data) + "\" is not an int for column " + column->GetName();
+          return false;
+        }
+        values.emplace_back(kTypeInt, static_cast<int32_t>(value));
+        break;
+      }
+      case kTypeFloat: {
+        float value = strtof(data, &end);
+        if (end != data + csv_field.len_ || errno != 0) {
+          *error = "\"" + std::string(data) + "\" is not a float for column " + column->GetName();
+          return false;
+        }
+        values.emplace_back(kTypeFloat, value);
+        break;
+      }
+      case kTypeChar: {
+        if (csv_field.len_ > column->GetLength()) {
+          *error = "value too long for column " + column->GetName() + " of char(" +
+                   std::to_string(column->GetLength()) + ")";
+          return false;
+        }
+        values.emplace_back(kTypeChar, data, static_cast<uint32_t>(csv_field.len_), true);
+        break;
+      }
+      default:
+        *error = "column " + column->GetName() + " has an invalid type";
+        return false;
+    }
+  }
+  *row = Row(values);
+  return true;
+}
+
+bool FileScanExecutor::NextBinaryRow(Row *row) {
+  while (true) {
+    uint32_t size;
+    if (pos_ == end_ && !FillBuffer()) {
+      return false;
+    }
+    record_no_++;
+    if (!ReadBytes(reinterpret_cast<char *>(&size), sizeof(size)) || size < sizeof(uint32_t) || size > PAGE_SIZE) {
+      std::cout << "row " << record_no_ << ": broken row header, the rest of the file is skipped" << std::endl;
+      return false;
+    }
+    row_buffer_.resize(size);
+    if (!ReadBytes(row_buffer_.data(), size)) {
+      std::cout << "row " << record_no_ << ": file ends within the row, row skipped" << std::endl;
+      return false;
+    }
+    // Walk the row before deserializing it, so that a broken row cannot make it read past the buffer.
+    const char *buf = row_buffer_.data();
+    uint32_t column_count = schema_->GetColumnCount();
+    uint32_t offset = sizeof(uint32_t) + (column_count + 7) / 8;
+    bool valid = MACH_READ_UINT32(buf) == column_count && offset <= size;
+    for (uint32_t i = 0; valid && i < column_count; i++) {
+      if (buf[sizeof(uint32_t) + i / 8] & static_cast<char>(1 << (i % 8))) {
+        valid = schema_->GetColumn(i)->IsNullable();
+        continue;
+      }
+      uint32_t field_size = sizeof(uint32_t);
+      if (schema_->GetColumn(i)->GetType() == kTypeChar) {
+        valid = offset + sizeof(uint32_t) <= size;
+        if (valid) {
+          uint32_t len = MACH_READ_UINT32(buf + offset);
+          valid = len <= schema_->GetColumn(i)->GetLength();
+          field_size += len;
+        }
+      }
+      offset += field_size;
+      valid = valid && offset <= size;
+    }
+    if (valid && offset == size) {
+      row->DeserializeFrom(row_buffer_.data(), schema_);
+      return true;
+    }
+    std::cout << "row " << record_no_ << ": row does not match the columns of the table, row skipped" << std::endl;
+  }
+}
@@ -99,7 +99,7 @@ bool IndexScanExecutor::Next(Row *row, RowId *rid) {
     if (!is_schema_same_) {
       TupleTransfer(table_schema, plan_->OutputSchema(), p_row, row);
     } else {
-      *row = *p_row;
+      *row = std::move(*p_row);
     }
     delete p_row;
     cursor_++;
@@ -4,6 +4,8 @@
 
 #include "executor/executors/insert_executor.h"
 
+#include <stdexcept>
+
 InsertExecutor::InsertExecutor(ExecuteContext *exec_ctx, const InsertPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -16,27 +18,83 @@ void InsertExecutor::Init() {
 }
 
 bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
-    Row insert_row;
-    RowId insert_rid;
-    if (child_executor_->Next(&insert_row, &insert_rid)) {
-        for (auto info: index_info_) {
-            Row key_row;
-            insert_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
-            std::vector<RowId> result;
-            if (!key_row.GetFields().empty() &&
-                info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS) {
-                std::cout << "key already exists" << std::endl;
-                return false;
+    // Rows are inserted a batch at a time and handed out one by one.
+    while (cursor_ == inserted_.size()) {
+        if (child_done_) { return false; }
+        inserted_.clear();
+        cursor_ = 0;
+
+        Row insert_row;
+        RowId insert_rid;
+        while (inserted_.size() < INSERT_BATCH_SIZE && child_executor_->Next(&insert_row, &insert_rid)) {
+            if (KeyExists(insert_row)) {
+                throw std::runtime_error("key already exists");
             }
+            inserted_.push_back(std::move(insert_row));
         }
-        if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction())) {
-            Row key_row;
-            for (auto info: index_info_) {  // 更新索引
-                insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
-                info->GetIndex()->InsertEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction());
+        child_done_ = inserted_.size() < INSERT_BATCH_SIZE;
+        if (inserted_.empty()) { return false; }
+
+        // A single row goes wherever the table has room, a batch is packed into pages at the tail.
+        auto table_heap = table_info_->GetTableHeap();
+        size_t count = inserted_.size() == 1 ? table_heap->InsertTuple(inserted_[0], exec_ctx_->GetTransaction())
+                                             : table_heap->BulkInsert(inserted_, exec_ctx_->GetTransaction());
+        if (count < inserted_.size()) {
+            RollBackBatch(count, 0);
+            throw std::runtime_error("no room in table " + table_info_->GetTableName() + " for the rows");
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!InsertIndexEntries(inserted_[i])) {
+                // Another row of the batch had the same key.
+                RollBackBatch(count, i);
+                throw std::runtime_error("key already exists");
             }
+        }
+    }
+    *row = std::move(inserted_[cursor_++]);
+    return true;
+}
+
+void InsertExecutor::RollBackBatch(size_t in_table, size_t in_indexes) {
+    for (size_t i = 0; i < in_indexes; i++) {
+        for (auto info: index_info_) {
+            Row key_row;
+            inserted_[i].GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
+            info->GetIndex()->RemoveEntry(key_row, inserted_[i].GetRowId(), exec_ctx_->GetTransaction());
+        }
+    }
+    for (size_t i = 0; i < in_table; i++) {
+        table_info_->GetTableHeap()->ApplyDelete(inserted_[i].GetRowId(), exec_ctx_->GetTransaction());
+    }
+    inserted_.clear();
+}
+
+bool InsertExecutor::KeyExists(Row &insert_row) {
+    for (auto info: index_info_) {
+        Row key_row;
+        insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
+        std::vector<RowId> result;
+        if (!key_row.GetFields().empty() &&
+            info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS) {
             return true;
         }
-  }
-  return false;
-}
\ No newline at end of file
+    }
+    return false;
+}
+
+bool InsertExecutor::InsertIndexEntries(Row &insert_row) {
+    for (size_t i = 0; i < index_info_.size(); i++) {
+        Row key_row;
+        insert_row.GetKeyFromRow(schema_, index_info_[i]->GetIndexKeySchema(), key_row);
+        if (index_info_[i]->GetIndex()->InsertEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction()) !=
+            DB_SUCCESS) {
+            // Take back the entries already made.
+            for (size_t j = 0; j < i; j++) {
+                insert_row.GetKeyFromRow(schema_, index_info_[j]->GetIndexKeySchema(), key_row);
+                index_info_[j]->GetIndex()->RemoveEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction());
+            }
+            return false;
+        }
+    }
+    return true;
+}
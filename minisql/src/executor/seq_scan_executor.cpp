@@ -4,10 +4,13 @@
 #include "executor/executors/seq_scan_executor.h"
 
 SeqScanExecutor::SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx),
-      plan_(plan),
-      iterator_(nullptr, RowId(INVALID_PAGE_ID, 0), nullptr),
-      is_schema_same_(false) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), is_schema_same_(false) {}
+
+SeqScanExecutor::~SeqScanExecutor() {
+  if (page_ != nullptr) {
+    exec_ctx_->GetBufferPoolManager()->UnpinPage(page_->GetTablePageId(), false);
+  }
+}
 
 bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
   auto table_columns = table_schema->GetColumns();
@@ -26,72 +29,52 @@ bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *outp
   return true;
 }
 
-void SeqScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row,
-                                    Row *output_row) {
-  const auto &output_columns = output_schema->GetColumns();
-  std::vector<Field> dest_row;
-  dest_row.reserve(output_columns.size());
-  for (const auto column : output_columns) {
-    // ASSERT(column != nullptr, "Column in output_columns is null!"); 
-    auto idx = column->GetTableInd();
-    
-    // // [DEBUG]
-    // LOG(INFO) << "Output Column: " << column->GetName()
-    //           << ", Table Index (idx): " << idx
-    //           << ", Input Row Field Count: " << row->GetFieldCount();
-
-    // if (idx >= row->GetFieldCount()) {
-    //     LOG(ERROR) << "CRITICAL: idx (" << idx << ") is out of bounds for row with "
-    //                << row->GetFieldCount() << " fields!";
-    // }
-    // Field* field_ptr_from_row = row->GetField(idx);
-    // if (field_ptr_from_row == nullptr) {
-    //     LOG(ERROR) << "CRITICAL: row->GetField(" << idx << ") returned nullptr!";
-    // }
-    
-    dest_row.emplace_back(*row->GetField(idx));
-  }
-  *output_row = Row(dest_row);
-}
-
 void SeqScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  iterator_ = (table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction()));
   schema_ = plan_->OutputSchema();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), schema_);
+  view_ = std::make_unique<RowView>(table_info_->GetSchema());
+  page_ = reinterpret_cast<TablePage *>(
+      exec_ctx_->GetBufferPoolManager()->FetchPage(table_info_->GetTableHeap()->GetFirstPageId()));
+  slot_ = 0;
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
   auto predicate = plan_->GetPredicate();
-  auto table_schema = table_info_->GetSchema();
-
-  // // [DEBUG]
-  // LOG(INFO) << "Table Schema Columns:";
-  // for (const auto& col : table_info_->GetSchema()->GetColumns()) {
-  //     LOG(INFO) << "  Name: " << col->GetName() << ", TableInd: " << col->GetTableInd();
-  // }
-  // LOG(INFO) << "Output Schema Columns:";
-  // for (const auto& col : schema_->GetColumns()) {
-  //     LOG(INFO) << "  Name: " << col->GetName() << ", TableInd: " << col->GetTableInd();
-  // }
-
-  while (iterator_ != table_info_->GetTableHeap()->End()) {
-    auto p_row = &(*iterator_);
-    if (predicate != nullptr) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        iterator_++;
-        continue;
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  while (page_ != nullptr) {
+    page_->RLatch();
+    try {
+      while (slot_ < page_->GetTupleCount()) {
+        if (!page_->GetTupleView(slot_++, view_.get())) {
+          continue;
+        }
+        if (predicate != nullptr && !predicate->Evaluate(*view_).CompareEquals(Field(kTypeInt, 1))) {
+          continue;
+        }
+        if (is_schema_same_) {
+          view_->ToRow(row, exec_ctx_->GetArena());
+        } else {
+          view_->ToRow(schema_, row, exec_ctx_->GetArena());
+        }
+        *rid = view_->GetRowId();
+        page_->RUnlatch();
+        return true;
       }
+    } catch (...) {
+      page_->RUnlatch();
+      throw;
     }
-    *rid = iterator_->GetRowId();
-    if (!is_schema_same_) {
-      TupleTransfer(table_schema, schema_, p_row, row);
-    } else {
-      *row = *p_row;
+    page_id_t next_page_id = page_->GetNextPageId();
+    page_->RUnlatch();
+    bpm->UnpinPage(page_->GetTablePageId(), false);
+    page_ = nullptr;
+    slot_ = 0;
+    if (next_page_id != INVALID_PAGE_ID) {
+      // Heap pages are mostly allocated in order, read the following ones in while this one is processed.
+      bpm->Prefetch(next_page_id + 1, READ_AHEAD_PAGES);
+      page_ = reinterpret_cast<TablePage *>(bpm->FetchPage(next_page_id));
     }
-    iterator_++;
-    return true;
   }
   return false;
 }
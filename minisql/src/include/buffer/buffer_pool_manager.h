@@ -1,20 +1,57 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
-#include <unordered_map>
+#include <thread>
+#include <vector>
 
-#include "buffer/lru_replacer.h"
+#include "buffer/page_table.h"
+#include "buffer/replacer.h"
 #include "page/disk_file_meta_page.h"
 #include "page/page.h"
 #include "storage/disk_manager.h"
 
 using namespace std;
 
+/**
+ * BufferPoolManager caches disk pages in a fixed number of in-memory frames.
+ *
+ * The pool can be partitioned into several shards. Every shard owns a disjoint slice of the frames together with its
+ * own page table, free list, replacer and latch, and a page always lives in the shard selected by its page id. Threads
+ * touching pages of different shards therefore never contend on the same latch. With a single shard (the default) the
+ * manager behaves exactly like an unpartitioned buffer pool.
+ *
+ * Hits do not take the shard latch at all. FetchPage looks the page up in the lock-free page table, pins the frame with
+ * an atomic increment and then checks that the frame still holds the requested page; only misses, evictions and
+ * deletions serialize on the latch. A frame being evicted or loaded has a negative pin count so that it cannot be
+ * pinned optimistically in the meantime. Since pins bypass the replacer, it tracks every resident frame and skips the
+ * pinned ones when choosing a victim. Hits are queued in a small per-shard access buffer and handed to the replacer in
+ * batches whenever the latch is taken, so policies that rank frames by their references still see them.
+ *
+ * The replacement policy (LRU, CLOCK, LRU-K or 2Q) is chosen per buffer pool at construction.
+ *
+ * An optional background flusher writes dirty unpinned pages ahead of eviction so that the thread needing a frame
+ * rarely has to write a victim back itself. Scans can ask for pages ahead of time with Prefetch(), a prefetch thread
+ * then reads them in without pinning them. Both threads keep up to ASYNC_IO_QUEUE_DEPTH requests in flight through
+ * their own AsyncIOContext; a frame with I/O in flight stays locked and mapped, so a FetchPage of it waits for the I/O.
+ * Runs of adjacent pages are moved with one vectored request: the flusher and eviction write dirty unpinned neighbours
+ * of a page along with it, and the prefetcher reads neighbouring pages together.
+ *
+ * Commit() is the durability point of a transaction. Under SyncPolicy::kPerCommit it writes the dirty unpinned pages
+ * and waits for an fdatasync covering them, which it shares with the transactions committing at the same time.
+ *
+ * Over a read-only DiskManager the pool has no frames at all: FetchPage returns pages whose data points straight into
+ * the memory-mapped file, nothing is copied or evicted, and NewPage, DeletePage and FlushPage fail.
+ */
 class BufferPoolManager {
  public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_shards = 1,
+                             ReplacerType replacer_type = ReplacerType::kLRU);
 
   ~BufferPoolManager();
 
@@ -36,9 +73,79 @@ class BufferPoolManager {
 
   bool IsPageFree(page_id_t page_id);
 
+  /**
+   * Hint that pages [page_id, page_id + count) will be fetched soon. Pages that are not resident are queued and read in
+   * asynchronously, unpinned. The hint may be dropped when the queue is full or no frame can be freed.
+   */
+  void Prefetch(page_id_t page_id, size_t count = 1);
+
+  /** Turn Prefetch() hints on or off, they are on by default. */
+  inline void SetReadAhead(bool enabled) { read_ahead_.store(enabled, std::memory_order_relaxed); }
+
   bool CheckAllUnpinned();
 
+  /**
+   * Make the changes of a committing transaction durable according to the sync policy of the DiskManager.
+   */
+  void Commit();
+
+  /** @return true if pages are served from a read-only memory-mapped file */
+  inline bool IsReadOnly() const { return read_only_; }
+
+  /** @return the number of shards the buffer pool is partitioned into */
+  inline size_t GetShardCount() const { return shards_.size(); }
+
+  /** @return the number of fetches served from memory */
+  size_t GetHitCount() const;
+
+  /** @return the number of fetches that had to read the page from disk */
+  size_t GetMissCount() const;
+
+  /**
+   * Start the background flusher. Every interval, or as soon as a dirty victim had to be written back in the
+   * foreground, it writes dirty unpinned pages in page id order until clean_ratio of the frames of every shard are free
+   * or clean. Does nothing if the flusher is already running.
+   */
+  void StartFlusher(double clean_ratio = DEFAULT_CLEAN_FRAME_RATIO,
+                    std::chrono::milliseconds interval = std::chrono::milliseconds(10));
+
+  /** Stop the background flusher and wait for it to exit. */
+  void StopFlusher();
+
+  /** @return the number of dirty victims written back by the thread that needed their frame */
+  inline size_t GetForegroundWriteCount() const { return foreground_writes_.load(std::memory_order_relaxed); }
+
+  /** @return the number of dirty pages written back by the background flusher */
+  inline size_t GetBackgroundWriteCount() const { return background_writes_.load(std::memory_order_relaxed); }
+
  private:
+  /**
+   * One partition of the buffer pool. Frame ids handed to the replacer are local to the shard.
+   */
+  struct Shard {
+    static constexpr size_t ACCESS_BUFFER_SIZE = 64;
+
+    Shard(Page *pages, size_t pool_size) : pages_(pages), pool_size_(pool_size), page_table_(pool_size) {
+      for (auto &access : accesses_) {
+        access.store(INVALID_FRAME_ID, std::memory_order_relaxed);
+      }
+    }
+
+    Page *pages_;                                         // first frame owned by this shard
+    size_t pool_size_;                                    // number of frames owned by this shard
+    PageTable page_table_;                                // to keep track of pages, readable without the latch
+    Replacer *replacer_{nullptr};                         // to find an unpinned page for replacement
+    list<frame_id_t> free_list_;                          // to find a free page for replacement
+    recursive_mutex latch_;                               // to protect shared data structure
+    std::atomic<frame_id_t> accesses_[ACCESS_BUFFER_SIZE];  // hits not yet reported to the replacer
+    std::atomic<size_t> num_accesses_{0};                 // slots of accesses_ handed out since the last drain
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+  };
+
+  /** Pin count of a frame that is free or being (re)loaded, it cannot be pinned until the load is published. */
+  static constexpr int FRAME_LOCKED = -1;
+
   /**
    * Allocate new page (operations like create index/table) For now just keep an increasing counter
    */
@@ -49,16 +156,94 @@ class BufferPoolManager {
    */
   void DeallocatePage(page_id_t page_id);
 
-  frame_id_t TryToFindFreePage();
+  /**
+   * Pick a frame from the free list or the replacer of the shard, writing the evicted page back if it is dirty.
+   * Caller must hold the shard latch. The frame is returned locked (pin count FRAME_LOCKED).
+   * @return true if a frame was found
+   */
+  bool TryToFindFreePage(Shard &shard, frame_id_t *frame_id);
+
+  /**
+   * Write back a dirty victim, together with the dirty unpinned pages of the shard that are its physical neighbours.
+   * Caller must hold the shard latch and have locked the victim.
+   * @return false if the write failed, the pages are then dirty again
+   */
+  bool WriteBackVictim(Shard &shard, Page &victim);
+
+  /**
+   * Publish page_id in a locked frame: reset its metadata, pin it once (or leave it unpinned) and map it in the page
+   * table. Caller must hold the shard latch and have filled the frame data.
+   */
+  void InstallPage(Shard &shard, frame_id_t frame_id, page_id_t page_id, bool pin = true);
+
+  /**
+   * Body of the prefetch thread.
+   */
+  void PrefetchLoop();
+
+  /**
+   * Queue a latch-free hit for the replacer. The thread filling the last slot drains the buffer; hits arriving while it
+   * does so are dropped, the access buffer is only a hint.
+   */
+  void RecordHit(Shard &shard, frame_id_t frame_id);
+
+  /**
+   * Hand the queued hits to the replacer. Caller must hold the shard latch.
+   */
+  void DrainAccesses(Shard &shard);
+
+  /**
+   * Body of the flusher thread.
+   */
+  void FlusherLoop(double clean_ratio, std::chrono::milliseconds interval);
+
+  /**
+   * Write back dirty unpinned pages until every shard has enough clean frames, keeping the writes in flight on io.
+   */
+  void FlushDirtyPages(double clean_ratio, AsyncIOContext *io);
+
+  /**
+   * Wait for the writes that are in flight right now, those of the flusher, of evictions and of FlushPage(). Their
+   * pages are already clean, so a sync has to wait for them to cover every page written so far.
+   */
+  void WaitForInFlightWrites();
+
+  /**
+   * Increment the pin count unless the frame is locked.
+   * @return true if the frame was pinned
+   */
+  static bool TryPin(Page &page);
+
+  /**
+   * FetchPage of a read-only pool: wrap the mapped page data in a Page, created on first use.
+   */
+  Page *FetchMappedPage(page_id_t page_id);
+
+  inline Shard &GetShard(page_id_t page_id) { return *shards_[static_cast<size_t>(page_id) % shards_.size()]; }
 
  private:
-  size_t pool_size_;                                 // number of pages in buffer pool
-  Page *pages_;                                      // array of pages
-  DiskManager *disk_manager_;                        // pointer to the disk manager.
-  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
-  Replacer *replacer_;                               // to find an unpinned page for replacement
-  list<frame_id_t> free_list_;                       // to find a free page for replacement
-  recursive_mutex latch_;                            // to protect shared data structure
+  size_t pool_size_;            // number of pages in buffer pool
+  Page *pages_;                 // array of pages
+  DiskManager *disk_manager_;   // pointer to the disk manager.
+  vector<Shard *> shards_;      // partitions of the buffer pool, selected by page id
+  std::thread flusher_;                      // background writer, not running unless started
+  std::mutex flusher_latch_;                 // protects flusher_stop_ and flusher_wakeup_
+  std::condition_variable flusher_cv_;       // wakes the flusher up early or tells it to stop
+  bool flusher_stop_{false};
+  bool flusher_wakeup_{false};
+  std::thread prefetcher_;                   // reads prefetched pages, started by the first Prefetch()
+  std::mutex prefetch_latch_;                // protects prefetch_queue_ and prefetch_stop_
+  std::condition_variable prefetch_cv_;
+  std::deque<page_id_t> prefetch_queue_;
+  bool prefetch_stop_{false};
+  std::atomic<bool> read_ahead_{true};
+  std::atomic<size_t> foreground_writes_{0};
+  std::atomic<size_t> background_writes_{0};
+  std::mutex commit_latch_;                  // serializes the page writes of Commit(), the sync is shared
+  std::unique_ptr<AsyncIOContext> commit_io_;  // created by the first Commit() that writes pages
+  bool read_only_{false};                    // pages come from the mapping of a read-only file
+  std::atomic<Page *> *mapped_pages_{nullptr};  // Page of every logical page of the mapping, created on first fetch
+  size_t num_mapped_pages_{0};
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
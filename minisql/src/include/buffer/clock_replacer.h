@@ -1,12 +1,6 @@
 #ifndef MINISQL_CLOCK_REPLACER_H
 #define MINISQL_CLOCK_REPLACER_H
 
-#include <algorithm>
-#include <list>
-#include <map>
-#include <mutex>
-#include <queue>
-#include <unordered_set>
 #include <vector>
 
 #include "buffer/replacer.h"
@@ -16,6 +10,9 @@ using namespace std;
 
 /**
  * CLOCKReplacer implements the clock replacement.
+ *
+ * The clock is the frame id space itself: membership and reference bits live in arrays indexed by frame id and the hand
+ * sweeps over them, so Pin/Unpin/RecordAccess are O(1) and nothing is allocated after construction.
  */
 class CLOCKReplacer : public Replacer {
  public:
@@ -36,12 +33,16 @@ class CLOCKReplacer : public Replacer {
 
   void Unpin(frame_id_t frame_id) override;
 
+  void RecordAccess(frame_id_t frame_id) override;
+
   size_t Size() override;
 
  private:
   size_t capacity;
-  list<frame_id_t> clock_list;               // replacer中可以被替换的数据页
-  map<frame_id_t, frame_id_t> clock_status;  // 数据页的存储状态
+  size_t size{0};
+  size_t hand{0};               // next frame the clock looks at
+  vector<bool> in_clock;        // replacer中可以被替换的数据页
+  vector<bool> reference_bits;  // 数据页最近是否被访问过
 };
 
 #endif  // MINISQL_CLOCK_REPLACER_H
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef MINISQL_LRU_K_REPLACER_H
+#define MINISQL_LRU_K_REPLACER_H
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+using namespace std;
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy.
+ *
+ * The victim is the frame whose K-th most recent reference is the oldest. Frames referenced fewer than K times have an
+ * infinite backward K-distance and are evicted first, oldest first reference first, so a page touched by a single
+ * sequential scan never displaces pages that are referenced repeatedly.
+ *
+ * References that follow the previous counted reference of the same frame before `correlation_period` other frames
+ * were admitted are treated as correlated (e.g. a scan reading one row after another from the same page) and do not
+ * count towards K.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * Create a new LRUKReplacer.
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k number of references kept per frame
+   * @param correlation_period admissions that must separate two counted references, 0 for num_pages / 16
+   */
+  explicit LRUKReplacer(size_t num_pages, size_t k = 2, size_t correlation_period = 0);
+
+  ~LRUKReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void RecordAccess(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+ private:
+  /** Ordering key of a tracked frame in its set: the oldest timestamp it keeps. */
+  inline pair<uint64_t, frame_id_t> KeyOf(frame_id_t frame_id) { return {history_[frame_id].front(), frame_id}; }
+
+  inline set<pair<uint64_t, frame_id_t>> &SetOf(frame_id_t frame_id) {
+    return history_[frame_id].size() < k_ ? cold_ : hot_;
+  }
+
+  size_t k_;
+  size_t correlation_period_;
+  uint64_t current_timestamp_{0};
+  uint64_t admissions_{0};
+  vector<bool> tracked_;
+  vector<deque<uint64_t>> history_;       // timestamps of the last (at most) K counted references
+  vector<uint64_t> last_admission_;       // value of admissions_ at the last counted reference
+  set<pair<uint64_t, frame_id_t>> cold_;  // fewer than K references, keyed by the first reference
+  set<pair<uint64_t, frame_id_t>> hot_;   // K references, keyed by the K-th most recent reference
+};
+
+#endif  // MINISQL_LRU_K_REPLACER_H
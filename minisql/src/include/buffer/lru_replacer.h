@@ -1,9 +1,6 @@
 #ifndef MINISQL_LRU_REPLACER_H
 #define MINISQL_LRU_REPLACER_H
 
-#include <list>
-#include <mutex>
-#include <unordered_set>
 #include <vector>
 
 #include "buffer/replacer.h"
@@ -13,6 +10,9 @@ using namespace std;
 
 /**
  * LRUReplacer implements the Least Recently Used replacement policy.
+ *
+ * The LRU list is intrusive: it is threaded through two arrays indexed by frame id, so every operation is O(1) and
+ * nothing is allocated after construction.
  */
 class LRUReplacer : public Replacer {
  public:
@@ -33,7 +33,7 @@ class LRUReplacer : public Replacer {
   bool Victim(frame_id_t *frame_id) override;
 
   /**
-   * Can't be removed when pinned <==> removed from lru_list_.
+   * Can't be removed when pinned <==> removed from the lru list.
    */
   void Pin(frame_id_t frame_id) override;
 
@@ -42,21 +42,41 @@ class LRUReplacer : public Replacer {
    */
   void Unpin(frame_id_t frame_id) override;
 
+  /**
+   * Accessed again, becomes the most recently used page.
+   */
+  void RecordAccess(frame_id_t frame_id) override;
+
   /**
    * Return the number of pages that can be removed.
    */
   size_t Size() override;
 
 private:
-  // add your own private member variables here
+  inline void Link(frame_id_t frame_id) {
+    frame_id_t tail = prev_[head_];
+    prev_[frame_id] = tail;
+    next_[frame_id] = head_;
+    next_[tail] = frame_id;
+    prev_[head_] = frame_id;
+  }
+
+  inline void Unlink(frame_id_t frame_id) {
+    next_[prev_[frame_id]] = next_[frame_id];
+    prev_[next_[frame_id]] = prev_[frame_id];
+  }
+
   /**
-   * The most recently used page is linked at the end, while the least recently used page is linked at the head.
+   * Slot num_pages is the sentinel: next_[head_] is the least recently used page, prev_[head_] the most recently used.
    */
-  std::list<frame_id_t> lru_list_; 
+  frame_id_t head_;
+  std::vector<frame_id_t> prev_;
+  std::vector<frame_id_t> next_;
   /**
-   * Hash table to rapidly judge wheter a frame_id is in lru_list_.
+   * Whether a frame_id is in the lru list.
    */
-  std::unordered_set<frame_id_t> lru_set_;
+  std::vector<bool> in_list_;
+  size_t size_{0};
 };
 
 #endif  // MINISQL_LRU_REPLACER_H
@@ -0,0 +1,68 @@
+#ifndef MINISQL_PAGE_TABLE_H
+#define MINISQL_PAGE_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * PageTable maps the page ids resident in a buffer pool shard to their frames.
+ *
+ * It is a fixed-capacity open-addressing hash table whose slots are single 64-bit atomics holding a (page id, frame id)
+ * pair, so Find() never takes a latch and never observes a torn entry. Insert() and Erase() must be serialized by the
+ * caller (the shard latch). A concurrent Find() may miss an entry that is being moved by a rebuild, and may return a
+ * frame that is being evicted; callers must treat the result as a hint and validate it against the frame.
+ */
+class PageTable {
+ public:
+  /**
+   * Create a table able to hold one entry per frame.
+   * @param num_frames number of frames the table has to map
+   */
+  explicit PageTable(size_t num_frames);
+
+  ~PageTable();
+
+  /** @return the frame holding page_id, or INVALID_FRAME_ID if it is not found. Safe without the writer latch. */
+  frame_id_t Find(page_id_t page_id) const;
+
+  /** Map page_id to frame_id, replacing any previous mapping. Caller must hold the writer latch. */
+  void Insert(page_id_t page_id, frame_id_t frame_id);
+
+  /** Remove the mapping of page_id. Caller must hold the writer latch. @return false if page_id was not mapped */
+  bool Erase(page_id_t page_id);
+
+  /** @return the number of mapped pages */
+  inline size_t Size() const { return size_; }
+
+ private:
+  static constexpr page_id_t EMPTY_KEY = INVALID_PAGE_ID;
+  static constexpr page_id_t TOMBSTONE_KEY = INVALID_PAGE_ID - 1;
+
+  static inline uint64_t Pack(page_id_t page_id, frame_id_t frame_id) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(page_id)) << 32) | static_cast<uint32_t>(frame_id);
+  }
+
+  static inline page_id_t KeyOf(uint64_t slot) { return static_cast<page_id_t>(slot >> 32); }
+
+  static inline frame_id_t ValueOf(uint64_t slot) { return static_cast<frame_id_t>(slot & 0xFFFFFFFFu); }
+
+  /** Page ids are dense and shards stride them, so use the high bits of a multiplicative hash. */
+  inline size_t HomeSlot(page_id_t page_id) const {
+    return static_cast<size_t>((static_cast<uint32_t>(page_id) * 2654435769u) >> shift_);
+  }
+
+  /** Re-insert every live entry to get rid of tombstones. */
+  void Rebuild();
+
+  std::atomic<uint64_t> *slots_;
+  size_t capacity_;
+  size_t mask_;
+  uint32_t shift_;
+  size_t size_{0};
+  size_t tombstones_{0};
+};
+
+#endif  // MINISQL_PAGE_TABLE_H
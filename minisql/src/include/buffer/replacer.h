@@ -2,14 +2,25 @@
 #define MINISQL_REPLACER_H
 
 #include <cstdio>
+#include <functional>
+#include <utility>
 
 #include "common/config.h"
 
+/** Replacement policies a buffer pool can be configured with. */
+enum class ReplacerType { kLRU, kClock, kLRUK, k2Q };
+
 /**
  * Replacer is an abstract class that tracks page usage.
  */
 class Replacer {
  public:
+  /**
+   * Decides whether a tracked frame may be evicted right now. Victim() skips the frames it rejects without forgetting
+   * them, and removes and returns the first frame it accepts.
+   */
+  using EvictionFilter = std::function<bool(frame_id_t)>;
+
   Replacer() = default;
 
   virtual ~Replacer() = default;
@@ -33,8 +44,23 @@ class Replacer {
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * Records another access to a frame that is already tracked, frames that are not tracked are ignored.
+   * @param frame_id the id of the frame that was accessed
+   */
+  virtual void RecordAccess(frame_id_t frame_id) = 0;
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
+
+  /** Install a filter consulted by Victim(), by default every tracked frame can be evicted. */
+  inline void SetEvictionFilter(EvictionFilter filter) { eviction_filter_ = std::move(filter); }
+
+ protected:
+  inline bool IsEvictable(frame_id_t frame_id) { return !eviction_filter_ || eviction_filter_(frame_id); }
+
+ private:
+  EvictionFilter eviction_filter_;
 };
 
 #endif  // MINISQL_REPLACER_H
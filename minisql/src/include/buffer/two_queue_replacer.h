@@ -0,0 +1,61 @@
+#ifndef MINISQL_TWO_QUEUE_REPLACER_H
+#define MINISQL_TWO_QUEUE_REPLACER_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+using namespace std;
+
+/**
+ * TwoQueueReplacer implements the simplified 2Q replacement policy.
+ *
+ * Newly admitted frames enter the FIFO probation queue A1. A frame referenced again while in A1 is promoted to the
+ * LRU main queue Am. Victims come from A1 as long as it holds more than its share of the frames, so pages read once by a
+ * scan cycle through A1 while the working set stays in Am.
+ *
+ * A reference that arrives before `correlation_period` other frames were admitted after the frame itself is treated as
+ * correlated (e.g. a scan reading one row after another from the same page) and does not promote it.
+ */
+class TwoQueueReplacer : public Replacer {
+ public:
+  /**
+   * Create a new TwoQueueReplacer.
+   * @param num_pages the maximum number of pages the TwoQueueReplacer will be required to store
+   * @param a1_ratio share of the frames A1 may hold before it is preferred for eviction
+   * @param correlation_period admissions that must separate admission and promotion, 0 for a quarter of A1
+   */
+  explicit TwoQueueReplacer(size_t num_pages, double a1_ratio = 0.25, size_t correlation_period = 0);
+
+  ~TwoQueueReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void RecordAccess(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+ private:
+  enum class Queue : uint8_t { kNone, kA1, kAm };
+
+  /** Remove and return the first evictable frame of the queue. */
+  bool VictimFrom(list<frame_id_t> &queue, frame_id_t *frame_id);
+
+  size_t a1_max_;
+  size_t correlation_period_;
+  uint64_t admissions_{0};
+  list<frame_id_t> a1_;                          // probation queue, oldest admission at the front
+  list<frame_id_t> am_;                          // main queue, least recently used at the front
+  vector<Queue> queue_;                          // queue each frame currently sits in
+  vector<list<frame_id_t>::iterator> position_;  // position of each tracked frame in its queue
+  vector<uint64_t> admitted_at_;                 // value of admissions_ when the frame entered A1
+};
+
+#endif  // MINISQL_TWO_QUEUE_REPLACER_H
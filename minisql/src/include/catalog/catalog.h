@@ -103,6 +103,13 @@ class CatalogManager {
 
   dberr_t LoadIndex(const index_id_t index_id, const page_id_t page_id);
 
+  /**
+   * Rebuild an index whose pages were written in an older key format from its table, and record the current format in
+   * its meta page. The old pages cannot be walked and are left behind.
+   */
+  dberr_t RebuildIndex(IndexInfo *index_info, IndexMetadata *index_meta, TableInfo *table_info,
+                       const page_id_t page_id);
+
   dberr_t GetTable(const table_id_t table_id, TableInfo *&table_info) const;
 
  private:
@@ -33,6 +33,17 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  /** @return version of the key encoding and page layout the index pages were written with */
+  inline uint32_t GetKeyFormat() const { return key_format_; }
+
+  inline void SetKeyFormat(uint32_t key_format) { key_format_ = key_format; }
+
+  /**
+   * Key encoding and page layout of the indexes built now: keys encoded for memcmp (KeyManager) in nodes that also
+   * hold them packed (BPlusTreePage). Indexes of an older format are rebuilt when loaded.
+   */
+  static constexpr uint32_t KEY_FORMAT_VERSION = 1;
+
  private:
   IndexMetadata() = delete;
 
@@ -40,11 +51,14 @@ class IndexMetadata {
                          const std::vector<uint32_t> &key_map);
 
  private:
-  static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
+  static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344529;
+  // layout without the key format, of indexes whose keys are in format 0
+  static constexpr uint32_t INDEX_METADATA_MAGIC_NUM_NO_KEY_FORMAT = 344528;
   index_id_t index_id_;
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  uint32_t key_format_{KEY_FORMAT_VERSION};
 };
 
 /**
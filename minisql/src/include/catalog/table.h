@@ -23,7 +23,7 @@ class TableMetadata {
    * will create new table schema and owned by mem heap
    */
   static TableMetadata *Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
-                               TableSchema *schema);
+                               TableSchema *schema, page_id_t free_space_map_page_id = INVALID_PAGE_ID);
 
   inline table_id_t GetTableId() const { return table_id_; }
 
@@ -31,18 +31,24 @@ class TableMetadata {
 
   inline uint32_t GetFirstPageId() const { return root_page_id_; }
 
+  inline page_id_t GetFreeSpaceMapPageId() const { return free_space_map_page_id_; }
+
   inline Schema *GetSchema() const { return schema_; }
 
  private:
   TableMetadata() = delete;
 
-  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema);
+  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                page_id_t free_space_map_page_id);
 
  private:
-  static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
+  static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344529;
+  // layout without the free space map page id, still read
+  static constexpr uint32_t TABLE_METADATA_MAGIC_NUM_NO_FSM = 344528;
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
+  page_id_t free_space_map_page_id_;
   Schema *schema_;
 };
 
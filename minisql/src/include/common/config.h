@@ -14,7 +14,15 @@ static constexpr int CATALOG_META_PAGE_ID = 0;  // logical page id of the catalo
 static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index roots
 
 static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
+static constexpr int PAGE_CHECKSUM_SIZE = 4;            // trailer of every logical page, holds its checksum
+static constexpr int CACHE_LINE_SIZE = 64;
 static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
+static constexpr double DEFAULT_CLEAN_FRAME_RATIO = 0.1;  // share of frames the background flusher keeps clean
+static constexpr int READ_AHEAD_PAGES = 8;                // pages a sequential scan asks the buffer pool to prefetch
+static constexpr size_t ASYNC_IO_QUEUE_DEPTH = 32;       // requests the buffer pool background threads keep in flight
+static constexpr size_t MAX_COALESCED_PAGES = 32;        // adjacent pages the buffer pool moves with one request
+static constexpr double INDEX_FILL_FACTOR = 0.9;         // share of a B+ tree page a bulk load fills
+static constexpr size_t INDEX_SORT_MEMORY = 64 << 20;    // bytes an index build sorts in memory before spilling runs
 
 // static constexpr int PAGE_SIZE = 128;                  // size of a data page in byte
 // static constexpr int DEFAULT_BUFFER_POOL_SIZE = 1024 * 5;  // default size of buffer pool
@@ -0,0 +1,20 @@
+#ifndef MINISQL_CRC32C_H
+#define MINISQL_CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CRC-32C (Castagnoli), the checksum of the SSE4.2 and ARMv8 CRC instructions. Uses them when the CPU has them and a
+ * table driven slicing-by-8 implementation otherwise.
+ * @param crc checksum of the preceding data, 0 for the first call
+ */
+uint32_t Crc32c(const void *data, size_t len, uint32_t crc = 0);
+
+/** Software implementation, for testing and comparison. */
+uint32_t Crc32cSoftware(const void *data, size_t len, uint32_t crc = 0);
+
+/** @return true if Crc32c() uses CRC instructions */
+bool Crc32cIsHardware();
+
+#endif  // MINISQL_CRC32C_H
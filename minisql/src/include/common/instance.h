@@ -14,7 +14,14 @@
 
 class DBStorageEngine {
  public:
-  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE);
+  /**
+   * Open (or, with init, create) a database under ./databases/.
+   * With read_only the file is memory-mapped and pages are read straight from the mapping; init must be false.
+   * With checksums pages are checksummed when written and verified when read. With compressed a new database stores its
+   * pages compressed, an existing one is opened in the format it was created with.
+   */
+  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                           bool read_only = false, bool checksums = false, bool compressed = false);
 
   ~DBStorageEngine();
 
@@ -26,6 +33,7 @@ class DBStorageEngine {
   CatalogManager *catalog_mgr_;
   std::string db_file_name_;
   bool init_;
+  bool read_only_;
 };
 
 #endif  // MINISQL_INSTANCE_H
@@ -0,0 +1,24 @@
+#ifndef MINISQL_LZ_CODEC_H
+#define MINISQL_LZ_CODEC_H
+
+#include <cstddef>
+
+/**
+ * Byte oriented LZ77 compression in the LZ4 block format: a sequence is a token (literal length and match length
+ * nibbles), the literals, a 2-byte little-endian match offset and length extension bytes. It is meant for single pages,
+ * matches reach back at most 64 KB.
+ */
+
+/**
+ * Compress len bytes of src into dst.
+ * @return the compressed size, 0 if it would exceed capacity
+ */
+size_t LzCompress(const char *src, size_t len, char *dst, size_t capacity);
+
+/**
+ * Decompress len bytes of src, which must expand to exactly out_len bytes in dst.
+ * @return false if src is malformed
+ */
+bool LzDecompress(const char *src, size_t len, char *dst, size_t out_len);
+
+#endif  // MINISQL_LZ_CODEC_H
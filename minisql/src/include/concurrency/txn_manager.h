@@ -8,6 +8,7 @@
 #include "common/config.h"
 #include "concurrency/txn.h"
 
+class BufferPoolManager;
 class LockManager;
 
 class TxnManager {
@@ -25,7 +26,7 @@ class TxnManager {
   Txn *Begin(Txn *txn = nullptr, IsolationLevel isolationLevel = IsolationLevel::kRepeatedRead);
 
   /**
-   * Commits a transaction.
+   * Commits a transaction. If a buffer pool is set, its changes are made durable before its locks are released.
    * @param txn the transaction to commit
    */
   void Commit(Txn *txn);
@@ -43,11 +44,17 @@ class TxnManager {
    */
   Txn *GetTransaction(txn_id_t txn_id);
 
+  /**
+   * Set the buffer pool whose pages are made durable on commit.
+   */
+  inline void SetBufferPoolManager(BufferPoolManager *bpm) { bpm_ = bpm; }
+
  private:
   void ReleaseLocks(Txn *txn);
 
  private:
   LockManager *lock_mgr_{nullptr};
+  BufferPoolManager *bpm_{nullptr};
   std::atomic<txn_id_t> next_txn_id_{0};
   /** The transaction map is a global list of all the running transactions in the system. */
   std::unordered_map<txn_id_t, Txn *> txn_map_{};
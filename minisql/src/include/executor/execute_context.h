@@ -8,6 +8,7 @@
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/catalog.h"
 #include "common/macros.h"
+#include "common/memory_arena.h"
 #include "concurrency/txn.h"
 
 class ExecuteContext {
@@ -34,6 +35,12 @@ class ExecuteContext {
   /** @return the buffer pool manager */
   BufferPoolManager *GetBufferPoolManager() { return bpm_; }
 
+  /** @return the arena the rows produced by the query are placed in, nullptr if they are allocated one by one */
+  MemoryArena *GetArena() { return arena_; }
+
+  /** Place the rows produced by the query in arena, which must outlive them. */
+  void SetArena(MemoryArena *arena) { arena_ = arena; }
+
  private:
   /** The recovery context associated with this executor context */
   Txn *transaction_;
@@ -41,6 +48,8 @@ class ExecuteContext {
   CatalogManager *catalog_;
   /** The buffer pool manager associated with this executor context */
   BufferPoolManager *bpm_;
+  /** The arena for the rows of the query, if any */
+  MemoryArena *arena_{nullptr};
 };
 
 #endif  // MINISQL_EXECUTE_CONTEXT_H
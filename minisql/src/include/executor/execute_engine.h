@@ -22,7 +22,14 @@ extern "C" {
  */
 class ExecuteEngine {
  public:
-  ExecuteEngine();
+  /**
+   * Open every database under ./databases/. With read_only they are memory-mapped and statements that would modify
+   * them are rejected. sync_policy decides when committed changes reach the disk, every statement that modifies a table
+   * commits on its own. With checksums, pages are checksummed when written and verified when read. With compressed, new
+   * databases are created with compressed pages; existing ones keep the format they were created with.
+   */
+  explicit ExecuteEngine(bool read_only = false, SyncPolicy sync_policy = SyncPolicy::kNone, bool checksums = false,
+                         bool compressed = false);
 
   ~ExecuteEngine() {
     for (auto it : dbs_) {
@@ -40,6 +47,12 @@ class ExecuteEngine {
 
   void ExecuteInformation(dberr_t result);
 
+  /**
+   * Parse and execute one statement, printing its outcome.
+   * @param syntax_error if given, a statement that does not parse is neither executed nor reported, *syntax_error is set
+   */
+  dberr_t ExecuteStatement(const std::string &sql, bool *syntax_error = nullptr);
+
  private:
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
@@ -73,9 +86,32 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  /**
+   * COPY table FROM "file" [csv | binary], LOAD DATA INFILE "file" INTO TABLE table [csv | binary]:
+   * stream the rows of a data file into the table in batches.
+   */
+  dberr_t ExecuteCopy(pSyntaxNode ast, ExecuteContext *context);
+
+  /**
+   * Split "insert into t values (...), (...);" into "insert into t values" and its rows.
+   * @param row_count set to the number of rows
+   * @return false if sql is not such an insert
+   */
+  static bool SplitInsertStatement(const std::string &sql, std::string *head, std::string *rows, size_t *row_count);
+
+  /**
+   * Rows of consecutive inserts into one table that EXECFILE runs as one multi-row insert. They fit into one batch of
+   * InsertExecutor, so a merged insert that fails leaves none of them behind and its inserts are run one by one.
+   */
+  static constexpr size_t EXECFILE_INSERT_BATCH = 512;
+
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  bool read_only_;                                         /** databases are opened read-only */
+  SyncPolicy sync_policy_;                                 /** when commits are made durable */
+  bool checksums_;                                         /** pages carry checksums */
+  bool compressed_;                                        /** new databases store pages compressed */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
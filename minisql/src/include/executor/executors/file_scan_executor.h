@@ -0,0 +1,118 @@
+#ifndef MINISQL_FILE_SCAN_EXECUTOR_H
+#define MINISQL_FILE_SCAN_EXECUTOR_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/file_scan_plan.h"
+
+/**
+ * The FileScanExecutor streams the rows of a data file, built directly against the output schema.
+ *
+ * The file is read in chunks of READ_BUFFER_SIZE bytes, so it never has to fit into memory.
+ *
+ * CSV: one row per line, fields separated by ',', lines end with "\n" or "\r\n" and blank lines are skipped. A field
+ * may be enclosed in double quotes, then it can contain ',', line breaks and "" for a quote. An empty unquoted field is
+ * NULL, an empty quoted field is the empty string.
+ *
+ * Binary: BINARY_MAGIC, the column count as uint32_t, then every row as its size in uint32_t followed by the row as
+ * written by Row::SerializeTo.
+ *
+ * A row that does not match the schema is reported with its line (row number in a binary file) and skipped.
+ */
+class FileScanExecutor : public AbstractExecutor {
+ public:
+  /** The first bytes of a binary file. */
+  static constexpr char BINARY_MAGIC[8] = {'M', 'S', 'Q', 'L', 'R', 'O', 'W', 'S'};
+
+  /** Bytes read from the file at a time. */
+  static constexpr size_t READ_BUFFER_SIZE = 1 << 20;
+
+  /**
+   * Write rows in the binary format.
+   * @return false if the file could not be written
+   */
+  static bool WriteBinary(const std::string &file_name, const std::vector<Row> &rows, Schema *schema);
+
+  /**
+   * Construct a new FileScanExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The file scan plan to be executed
+   */
+  FileScanExecutor(ExecuteContext *exec_ctx, const FileScanPlanNode *plan);
+
+  ~FileScanExecutor() override;
+
+  /** Open the file, throws if it cannot be opened or is not a binary file of the schema */
+  void Init() override;
+
+  /**
+   * Yield the next row from the file.
+   * @param[out] row The next row of the file
+   * @param[out] rid Not used by file scan executor
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool Next(Row *row, [[maybe_unused]] RowId *rid) override;
+
+  /** @return The output schema for the file scan */
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  /** @return the next byte of the file, EOF at its end */
+  inline int GetChar() {
+    if (pos_ == end_ && !FillBuffer()) {
+      return EOF;
+    }
+    return static_cast<unsigned char>(buffer_[pos_++]);
+  }
+
+  /** Read the next chunk of the file. @return false at the end of the file */
+  bool FillBuffer();
+
+  /** Read size bytes of the file into buf. @return false if the file ends before */
+  bool ReadBytes(char *buf, size_t size);
+
+  /**
+   * Split the next CSV record into record_ and fields_.
+   * @return false at the end of the file
+   */
+  bool ReadCsvRecord();
+
+  /**
+   * Convert the fields of the current CSV record into a row.
+   * @return false with error set if the record does not match the schema
+   */
+  bool MakeCsvRow(Row *row, std::string *error);
+
+  /**
+   * Read the next row of a binary file.
+   * @return false at the end of the file, or if the file is broken
+   */
+  bool NextBinaryRow(Row *row);
+
+  /** A field of the current CSV record, record_[offset_, offset_ + len_) followed by '\0'. */
+  struct CsvField {
+    size_t offset_;
+    size_t len_;
+    bool quoted_;
+  };
+
+  /** The file scan plan node to be executed */
+  const FileScanPlanNode *plan_;
+  Schema *schema_{};
+  FILE *file_{nullptr};
+  std::vector<char> buffer_;
+  size_t pos_{0};
+  size_t end_{0};
+  std::string record_;            // the fields of the current CSV record, each ended by '\0'
+  std::vector<CsvField> fields_;
+  bool unterminated_{false};      // the current CSV record ends inside a quoted field
+  size_t line_{1};                // line of the CSV file the next character is on
+  size_t record_no_{0};           // line the current CSV record starts on, or number of the current binary row
+  std::vector<char> row_buffer_;  // the current binary row
+};
+
+#endif  // MINISQL_FILE_SCAN_EXECUTOR_H
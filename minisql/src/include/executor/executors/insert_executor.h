@@ -12,7 +12,9 @@
 /**
  * InsertExecutor executes an insert on a table.
  *
- * Inserted values are always pulled from a child executor.
+ * Inserted values are always pulled from a child executor, in batches of INSERT_BATCH_SIZE rows. A batch is written
+ * with TableHeap::BulkInsert. A row whose key is already in an index, or that does not fit into the table, fails the
+ * insert: its batch is taken out of the table and the indexes again and Next() throws. Rows of earlier batches stay.
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -41,13 +43,35 @@ class InsertExecutor : public AbstractExecutor {
   /** @return The output schema for the insert */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
+  /** Number of rows pulled from the child and inserted together. */
+  static constexpr size_t INSERT_BATCH_SIZE = 1024;
+
  private:
+  /** @return true if the key of the row is already in one of the indexes of the table */
+  bool KeyExists(Row &insert_row);
+
+  /**
+   * Add the row to every index of the table.
+   * @return false, with no entry added, if its key is already in one of them
+   */
+  bool InsertIndexEntries(Row &insert_row);
+
+  /**
+   * Take the current batch out of the table and the indexes again.
+   * @param in_table Rows at the front of the batch that are in the table
+   * @param in_indexes Rows at the front of the batch that are in every index
+   */
+  void RollBackBatch(size_t in_table, size_t in_indexes);
+
   /** The insert plan node to be executed*/
   const InsertPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_executor_;
   TableInfo *table_info_{};
   const Schema *schema_{};
   std::vector<IndexInfo *> index_info_;
+  std::vector<Row> inserted_;  // rows of the current batch
+  size_t cursor_{0};           // next row of inserted_ to yield
+  bool child_done_{false};
 };
 
 #endif  // MINISQL_INSERT_EXECUTOR_H
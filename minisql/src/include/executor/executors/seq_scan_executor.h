@@ -10,9 +10,14 @@
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "record/row_view.h"
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ *
+ * The scan walks the page chain itself and keeps the current page pinned between calls to Next(). Each tuple is read
+ * in place through a RowView: the predicate runs on the page bytes and only rows that pass it are copied out, with
+ * just the columns of the output schema.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -23,6 +28,8 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  ~SeqScanExecutor() override;
+
   /** Initialize the sequential scan */
   void Init() override;
 
@@ -39,15 +46,15 @@ class SeqScanExecutor : public AbstractExecutor {
 
   bool SchemaEqual(const Schema *table_schema, const Schema *output_schema);
 
-  void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
-
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_{};
-  TableIterator iterator_;
   const Schema *schema_{};
   bool is_schema_same_;
+  std::unique_ptr<RowView> view_;  // the current tuple
+  TablePage *page_{nullptr};       // the current page, pinned
+  uint32_t slot_{0};               // the next slot of the current page
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
@@ -23,6 +23,7 @@ enum class PlanType {
   Limit,
   Distinct,
   NestedLoopJoin,
+  FileScan,
 };
 
 class AbstractPlanNode;
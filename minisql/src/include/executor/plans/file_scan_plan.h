@@ -0,0 +1,38 @@
+#ifndef MINISQL_FILE_SCAN_PLAN_H
+#define MINISQL_FILE_SCAN_PLAN_H
+
+#include <string>
+#include <utility>
+
+#include "abstract_plan.h"
+
+/**
+ * The FileScanPlanNode represents the rows of a data file, used as the child of an insert for
+ * `COPY table FROM "file"` and `LOAD DATA INFILE "file" INTO TABLE table`.
+ * The file is either CSV text or the native binary format written by FileScanExecutor::WriteBinary.
+ */
+class FileScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new FileScanPlanNode instance.
+   * @param output The schema of the table the rows are read for
+   * @param file_name The file to read
+   * @param binary Whether the file is in the native binary format rather than CSV
+   */
+  FileScanPlanNode(const Schema *output, std::string file_name, bool binary)
+      : AbstractPlanNode(output, {}), file_name_(std::move(file_name)), binary_(binary) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::FileScan; }
+
+  /** @return The file to read */
+  const std::string &GetFileName() const { return file_name_; }
+
+  /** @return Whether the file is in the native binary format */
+  bool IsBinary() const { return binary_; }
+
+  std::string file_name_;
+  bool binary_;
+};
+
+#endif  // MINISQL_FILE_SCAN_PLAN_H
@@ -1,10 +1,15 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
 
+#include "common/rwlatch.h"
 #include "concurrency/txn.h"
 #include "index/index_iterator.h"
 #include "page/b_plus_tree_internal_page.h"
@@ -20,6 +25,18 @@
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ *
+ * Insert, Remove and GetValue may run concurrently. A lookup crabs read latches from the root down: it latches a child
+ * before releasing its parent, and ends holding only the leaf. Insert and Remove first descend the same way and write
+ * latch just the leaf, which is enough unless the leaf would split or underflow. Only then do they start over
+ * pessimistically, write latching from the root down and releasing the latches above each node that can take the change
+ * without passing it to its parent. root_latch_ guards root_page_id_ and is held like the latch of the root's parent.
+ * Pages emptied by a merge are deleted once the descent has released them; one that another thread has not unpinned yet
+ * is kept in deleted_pages_ and deleted by a later removal.
+ *
+ * Index iterators read latch their leaf for each step, but hold no latch between steps. A removal that may merge pages
+ * waits at scan_gate_ until no iterator is alive, so the leaves an iterator walks are never freed under it; a thread
+ * must not remove from a tree while it holds one of its iterators.
  */
 class BPlusTree {
   using InternalPage = BPlusTreeInternalPage;
@@ -41,13 +58,22 @@ class BPlusTree {
   // return the value associated with a given key
   bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
 
+  /**
+   * Build this B+ tree, which must be empty, from count key & value pairs in strictly increasing key order, which next
+   * copies out one at a time. Leaves are filled left to right to fill_factor of their max size, then each level of
+   * internal pages is built from the one below. Returns false, leaving the tree empty, if next runs out of pairs or
+   * the keys do not increase.
+   */
+  bool BulkLoad(size_t count, const std::function<bool(GenericKey *key, RowId *value)> &next,
+                double fill_factor = INDEX_FILL_FACTOR);
+
   IndexIterator Begin();
 
   IndexIterator Begin(const GenericKey *key);
 
   IndexIterator End();
 
-  // expose for test purpose
+  // expose for test purpose, takes no latches
   Page *FindLeafPage(const GenericKey *key, page_id_t page_id = INVALID_PAGE_ID, bool leftMost = false);
 
   // used to check whether all pages are unpinned
@@ -68,9 +94,37 @@ class BPlusTree {
   }
 
  private:
+  /** What a descent is for, which decides when a node is safe, see IsSafe. */
+  enum class Operation { kInsert, kRemove };
+
+  /**
+   * Find the leaf page containing key, or the left most one, crabbing read latches. The leaf is returned pinned and
+   * read latched, or write latched if write_leaf. Returns nullptr if the tree is empty.
+   */
+  Page *FindLeafPageOptimistic(const GenericKey *key, bool left_most, bool write_leaf);
+
+  /**
+   * Find the leaf page containing key holding write latches on every page the operation may change. The latched pages
+   * are pinned and appended to latched top down, root_latched tells whether root_latch_ is held as well. Returns
+   * nullptr, with root_latch_ held, if the tree is empty. Release with ReleaseLatches.
+   */
+  Page *FindLeafPagePessimistic(const GenericKey *key, Operation op, std::vector<Page *> &latched, bool &root_latched);
+
+  void ReleaseLatches(std::vector<Page *> &latched, bool &root_latched, bool is_dirty);
+
+  /** Delete the pages merged away by a removal, and the ones earlier removals could not delete yet. */
+  void DeletePages(const std::vector<page_id_t> &deleted);
+
+  /** @return true if op on a descendant of node can not change the parent of node */
+  bool IsSafe(const BPlusTreePage *node, Operation op) const;
+
   void StartNewTree(GenericKey *key, const RowId &value);
 
-  bool InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
+  bool InsertIntoLeaf(LeafPage *leaf_node, GenericKey *key, const RowId &value, Txn *transaction = nullptr);
+
+  /** Remove key from leaf_node, merging pages as needed. The pages left empty are appended to deleted. */
+  void RemoveFromLeaf(LeafPage *leaf_node, const GenericKey *key, std::vector<page_id_t> &deleted,
+                      Txn *transaction = nullptr);
 
   void InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlusTreePage *new_node, Txn *transaction = nullptr);
 
@@ -79,19 +133,22 @@ class BPlusTree {
   InternalPage *Split(InternalPage *node, Txn *transaction);
 
   template <typename N>
-  bool CoalesceOrRedistribute(N *&node, Txn *transaction = nullptr);
+  bool CoalesceOrRedistribute(N *&node, std::vector<page_id_t> &deleted, Txn *transaction = nullptr);
 
   bool Coalesce(InternalPage *&neighbor_node, InternalPage *&node, InternalPage *&parent, int index,
-                Txn *transaction = nullptr);
+                std::vector<page_id_t> &deleted, Txn *transaction = nullptr);
 
   bool Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage *&parent, int index,
-                Txn *transaction = nullptr);
+                std::vector<page_id_t> &deleted, Txn *transaction = nullptr);
 
   void Redistribute(LeafPage *neighbor_node, LeafPage *node, int index);
 
   void Redistribute(InternalPage *neighbor_node, InternalPage *node, int index);
 
-  bool AdjustRoot(BPlusTreePage *node);
+  bool AdjustRoot(BPlusTreePage *node, std::vector<page_id_t> &deleted);
+
+  /** Build the internal pages above children, whose first keys are child_keys, and return the root. */
+  page_id_t BulkLoadInternals(std::vector<page_id_t> children, std::vector<char> child_keys, double fill_factor);
 
   void UpdateRootPageId(int insert_record = 0);
 
@@ -102,7 +159,11 @@ class BPlusTree {
 
   // member variable
   index_id_t index_id_;
-  page_id_t root_page_id_{INVALID_PAGE_ID};
+  std::atomic<page_id_t> root_page_id_{INVALID_PAGE_ID};
+  ReaderWriterLatch root_latch_;
+  ScanGate scan_gate_;
+  std::mutex deleted_latch_;
+  std::vector<page_id_t> deleted_pages_;  // merged away, but still pinned by a thread leaving them when deleted
   BufferPoolManager *buffer_pool_manager_;
   KeyManager processor_;
   int leaf_max_size_;
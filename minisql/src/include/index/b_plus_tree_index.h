@@ -17,6 +17,9 @@ class BPlusTreeIndex : public Index {
 
   dberr_t Destroy() override;
 
+  /** Sort all the entries, spilling to disk if they do not fit in INDEX_SORT_MEMORY, and build the tree bottom up. */
+  dberr_t BulkLoad(const std::function<bool(Row *key, RowId *row_id)> &next, Txn *txn = nullptr) override;
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
@@ -0,0 +1,79 @@
+#ifndef MINISQL_EXTERNAL_SORTER_H
+#define MINISQL_EXTERNAL_SORTER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * ExternalSorter sorts fixed size records ordered by memcmp of their first key_size bytes, such as index keys (see
+ * KeyManager) followed by their row ids, with a bounded amount of memory.
+ *
+ * Added records collect in memory. Whenever memory_size bytes are full they are sorted and written out as a run to a
+ * temporary file. Sort then sorts the records still in memory, and if runs were written, merges all of them. Next
+ * returns the records in order. Records with equal keys come out in no particular order.
+ */
+class ExternalSorter {
+ public:
+  ExternalSorter(uint32_t record_size, uint32_t key_size, size_t memory_size = INDEX_SORT_MEMORY);
+
+  ~ExternalSorter();
+
+  DISALLOW_COPY(ExternalSorter);
+
+  /** Copy a record into the sorter. @return false if a run could not be written */
+  bool Add(const char *record);
+
+  /** Sort the added records, after which Add may not be called. @return false if a run could not be written */
+  bool Sort();
+
+  /** @return the next record in order, valid until the next call, nullptr once all were returned or on a read error */
+  const char *Next();
+
+  inline size_t GetCount() const { return count_; }
+
+  /** @return the number of runs written to temporary files, 0 if the records were sorted in memory */
+  inline size_t GetRunCount() const { return runs_.size(); }
+
+ private:
+  /** A record in memory, first by the first 8 bytes of its key read big endian, which order like the bytes. */
+  struct Entry {
+    uint64_t prefix_;
+    uint32_t offset_;
+  };
+
+  /** A run being merged, with the records of its file read so far. */
+  struct Run {
+    FILE *file_;
+    char *buffer_;
+    size_t buffered_;  // records in buffer_
+    size_t position_;  // next record of buffer_
+  };
+
+  void SortBuffer();
+
+  bool WriteRun();
+
+  /** @return the current record of the run, reading more of its file if needed, nullptr once it is exhausted */
+  const char *Current(Run &run);
+
+  bool Less(const char *lhs, const char *rhs) const;
+
+  uint32_t record_size_;
+  uint32_t key_size_;
+  size_t capacity_;  // records held in memory
+  size_t count_{0};
+  std::vector<char> buffer_;
+  std::vector<Entry> entries_;
+  std::vector<Run> runs_;
+  std::vector<size_t> heap_;  // runs by their current record, smallest on top
+  size_t run_capacity_{0};    // records a run reads from its file at once
+  size_t next_{0};            // next entry to return when no run was written
+  bool returned_{false};      // heap_.back() is the run of the record returned last, out of the heap
+  bool sorted_{false};
+};
+
+#endif  // MINISQL_EXTERNAL_SORTER_H
@@ -1,6 +1,7 @@
 #ifndef MINISQL_GENERIC_KEY_H
 #define MINISQL_GENERIC_KEY_H
 
+#include <algorithm>
 #include <cstring>
 
 #include "record/field.h"
@@ -11,68 +12,75 @@ class GenericKey {
   char data[0];
 };
 
+/**
+ * KeyManager encodes index keys so that their bytes sort in the order of the keys, and compares them with memcmp.
+ *
+ * Every column of the key schema takes a fixed number of bytes, in the order of the columns:
+ * - a marker byte, 0 for null and 1 otherwise, so that nulls sort first. The bytes of a null are all 0.
+ * - int: the value with its sign bit flipped, big endian.
+ * - float: the IEEE bits big endian, with the sign bit flipped for positive numbers and all bits flipped for negative
+ *   ones. -0 is stored as 0.
+ * - char(n): the characters padded with 0 to n bytes, then their length in 2 bytes big endian. The length breaks ties
+ *   between values that only differ by trailing 0 bytes, a shorter value sorts first as it does in TypeChar.
+ * The bytes past the encoded key up to the key size are 0.
+ *
+ * A key of at most 8 bytes, a single int or float column, also packs into an int64 that orders like the key, see
+ * PackKey. B+ tree pages of such keys keep them packed in a dense array as well, for KeySearch.
+ */
 class KeyManager {
  public: /**/
   [[nodiscard]] inline GenericKey *InitKey() const {
     return (GenericKey *)malloc(key_size_);  // remember delete
   }
 
-  inline void SerializeFromKey(GenericKey *key_buf, const Row &key, Schema *schema) const {
-    // initialize to 0
-    [[maybe_unused]] uint32_t size = key.GetSerializedSize(schema);
-    ASSERT(key.GetFieldCount() == schema->GetColumnCount(), "field nums not match.");
-    ASSERT(size <= (uint32_t)key_size_, "Index key size exceed max key size.");
-    memset(key_buf->data, 0, key_size_);
-    key.SerializeTo(key_buf->data, schema);
-  }
+  void SerializeFromKey(GenericKey *key_buf, const Row &key, Schema *schema) const;
 
-  inline void DeserializeToKey(const GenericKey *key_buf, Row &key, Schema *schema) const {
-    [[maybe_unused]] uint32_t ofs = key.DeserializeFrom(const_cast<char *>(key_buf->data), schema);
-    ASSERT(ofs <= (uint32_t)key_size_, "Index key size exceed max key size.");
-  }
+  void DeserializeToKey(const GenericKey *key_buf, Row &key, Schema *schema) const;
 
   // compare
   [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs) const {
-    //    ASSERT(malloc_usable_size((void *)&lhs) == malloc_usable_size((void *)&rhs), "key size not match.");
-    uint32_t column_count = key_schema_->GetColumnCount();
-    Row lhs_key(INVALID_ROWID);
-    Row rhs_key(INVALID_ROWID);
-    DeserializeToKey(lhs, lhs_key, key_schema_);
-    DeserializeToKey(rhs, rhs_key, key_schema_);
-
-    for (uint32_t i = 0; i < column_count; i++) {
-      Field *lhs_value = lhs_key.GetField(i);
-      Field *rhs_value = rhs_key.GetField(i);
-
-      if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
-        return -1;
-      }
-
-      if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue) {
-        return 1;
-      }
-    }
-    // equals
-    return 0;
+    int ret = memcmp(lhs->data, rhs->data, key_length_);
+    return (ret > 0) - (ret < 0);
   }
 
   inline int GetKeySize() const { return key_size_; }
 
+  /** @return true if the keys are short enough to be packed, see PackKey */
+  inline bool IsPackable() const { return key_length_ <= sizeof(int64_t); }
+
+  /**
+   * @return the first 8 bytes of a key of key_size bytes as a big endian number with the sign bit flipped. Two keys of
+   * a packable schema compare like their packed values.
+   */
+  static inline int64_t PackKey(const GenericKey *key, int key_size) {
+    uint64_t word = 0;
+    memcpy(&word, key->data, std::min<size_t>(key_size, sizeof(word)));
+    return static_cast<int64_t>(__builtin_bswap64(word) ^ (1ULL << 63));
+  }
+
+  /** @return the number of bytes a key of key_schema is encoded in */
+  static uint32_t GetEncodedSize(const Schema *key_schema);
+
   KeyManager(const KeyManager &other) {
     this->key_schema_ = other.key_schema_;
     this->key_size_ = other.key_size_;
+    this->key_length_ = other.key_length_;
   }
 
   // constructor
-  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {}
+  KeyManager(Schema *key_schema, size_t key_size)
+      : key_size_(key_size), key_schema_(key_schema), key_length_(GetEncodedSize(key_schema)) {
+    ASSERT(key_length_ <= key_size, "Index key size exceed max key size.");
+  }
 
   Schema *GetSchema() {
       return key_schema_;
   } // For graphic
-  
+
  private:
   int key_size_;
   Schema *key_schema_;
+  uint32_t key_length_;  // bytes of an encoded key, the part compared
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
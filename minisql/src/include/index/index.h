@@ -1,6 +1,7 @@
 #ifndef MINISQL_INDEX_H
 #define MINISQL_INDEX_H
 
+#include <functional>
 #include <memory>
 
 #include "common/dberr.h"
@@ -21,6 +22,22 @@ class Index {
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Insert every key & row id next hands out until it returns false, for building an index over an existing table.
+   * Indexes which can do better than one insert per entry override this.
+   */
+  virtual dberr_t BulkLoad(const std::function<bool(Row *key, RowId *row_id)> &next, Txn *txn = nullptr) {
+    Row key;
+    RowId row_id;
+    while (next(&key, &row_id)) {
+      dberr_t result = InsertEntry(key, row_id, txn);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+    }
+    return DB_SUCCESS;
+  }
+
  protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
@@ -1,8 +1,36 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 #include "page/b_plus_tree_leaf_page.h"
 
+/**
+ * Keeps the scans of a B+ tree apart from the removals that free its pages. Any number of scans, or any number of
+ * merging removals, may run at a time, but not both. A scan waits for the running merges to end and a merge for every
+ * scan. Scans do not start while a merge waits, unless their thread already runs a scan of the same tree, which could
+ * not end before the new one started.
+ */
+class ScanGate {
+ public:
+  void EnterScan();
+
+  void ExitScan();
+
+  void EnterMerge();
+
+  void ExitMerge();
+
+ private:
+  std::mutex latch_;
+  std::condition_variable cv_;
+  int scans_{0};
+  int merges_{0};
+  int waiting_merges_{0};
+};
+
 class IndexIterator {
   using LeafPage = BPlusTreeLeafPage;
 
@@ -10,7 +38,21 @@ class IndexIterator {
   // you may define your own constructor based on your member variables
   explicit IndexIterator();
 
-  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0);
+  /**
+   * Iterate from the first key of the leaf page_id that is not less than key, or from its first key if key is null.
+   * gate, if given, has been entered for the scan and is exited when the iterator goes away.
+   *
+   * The iterator keeps a copy of its current key and looks for it again when the leaf changed in between, so inserts
+   * and removes running alongside the scan neither make it skip nor repeat keys.
+   */
+  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, const KeyManager *processor,
+                         const GenericKey *key = nullptr, ScanGate *gate = nullptr);
+
+  IndexIterator(IndexIterator &&other) noexcept;
+
+  IndexIterator(const IndexIterator &) = delete;
+
+  IndexIterator &operator=(const IndexIterator &) = delete;
 
   ~IndexIterator();
 
@@ -27,11 +69,24 @@ class IndexIterator {
   bool operator!=(const IndexIterator &itr) const;
 
  private:
+  /** @return true if the item index of the latched leaf holds the current key */
+  bool IsAtKey();
+
+  /**
+   * Move to the first key that is not less than (greater than, if after) the current key, or to the first key if
+   * from_start, following the leaf links. Becomes the end iterator if there is none.
+   */
+  void Seek(bool from_start, bool after);
+
   page_id_t current_page_id{INVALID_PAGE_ID};
   LeafPage *page{nullptr};
   int item_index{0};
   BufferPoolManager *buffer_pool_manager{nullptr};
   // add your own private member variables here
+  Page *current_page{nullptr};  // frame of page, latched for every step
+  ScanGate *gate_{nullptr};
+  const KeyManager *processor_{nullptr};
+  std::unique_ptr<char[]> key_;  // copy of the current key
 };
 
 #endif  // MINISQL_INDEX_ITERATOR_H
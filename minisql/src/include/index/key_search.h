@@ -0,0 +1,31 @@
+#ifndef MINISQL_KEY_SEARCH_H
+#define MINISQL_KEY_SEARCH_H
+
+#include <cstdint>
+
+/**
+ * KeySearch searches the packed keys of a B+ tree page, see KeyManager::PackKey.
+ *
+ * The keys are a dense sorted array of int64. A branchless binary search narrows the range down to a window of two cache lines,
+ * which is then scanned with AVX2 or SSE4.2 compares if the CPU has them: counting the keys of the window smaller than
+ * the searched one gives its position without a branch per key. Which instruction set is used is decided once, when
+ * the program starts. Other CPUs scan the window with plain compares.
+ */
+class KeySearch {
+ public:
+  /** Keys left for the vector scan once the binary search stops, two cache lines. */
+  static constexpr int WINDOW_SIZE = 16;
+
+  /**
+   * @return the index of the first of the n sorted keys that is not smaller than key, n if there is none
+   */
+  static int LowerBound(const int64_t *keys, int n, int64_t key);
+
+  /** LowerBound with a plain binary search, for comparison. */
+  static int LowerBoundScalar(const int64_t *keys, int n, int64_t key);
+
+  /** @return the instruction set used to scan the window: "avx2", "sse4.2" or "scalar" */
+  static const char *GetInstructionSet();
+};
+
+#endif  // MINISQL_KEY_SEARCH_H
@@ -8,7 +8,7 @@
 #include "index/generic_key.h"
 #include "page/b_plus_tree_page.h"
 
-#define INTERNAL_PAGE_HEADER_SIZE 28
+#define INTERNAL_PAGE_HEADER_SIZE 32
 /**
  * Store n indexed keys and n+1 child pointers (page_id) within internal page.
  * Pointer PAGE_ID(i) points to a subtree in which all keys K satisfy:
@@ -21,12 +21,13 @@
  *  --------------------------------------------------------------------------
  * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
  *  --------------------------------------------------------------------------
+ * With packed keys the page also ends with their array, see BPlusTreePage.
  */
 class BPlusTreeInternalPage : public BPlusTreePage {
  public:
   // must call initialize method after "create" a new node
   void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int key_size = UNDEFINED_SIZE,
-            int max_size = UNDEFINED_SIZE);
+            int max_size = UNDEFINED_SIZE, bool packed_keys = false);
 
   GenericKey *KeyAt(int index);
 
@@ -70,7 +71,9 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   void CopyFirstFrom(page_id_t value, BufferPoolManager *buffer_pool_manager);
 
-  char data_[PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE];
+  void PackKeys(int begin, int end);
+
+  char data_[PAGE_SIZE - PAGE_CHECKSUM_SIZE - INTERNAL_PAGE_HEADER_SIZE];
 };
 
 using InternalPage = BPlusTreeInternalPage;
@@ -13,13 +13,12 @@
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 24 bytes in total):
+ *  Header format (size in byte, 36 bytes in total):
  *  ---------------------------------------------------------------------
- * | PageType (4) | CurrentSize (4) | MaxSize (4) | ParentPageId (4) |
+ * | BPlusTreePage header (32) | NextPageId (4)
  *  ---------------------------------------------------------------------
- *  ------------------------------
- * | PageId (4) | NextPageId (4)
- *  ------------------------------
+ *
+ *  With packed keys the page also ends with their array, see BPlusTreePage.
  */
 #include <utility>
 #include <vector>
@@ -27,14 +26,14 @@
 #include "index/generic_key.h"
 #include "page/b_plus_tree_page.h"
 
-#define LEAF_PAGE_HEADER_SIZE 32
+#define LEAF_PAGE_HEADER_SIZE 36
 
 class BPlusTreeLeafPage : public BPlusTreePage {
  public:
   // After creating a new leaf page from buffer pool, must call initialize
   // method to set default values
   void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int key_size = UNDEFINED_SIZE,
-            int max_size = UNDEFINED_SIZE);
+            int max_size = UNDEFINED_SIZE, bool packed_keys = false);
 
   // helper methods
   page_id_t GetNextPageId() const;
@@ -80,9 +79,11 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
   void CopyFirstFrom(GenericKey *key, const RowId value);
 
+  void PackKeys(int begin, int end);
+
   page_id_t next_page_id_{INVALID_PAGE_ID};
 
-  char data_[PAGE_SIZE - LEAF_PAGE_HEADER_SIZE];
+  char data_[PAGE_SIZE - PAGE_CHECKSUM_SIZE - LEAF_PAGE_HEADER_SIZE];
 };
 
 using LeafPage = BPlusTreeLeafPage;
@@ -19,12 +19,16 @@ enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
  * contains information shared by both leaf page and internal page.
  * 
  *
- * Header format (size in byte, 28 bytes in total):
+ * Header format (size in byte, 32 bytes in total):
  * ----------------------------------------------------------------------------
  * | PageType (4) | KeySize (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  * ----------------------------------------------------------------------------
- * | ParentPageId (4) | PageId(4) |
+ * | ParentPageId (4) | PageId(4) | PackedKeys (4) |
  * ----------------------------------------------------------------------------
+ *
+ * A page with packed keys keeps, next to its key & value pairs, every key packed into an int64 (see
+ * KeyManager::PackKey) in a dense array at the end of the page, aligned to a cache line. Searches then run on that
+ * array with KeySearch instead of comparing keys one by one.
  */
 class BPlusTreePage {
  public:
@@ -60,6 +64,22 @@ class BPlusTreePage {
 
   void SetLSN(lsn_t lsn = INVALID_LSN);
 
+  bool HasPackedKeys() const;
+
+  void SetPackedKeys(bool packed_keys);
+
+  /**
+   * @return the number of key & value pairs of pair_size bytes a page with header_size bytes of header holds, leaving
+   * room for the packed keys if there are any
+   */
+  static int GetCapacity(int header_size, int pair_size, bool packed_keys);
+
+ protected:
+  /** @return the packed keys, at the end of the page */
+  int64_t *PackedKeys();
+
+  const int64_t *PackedKeys() const;
+
  private:
   // member variable, attributes that both internal and leaf page share
   [[maybe_unused]] IndexPageType page_type_; // Denote whether the node is a internal node or a leaf node.
@@ -69,6 +89,7 @@ class BPlusTreePage {
   [[maybe_unused]] int max_size_; // The maximum number of Key-Value pairs that can be hold in the current node.
   [[maybe_unused]] page_id_t parent_page_id_;
   [[maybe_unused]] page_id_t page_id_;
+  [[maybe_unused]] int packed_keys_; // Whether the keys are also stored packed, see PackedKeys().
 };
 
 #endif  // MINISQL_B_PLUS_TREE_PAGE_H
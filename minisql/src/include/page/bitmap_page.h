@@ -30,6 +30,11 @@ class BitmapPage {
    */
   bool IsPageFree(uint32_t page_offset) const;
 
+  /**
+   * @return the number of allocated pages, counted from the bits rather than taken from the header
+   */
+  uint32_t CountAllocatedPages() const;
+
  private:
   /**
    * check a bit(byte_index, bit_index) in bytes is free(value 0).
@@ -40,13 +45,25 @@ class BitmapPage {
    */
   bool IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const;
 
+  /**
+   * Bit i of word w is page 64 * w + i, whatever the byte order.
+   */
+  uint64_t LoadWord(size_t word_index) const;
+
+  /**
+   * @return the first free page at or after page_offset, or GetMaxSupportedSize() if there is none
+   */
+  uint32_t FindFreePage(uint32_t page_offset) const;
+
   /** Note: need to update if modify page structure. */
   static constexpr size_t MAX_CHARS = PageSize - 2 * sizeof(uint32_t);
+  static constexpr size_t MAX_WORDS = MAX_CHARS / sizeof(uint64_t);
+  static_assert(MAX_CHARS % sizeof(uint64_t) == 0, "bitmap is scanned a word at a time");
 
  private:
   /** The space occupied by all members of the class should be equal to the PageSize */
   [[maybe_unused]] uint32_t page_allocated_; // the numbers of allocated pages
-  [[maybe_unused]] uint32_t next_free_page_;
+  [[maybe_unused]] uint32_t next_free_page_;  // lowest free page, or GetMaxSupportedSize() if the extent is full
   [[maybe_unused]] unsigned char bytes[MAX_CHARS]; // 8 bits every char-type
 };
 
@@ -2,10 +2,11 @@
 #define MINISQL_DISK_FILE_META_PAGE_H
 
 #include <cstdint>
+#include <cstring>
 
 #include "page/bitmap_page.h"
 
-static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 8) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 12) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
 
 class DiskFileMetaPage {
  public:
@@ -20,6 +21,34 @@ class DiskFileMetaPage {
     return extent_used_page_[extent_id];
   }
 
+  /**
+   * Whether the logical pages of the file keep their last PAGE_CHECKSUM_SIZE bytes as the checksum trailer. Files
+   * created before the trailer existed store page data there.
+   */
+  bool HasPageTrailer() { return GetFormat() == FORMAT_PAGE_TRAILER || HadChecksums(); }
+
+  void SetPageTrailer() { SetFormat(FORMAT_PAGE_TRAILER); }
+
+  /** Whether checksums were ever enabled on the file, its pages may then hold a checksum in their trailer. */
+  bool HadChecksums() { return GetFormat() == FORMAT_CHECKSUMS; }
+
+  void SetHadChecksums() { SetFormat(FORMAT_CHECKSUMS); }
+
+  // The format word is the last word of the page, where older files kept the used page count of their last extent.
+  // The markers are larger than any page count, so they are never mistaken for one.
+  static constexpr size_t OFFSET_FORMAT = PAGE_SIZE - sizeof(uint32_t);
+  static constexpr uint32_t FORMAT_PAGE_TRAILER = 0x52545243;
+  static constexpr uint32_t FORMAT_CHECKSUMS = 0x4D534B43;
+
+ private:
+  uint32_t GetFormat() {
+    uint32_t format;
+    memcpy(&format, reinterpret_cast<char *>(this) + OFFSET_FORMAT, sizeof(format));
+    return format;
+  }
+
+  void SetFormat(uint32_t format) { memcpy(reinterpret_cast<char *>(this) + OFFSET_FORMAT, &format, sizeof(format)); }
+
  public:
   uint32_t num_allocated_pages_{0};
   uint32_t num_extents_{0};  // each extent consists with a bit map and BIT_MAP_SIZE pages
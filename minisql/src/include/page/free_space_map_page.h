@@ -0,0 +1,72 @@
+#ifndef MINISQL_FREE_SPACE_MAP_PAGE_H
+#define MINISQL_FREE_SPACE_MAP_PAGE_H
+
+#include <cstring>
+
+#include "page/page.h"
+
+/**
+ * A page of the free space map of a table heap. It records, for a run of the pages of the heap, how much free space
+ * each of them has, rounded down to a category. The pages of the map are chained in the order the heap pages were
+ * added to the map.
+ *
+ *  Format (size in bytes):
+ *  ----------------------------------------------------------------------------------------------------------------
+ *  | NextPageId (4) | EntryCount (4) | HeapPageId_1 (4) | ... | HeapPageId_n (4) | Category_1 (1) | ... | CHECKSUM |
+ *  ----------------------------------------------------------------------------------------------------------------
+ */
+class FreeSpaceMapPage : public Page {
+ public:
+  /** Number of heap pages one map page can record. */
+  static constexpr uint32_t MAX_ENTRIES =
+      (PAGE_SIZE - PAGE_CHECKSUM_SIZE - 2 * sizeof(uint32_t)) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+  void Init() {
+    SetNextPageId(INVALID_PAGE_ID);
+    SetEntryCount(0);
+  }
+
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  uint32_t GetEntryCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_ENTRY_COUNT); }
+
+  void SetEntryCount(uint32_t entry_count) { memcpy(GetData() + OFFSET_ENTRY_COUNT, &entry_count, sizeof(uint32_t)); }
+
+  page_id_t GetHeapPageId(uint32_t index) {
+    return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * index);
+  }
+
+  uint8_t GetCategory(uint32_t index) { return *reinterpret_cast<uint8_t *>(GetData() + OFFSET_CATEGORIES + index); }
+
+  void SetCategory(uint32_t index, uint8_t category) {
+    *reinterpret_cast<uint8_t *>(GetData() + OFFSET_CATEGORIES + index) = category;
+  }
+
+  /**
+   * Append an entry for a heap page.
+   * @return false if the page is full
+   */
+  bool AppendEntry(page_id_t heap_page_id, uint8_t category) {
+    uint32_t index = GetEntryCount();
+    if (index == MAX_ENTRIES) {
+      return false;
+    }
+    memcpy(GetData() + OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * index, &heap_page_id, sizeof(page_id_t));
+    SetCategory(index, category);
+    SetEntryCount(index + 1);
+    return true;
+  }
+
+ private:
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 0;
+  static constexpr size_t OFFSET_ENTRY_COUNT = 4;
+  static constexpr size_t OFFSET_HEAP_PAGE_IDS = 8;
+  static constexpr size_t OFFSET_CATEGORIES = OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * MAX_ENTRIES;
+  static_assert(OFFSET_CATEGORIES + MAX_ENTRIES <= PAGE_SIZE - PAGE_CHECKSUM_SIZE);
+};
+
+#endif  // MINISQL_FREE_SPACE_MAP_PAGE_H
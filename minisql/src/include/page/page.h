@@ -1,6 +1,7 @@
 #ifndef MINISQL_PAGE_H
 #define MINISQL_PAGE_H
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
 #include <shared_mutex>
@@ -20,23 +21,29 @@ class Page {
  public:
   DISALLOW_COPY(Page)
 
-  /** Constructor. Zeros out the page data. */
-  Page() { ResetMemory(); }
+  /** Constructor. Allocates the page data and zeros it out. */
+  Page() : data_(new char[PAGE_SIZE]), owns_data_(true) { ResetMemory(); }
 
-  /** Default destructor. */
-  ~Page() = default;
+  /** Wrap page data owned by someone else, e.g. a page of a memory-mapped file. */
+  explicit Page(char *data) : data_(data), owns_data_(false) {}
+
+  ~Page() {
+    if (owns_data_) {
+      delete[] data_;
+    }
+  }
 
   /** @return the actual data contained within this page */
   inline char *GetData() { return data_; }
 
   /** @return the page id of this page */
-  inline page_id_t GetPageId() { return page_id_; }
+  inline page_id_t GetPageId() { return page_id_.load(std::memory_order_acquire); }
 
   /** @return the pin count of this page */
-  inline int GetPinCount() { return pin_count_; }
+  inline int GetPinCount() { return pin_count_.load(std::memory_order_acquire); }
 
   /** @return true if the page in memory has been modified from the page on disk, false otherwise */
-  inline bool IsDirty() { return is_dirty_; }
+  inline bool IsDirty() { return is_dirty_.load(std::memory_order_acquire); }
 
   /** Acquire the page write latch. */
   inline void WLatch() { rwlatch_.WLock(); }
@@ -56,6 +63,16 @@ class Page {
   /** Sets the page LSN. */
   inline void SetLSN(lsn_t lsn) { memcpy(GetData() + OFFSET_LSN, &lsn, sizeof(lsn_t)); }
 
+  /**
+   * @return the checksum the disk manager stored in the page trailer when it last wrote the page, 0 if it was written
+   * without one. The header layouts of table and index pages differ, the trailer is at the same offset in both.
+   */
+  inline uint32_t GetChecksum() {
+    uint32_t checksum;
+    memcpy(&checksum, GetData() + OFFSET_CHECKSUM, sizeof(checksum));
+    return checksum;
+  }
+
  protected:
   static_assert(sizeof(page_id_t) == 4);
   static_assert(sizeof(lsn_t) == 4);
@@ -63,19 +80,22 @@ class Page {
   static constexpr size_t SIZE_PAGE_HEADER = 8;
   static constexpr size_t OFFSET_PAGE_START = 0;
   static constexpr size_t OFFSET_LSN = 4;
+  static constexpr size_t OFFSET_CHECKSUM = PAGE_SIZE - PAGE_CHECKSUM_SIZE;
 
  private:
   /** Zeroes out the data that is held within the page. */
   inline void ResetMemory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }
 
   /** The actual data that is stored within a page. */
-  char data_[PAGE_SIZE]{};
-  /** The ID of this page. */
-  page_id_t page_id_ = INVALID_PAGE_ID;
-  /** The pin count of this page. */
-  int pin_count_ = 0;
+  char *data_;
+  /** False if data_ is borrowed. */
+  bool owns_data_;
+  /** The ID of this page. Read without the buffer pool latch to validate optimistic lookups. */
+  std::atomic<page_id_t> page_id_{INVALID_PAGE_ID};
+  /** The pin count of this page, negative while the buffer pool is (re)loading the frame. */
+  std::atomic<int> pin_count_{0};
   /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
-  bool is_dirty_ = false;
+  std::atomic<bool> is_dirty_{false};
   /** Page latch. */
   ReaderWriterLatch rwlatch_;
 };
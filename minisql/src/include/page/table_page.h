@@ -2,9 +2,9 @@
 #define MINISQL_TUPLE_H
 /**
  * Basic Slotted page format:
- *  ---------------------------------------------------------
- *  | HEADER | ... FREE SPACE ... | ... INSERTED TUPLES ... |
- *  ---------------------------------------------------------
+ *  --------------------------------------------------------------------
+ *  | HEADER | ... FREE SPACE ... | ... INSERTED TUPLES ... | CHECKSUM |
+ *  --------------------------------------------------------------------
  *                                ^
  *                                free space pointer
  *
@@ -25,6 +25,7 @@
 #include "concurrency/txn.h"
 #include "page/page.h"
 #include "record/row.h"
+#include "record/row_view.h"
 #include "recovery/log_manager.h"
 
 class TablePage : public Page {
@@ -58,10 +59,24 @@ class TablePage : public Page {
 
   bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
 
+  /**
+   * Point view at the tuple in a slot, nothing is copied. The view is valid as long as the page stays pinned and latched.
+   * @return false if the slot holds no tuple
+   */
+  bool GetTupleView(uint32_t slot_num, RowView *view);
+
   bool GetFirstTupleRid(RowId *first_rid);
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
 
+  /** @return the number of slots, deleted tuples included */
+  uint32_t GetTupleCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_COUNT); }
+
+  /** @return the bytes left for new tuples, a tuple of size n needs n + SIZE_TUPLE of them */
+  uint32_t GetFreeSpaceRemaining() {
+    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
+  }
+
  private:
   uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
@@ -69,14 +84,8 @@ class TablePage : public Page {
     memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
   }
 
-  uint32_t GetTupleCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_COUNT); }
-
   void SetTupleCount(uint32_t tuple_count) { memcpy(GetData() + OFFSET_TUPLE_COUNT, &tuple_count, sizeof(uint32_t)); }
 
-  uint32_t GetFreeSpaceRemaining() {
-    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
-  }
-
   uint32_t GetTupleOffsetAtSlot(uint32_t slot_num) {
     return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_OFFSET + SIZE_TUPLE * slot_num);
   }
@@ -103,7 +112,6 @@ class TablePage : public Page {
   static_assert(sizeof(page_id_t) == 4);
   static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
   static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
-  static constexpr size_t SIZE_TUPLE = 8;
   static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
   static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
   static constexpr size_t OFFSET_FREE_SPACE = 16;
@@ -112,7 +120,8 @@ class TablePage : public Page {
   static constexpr size_t OFFSET_TUPLE_SIZE = 28;
 
  public:
-  static constexpr size_t SIZE_MAX_ROW = PAGE_SIZE - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE;
+  static constexpr size_t SIZE_TUPLE = 8;
+  static constexpr size_t SIZE_MAX_ROW = PAGE_SIZE - PAGE_CHECKSUM_SIZE - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE;
 };
 
 #endif
\ No newline at end of file
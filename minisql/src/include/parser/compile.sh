@@ -1,3 +1,4 @@
 lex --header-file=./minisql_lex.h --outfile=../../parser/minisql_lex.c minisql.l \
 && yacc -d -o ./minisql_yacc.c minisql.y \
+&& sed -i 's|#include "minisql_yacc.h"|#include "parser/minisql_yacc.h"|' minisql_yacc.c \
 && mv minisql_yacc.c ../../parser/minisql_yacc.c
\ No newline at end of file
@@ -1,5 +1,6 @@
 %{
   #include <stdio.h>
+  #include <strings.h>
   #include "parser/parser.h"
 
   extern char *yytext;
@@ -26,8 +27,8 @@
 %type <syntax_node> sql_trx_begin sql_trx_commit sql_trx_rollback
 %type <syntax_node> sql_select select_columns column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
-%type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_insert insert_rows insert_row sql_delete sql_update update_values update_value
+%type <syntax_node> sql_quit sql_exec_file sql_copy copy_format
 
 %%
 
@@ -58,6 +59,7 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_copy { $$ = $1; }
   ;
 
 sql_create_database:
@@ -289,12 +291,28 @@ operator:
   ;
 
 sql_insert:
-  INSERT INTO IDENTIFIER VALUES '(' column_values ')' {
+  INSERT INTO IDENTIFIER VALUES insert_rows {
     $$ = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren($$, $3);
-    pSyntaxNode col_val_node = CreateSyntaxNode(kNodeColumnValues, NULL);
-    SyntaxNodeAddChildren(col_val_node, $6);
-    SyntaxNodeAddChildren($$, col_val_node);
+    SyntaxNodeAddSibling($3, SyntaxNodeReverseSiblings($5));
+  }
+  ;
+
+insert_rows:
+  insert_rows ',' insert_row {
+    /* left recursive, so that the parser stack does not grow with the rows; they are linked last first */
+    $$ = $3;
+    $$->next_ = $1;
+  }
+  | insert_row {
+    $$ = $1;
+  }
+  ;
+
+insert_row:
+  '(' column_values ')' {
+    $$ = CreateSyntaxNode(kNodeColumnValues, NULL);
+    SyntaxNodeAddChildren($$, $2);
   }
   ;
 
@@ -393,6 +411,43 @@ sql_exec_file:
   }
   ;
 
+/* "copy", "load", "data", "infile" and the formats are not reserved words, they are matched as identifiers */
+sql_copy:
+  IDENTIFIER IDENTIFIER FROM STRING copy_format {
+    if (strcasecmp($1->val_, "copy") != 0) {
+      yyerror("syntax error");
+      YYERROR;
+    }
+    $$ = CreateSyntaxNode(kNodeCopy, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddChildren($$, $4);
+    SyntaxNodeAddChildren($$, $5);
+  }
+  | IDENTIFIER IDENTIFIER IDENTIFIER STRING INTO TABLE IDENTIFIER copy_format {
+    if (strcasecmp($1->val_, "load") != 0 || strcasecmp($2->val_, "data") != 0 || strcasecmp($3->val_, "infile") != 0) {
+      yyerror("syntax error");
+      YYERROR;
+    }
+    $$ = CreateSyntaxNode(kNodeCopy, NULL);
+    SyntaxNodeAddChildren($$, $7);
+    SyntaxNodeAddChildren($$, $4);
+    SyntaxNodeAddChildren($$, $8);
+  }
+  ;
+
+copy_format:
+  IDENTIFIER {
+    if (strcasecmp($1->val_, "csv") != 0 && strcasecmp($1->val_, "binary") != 0) {
+      yyerror("unknown file format, expected csv or binary");
+      YYERROR;
+    }
+    $$ = $1;
+  }
+  | %empty {
+    $$ = NULL;
+  }
+  ;
+
 %%
 int yyerror(char* error) {
 	MinisqlParserSetError(error);
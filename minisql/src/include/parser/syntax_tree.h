@@ -43,7 +43,8 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin recovery command */
   kNodeTrxCommit,            /** commit recovery command */
-  kNodeTrxRollback           /** rollback recovery command */
+  kNodeTrxRollback,          /** rollback recovery command */
+  kNodeCopy                  /** copy table from file, or load data infile into table */
 } SyntaxNodeType;
 
 /**
@@ -76,6 +77,12 @@ void SyntaxNodeAddChildren(pSyntaxNode parent, pSyntaxNode child);
 
 void SyntaxNodeAddSibling(pSyntaxNode node, pSyntaxNode sib);
 
+/**
+ * Reverse the list of siblings starting at node
+ * @return the new first node of the list
+ */
+pSyntaxNode SyntaxNodeReverseSiblings(pSyntaxNode node);
+
 const char *GetSyntaxNodeTypeStr(SyntaxNodeType type);
 
 /**
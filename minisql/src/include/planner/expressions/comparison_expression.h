@@ -8,25 +8,57 @@
 #include <utility>
 
 #include "abstract_expression.h"
+#include "column_value_expression.h"
+#include "constant_value_expression.h"
+#include "record/field_compare.h"
 #include "record/schema.h"
 
 /**
  * ComparisonExpression represents two expressions being compared.
+ *
+ * When both sides have the same type the comparison kernel for that type and operator is bound once, at construction,
+ * see FieldCompare. A column compared with a constant, the shape the planner builds for every condition, is compared
+ * straight from the row without evaluating the two sides into fields first.
  */
 class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
   ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, string comp_type)
       : AbstractExpression({std::move(left), std::move(right)}, TypeId::kTypeInt, ExpressionType::ComparisonExpression),
-        comp_type_{std::move(comp_type)} {}
+        comp_type_{std::move(comp_type)} {
+    CompareOp op;
+    TypeId type = GetChildAt(0)->GetReturnType();
+    if (!FieldCompare::GetCompareOp(comp_type_, &op) || type != GetChildAt(1)->GetReturnType()) {
+      return;
+    }
+    kernel_ = FieldCompare::GetKernel(type, op);
+    if (kernel_ != nullptr && GetChildAt(0)->GetType() == ExpressionType::ColumnExpression &&
+        GetChildAt(1)->GetType() == ExpressionType::ConstantExpression) {
+      column_kernel_ = FieldCompare::GetColumnKernel(type, op);
+      column_idx_ = dynamic_cast<ColumnValueExpression *>(GetChildAt(0).get())->GetColIdx();
+      constant_ = &dynamic_cast<ConstantValueExpression *>(GetChildAt(1).get())->val_;
+    }
+  }
 
   /** e.g. evaluate the result of id = 1 */
   Field Evaluate(const Row *row) const override {
+    if (column_kernel_ != nullptr) {
+      return Field(kTypeInt, kernel_(*row->GetField(column_idx_), *constant_));
+    }
     Field lhs = GetChildAt(0)->Evaluate(row);
     Field rhs = GetChildAt(1)->Evaluate(row);
     return Field(kTypeInt, PerformComparison(lhs, rhs));
   }
 
+  Field Evaluate(const RowView &view) const override {
+    if (column_kernel_ != nullptr) {
+      return Field(kTypeInt, column_kernel_(view, column_idx_, *constant_));
+    }
+    Field lhs = GetChildAt(0)->Evaluate(view);
+    Field rhs = GetChildAt(1)->Evaluate(view);
+    return Field(kTypeInt, PerformComparison(lhs, rhs));
+  }
+
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override {
     Field lhs = GetChildAt(0)->EvaluateJoin(left_row, right_row);
     Field rhs = GetChildAt(1)->EvaluateJoin(left_row, right_row);
@@ -37,6 +69,8 @@ class ComparisonExpression : public AbstractExpression {
 
  private:
   CmpBool PerformComparison(const Field &lhs, const Field &rhs) const {
+    if (kernel_ != nullptr)
+      return kernel_(lhs, rhs);
     if (comp_type_ == "=")
       return lhs.CompareEquals(rhs);
     else if (comp_type_ == "<>")
@@ -58,6 +92,10 @@ class ComparisonExpression : public AbstractExpression {
   }
 
   std::string comp_type_;
+  FieldCompare::Kernel kernel_{nullptr};               // bound if both sides have the same type
+  FieldCompare::ColumnKernel column_kernel_{nullptr};  // bound if a column is compared with a constant
+  uint32_t column_idx_{0};
+  const Field *constant_{nullptr};
 };
 
 #endif  // MINISQL_COMPARISON_EXPRESSION_H
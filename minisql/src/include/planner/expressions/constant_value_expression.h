@@ -18,6 +18,14 @@ class ConstantValueExpression : public AbstractExpression {
 
   Field Evaluate(const Row *row) const override { return Field(val_); }
 
+  /** The constant is not copied, a char constant is handed out without its own copy of the characters. */
+  Field Evaluate([[maybe_unused]] const RowView &view) const override {
+    if (val_.GetTypeId() == kTypeChar && !val_.IsNull()) {
+      return Field(kTypeChar, const_cast<char *>(val_.GetData()), val_.GetLength(), false);
+    }
+    return Field(val_);
+  }
+
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override { return Field(val_); }
 
   const Field val_;
@@ -6,6 +6,7 @@
 #define MINISQL_LOGIC_EXPRESSION_H
 
 #include "abstract_expression.h"
+#include "record/field_compare.h"
 
 /** ArithmeticType represents the type of logic operation that we want to perform. */
 enum class LogicType { And, Or };
@@ -31,6 +32,12 @@ class LogicExpression : public AbstractExpression {
     return Field(kTypeInt, PerformComputation(lhs, rhs));
   }
 
+  Field Evaluate(const RowView &view) const override {
+    Field lhs = GetChildAt(0)->Evaluate(view);
+    Field rhs = GetChildAt(1)->Evaluate(view);
+    return Field(kTypeInt, PerformComputation(lhs, rhs));
+  }
+
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override {
     Field lhs = GetChildAt(0)->EvaluateJoin(left_row, right_row);
     Field rhs = GetChildAt(1)->EvaluateJoin(left_row, right_row);
@@ -53,7 +60,7 @@ class LogicExpression : public AbstractExpression {
     if (val.IsNull()) {
       return CmpBool::kNull;
     }
-    if (val.CompareEquals(Field(kTypeInt, 1))) {
+    if (FieldCompare::Compare<kTypeInt, CompareOp::kEquals>(val, Field(kTypeInt, 1)) == CmpBool::kTrue) {
       return CmpBool::kTrue;
     }
     return CmpBool::kFalse;
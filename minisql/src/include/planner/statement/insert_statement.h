@@ -14,27 +14,27 @@ class InsertStatement : public AbstractStatement {
 
   /** Transfer syntax tree to statement. */
   void SyntaxTree2Statement(pSyntaxNode ast) {
-    if (!ast)
-      return;
-    switch (ast->type_) {
-      case kNodeIdentifier: {
-        TableInfo *info = nullptr;
-        if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
-          std::stringstream error_info;
-          error_info << "the table " << ast->val_ << " is not exist.";
-          throw std::logic_error(error_info.str());
+    // The rows of a long insert are a long list of siblings, walk it without recursion.
+    for (; ast != nullptr; ast = ast->next_) {
+      switch (ast->type_) {
+        case kNodeIdentifier: {
+          TableInfo *info = nullptr;
+          if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
+            std::stringstream error_info;
+            error_info << "the table " << ast->val_ << " is not exist.";
+            throw std::logic_error(error_info.str());
+          }
+          table_name_ = ast->val_;
+          break;
         }
-        table_name_ = ast->val_;
-        break;
-      }
-      case kNodeColumnValues: {
-        MakeInsertValues(ast->child_);
-        break;
+        case kNodeColumnValues: {
+          MakeInsertValues(ast->child_);
+          break;
+        }
+        default:
+          throw std::logic_error("the ast_type is not supported in planner yet");
       }
-      default:
-        throw std::logic_error("the ast_type is not supported in planner yet");
     }
-    SyntaxTree2Statement(ast->next_);
   };
 
   void MakeInsertValues(pSyntaxNode ast) {
@@ -0,0 +1,134 @@
+#ifndef MINISQL_FIELD_COMPARE_H
+#define MINISQL_FIELD_COMPARE_H
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "record/field.h"
+#include "record/row_view.h"
+#include "record/types.h"
+
+/** The comparison operators of a predicate. */
+enum class CompareOp { kEquals = 0, kNotEquals, kLessThan, kLessThanEquals, kGreaterThan, kGreaterThanEquals };
+
+/**
+ * FieldCompare holds comparison kernels specialized on the type of the fields and on the operator.
+ *
+ * Field::CompareEquals and its siblings look up the Type singleton and make a virtual call every time they are used.
+ * The kernels here are plain functions with the type and the operator fixed at compile time: a caller that knows both
+ * up front, such as a predicate or an index over a given key schema, looks its kernel up once and calls it directly
+ * for every row. The results are the same as those of the Field methods, a comparison with a null gives kNull.
+ */
+class FieldCompare {
+ public:
+  /** Compares two fields of the same type. */
+  using Kernel = CmpBool (*)(const Field &left, const Field &right);
+
+  /** Compares a column of a row in place with a field of the column's type. */
+  using ColumnKernel = CmpBool (*)(const RowView &view, uint32_t idx, const Field &right);
+
+  /** Orders two fields of the same type, see Order. */
+  using OrderKernel = int (*)(const Field &left, const Field &right);
+
+  template <TypeId kType, CompareOp kOp>
+  static CmpBool Compare(const Field &left, const Field &right) {
+    if (left.is_null_ || right.is_null_) {
+      return CmpBool::kNull;
+    }
+    switch (kType) {
+      case kTypeInt:
+        return GetCmpBool(Holds<kOp>(left.value_.integer_, right.value_.integer_));
+      case kTypeFloat:
+        return GetCmpBool(Holds<kOp>(left.value_.float_, right.value_.float_));
+      default:
+        return GetCmpBool(Holds<kOp>(CompareChars(left.value_.chars_, left.len_, right.value_.chars_, right.len_), 0));
+    }
+  }
+
+  template <TypeId kType, CompareOp kOp>
+  static CmpBool CompareColumn(const RowView &view, uint32_t idx, const Field &right) {
+    if (view.IsNull(idx) || right.is_null_) {
+      return CmpBool::kNull;
+    }
+    switch (kType) {
+      case kTypeInt:
+        return GetCmpBool(Holds<kOp>(view.GetInt(idx), right.value_.integer_));
+      case kTypeFloat:
+        return GetCmpBool(Holds<kOp>(view.GetFloat(idx), right.value_.float_));
+      default:
+        return GetCmpBool(Holds<kOp>(
+            CompareChars(view.GetChars(idx), view.GetCharLength(idx), right.value_.chars_, right.len_), 0));
+    }
+  }
+
+  /**
+   * @return a negative number if left sorts before right, a positive one if it sorts after, 0 if they are equal or
+   * either is null
+   */
+  template <TypeId kType>
+  static int Order(const Field &left, const Field &right) {
+    if (left.is_null_ || right.is_null_) {
+      return 0;
+    }
+    switch (kType) {
+      case kTypeInt:
+        return (left.value_.integer_ > right.value_.integer_) - (left.value_.integer_ < right.value_.integer_);
+      case kTypeFloat:
+        return (left.value_.float_ > right.value_.float_) - (left.value_.float_ < right.value_.float_);
+      default:
+        return CompareChars(left.value_.chars_, left.len_, right.value_.chars_, right.len_);
+    }
+  }
+
+  /** @return the kernel comparing fields of type with op, nullptr for an invalid type */
+  static Kernel GetKernel(TypeId type, CompareOp op);
+
+  /** @return the kernel comparing a column of type in place with op, nullptr for an invalid type */
+  static ColumnKernel GetColumnKernel(TypeId type, CompareOp op);
+
+  /** @return the kernel ordering fields of type, nullptr for an invalid type */
+  static OrderKernel GetOrderKernel(TypeId type);
+
+  /**
+   * Parse the operator of a predicate, one of = <> < <= > >=.
+   * @return false if comp_type is none of them
+   */
+  static bool GetCompareOp(const std::string &comp_type, CompareOp *op);
+
+ private:
+  template <CompareOp kOp, typename T>
+  static inline bool Holds(T left, T right) {
+    switch (kOp) {
+      case CompareOp::kEquals:
+        return left == right;
+      case CompareOp::kNotEquals:
+        return left != right;
+      case CompareOp::kLessThan:
+        return left < right;
+      case CompareOp::kLessThanEquals:
+        return left <= right;
+      case CompareOp::kGreaterThan:
+        return left > right;
+      default:
+        return left >= right;
+    }
+  }
+
+  /** Same order as TypeChar: bytewise, a prefix sorts first. */
+  static inline int CompareChars(const char *left, uint32_t left_len, const char *right, uint32_t right_len) {
+    int ret = memcmp(left, right, std::min(left_len, right_len));
+    if (ret == 0 && left_len != right_len) {
+      ret = static_cast<int>(left_len) - static_cast<int>(right_len);
+    }
+    return ret;
+  }
+
+  template <TypeId kType>
+  static Kernel GetKernel(CompareOp op);
+
+  template <TypeId kType>
+  static ColumnKernel GetColumnKernel(CompareOp op);
+};
+
+#endif  // MINISQL_FIELD_COMPARE_H
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "common/macros.h"
+#include "common/memory_arena.h"
 #include "common/rowid.h"
 #include "record/field.h"
 #include "record/schema.h"
@@ -37,12 +38,29 @@ class Row {
   void destroy() {
     if (!fields_.empty()) {
       for (auto field : fields_) {
-        delete field;
+        if (arena_ == nullptr) {
+          delete field;
+        } else {
+          field->~Field();
+        }
       }
       fields_.clear();
     }
+    arena_ = nullptr;
   }
 
+  /**
+   * Drop the fields and place the ones added next, through GetFields(), in arena: the row then runs their destructors
+   * but never frees them, and the arena has to outlive the row. Copying such a row makes an ordinary one.
+   */
+  void UseArena(MemoryArena *arena) {
+    destroy();
+    arena_ = arena;
+  }
+
+  /** @return the arena the fields live in, nullptr if they are allocated one by one */
+  inline MemoryArena *GetArena() const { return arena_; }
+
   ~Row() { destroy(); };
 
   /**
@@ -62,7 +80,7 @@ class Row {
     destroy();
     rid_ = other.rid_;
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      fields_.push_back(other.arena_ == nullptr ? new Field(*field) : CopyFromArena(*field));
     }
   }
 
@@ -70,11 +88,38 @@ class Row {
    * Assign operator, deep copy
    */
   Row &operator=(const Row &other) {
+    if (this == &other) {
+      return *this;
+    }
     destroy();
     rid_ = other.rid_;
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      fields_.push_back(other.arena_ == nullptr ? new Field(*field) : CopyFromArena(*field));
+    }
+    return *this;
+  }
+
+  /**
+   * Move constructor, takes over the fields of other, which is left empty
+   */
+  Row(Row &&other) noexcept : rid_(other.rid_), fields_(std::move(other.fields_)), arena_(other.arena_) {
+    other.fields_.clear();
+    other.arena_ = nullptr;
+  }
+
+  /**
+   * Move assignment, takes over the fields of other, which is left empty
+   */
+  Row &operator=(Row &&other) noexcept {
+    if (this == &other) {
+      return *this;
     }
+    destroy();
+    rid_ = other.rid_;
+    fields_ = std::move(other.fields_);
+    arena_ = other.arena_;
+    other.fields_.clear();
+    other.arena_ = nullptr;
     return *this;
   }
 
@@ -108,8 +153,17 @@ class Row {
   inline size_t GetFieldCount() const { return fields_.size(); }
 
  private:
+  /** @return a copy of a field placed in an arena, owning its characters rather than pointing into the arena */
+  static Field *CopyFromArena(const Field &field) {
+    if (field.GetTypeId() == kTypeChar && !field.IsNull()) {
+      return new Field(kTypeChar, const_cast<char *>(field.GetData()), field.GetLength(), true);
+    }
+    return new Field(field);
+  }
+
   RowId rid_{};
   std::vector<Field *> fields_; /** Make sure that all field ptr are destructed*/
+  MemoryArena *arena_{nullptr}; /** arena the fields are placed in, nullptr if each is allocated with new */
 };
 
 #endif  // MINISQL_ROW_H
@@ -0,0 +1,80 @@
+#ifndef MINISQL_ROW_CODEC_H
+#define MINISQL_ROW_CODEC_H
+
+#include <cstdint>
+#include <vector>
+
+#include "record/column.h"
+#include "record/field.h"
+
+/**
+ * RowCodec serializes the fields of a row for one schema, in the format described in Row:
+ * -----------------------------------------------------
+ * | Field Nums | Null Bitmap | Field-1 | ... | Field-N |
+ * -----------------------------------------------------
+ * An int or float field takes 4 bytes, a char field its length followed by the characters, a null field nothing.
+ *
+ * Every Schema builds its codec once. The codec knows the type of every column up front, so it reads and writes the
+ * field values directly instead of calling through Type::GetInstance for each field. When the schema only has int and
+ * float columns the offset of every column is fixed as long as no field is null: the codec then checks the bitmap once
+ * and reads every field at its precomputed offset. Char columns are stored with the length of their value rather than
+ * the length of the column, so past the first one offsets depend on the data and are followed field by field.
+ */
+class RowCodec {
+ public:
+  explicit RowCodec(const std::vector<Column *> &columns);
+
+  /** @return true if the schema only has columns of a fixed size */
+  inline bool IsFixedWidth() const { return fixed_width_; }
+
+  /** @return the number of bytes written */
+  inline uint32_t SerializeTo(const std::vector<Field *> &fields, char *buf) const {
+    return (this->*serialize_)(fields, buf);
+  }
+
+  /**
+   * Read the fields stored in buf. If fields is empty they are allocated, otherwise fields holds one field per column
+   * (from the row read before) and they are overwritten, so reading row after row into the same Row allocates nothing
+   * but the characters of char fields.
+   * @return the number of bytes read
+   */
+  inline uint32_t DeserializeFrom(const char *buf, std::vector<Field *> *fields) const {
+    return (this->*deserialize_)(buf, fields);
+  }
+
+  uint32_t GetSerializedSize(const std::vector<Field *> &fields) const;
+
+  /** @return the number of columns the codec expects */
+  inline uint32_t GetFieldCount() const { return static_cast<uint32_t>(types_.size()); }
+
+ private:
+  template <bool kFixedWidth>
+  uint32_t SerializeRow(const std::vector<Field *> &fields, char *buf) const;
+
+  template <bool kFixedWidth>
+  uint32_t DeserializeRow(const char *buf, std::vector<Field *> *fields) const;
+
+  /** @return field, or a new one if it is nullptr, made a null of type, with the characters it owned released */
+  static Field *ResetField(Field *field, TypeId type);
+
+  /** @return true if the null bitmap at bitmap has no bit set */
+  inline bool NoneNull(const char *bitmap) const {
+    for (uint32_t i = 0; i < bitmap_len_; i++) {
+      if (bitmap[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<TypeId> types_;      // type of every column
+  std::vector<uint32_t> offsets_;  // offset of every column when no field is null, only used if fixed width
+  uint32_t bitmap_len_;
+  uint32_t header_size_;           // field nums and null bitmap
+  uint32_t fixed_size_{0};         // size of a fixed width row without null fields
+  bool fixed_width_{true};
+  uint32_t (RowCodec::*serialize_)(const std::vector<Field *> &, char *) const;
+  uint32_t (RowCodec::*deserialize_)(const char *, std::vector<Field *> *) const;
+};
+
+#endif  // MINISQL_ROW_CODEC_H
@@ -0,0 +1,71 @@
+#ifndef MINISQL_ROW_VIEW_H
+#define MINISQL_ROW_VIEW_H
+
+#include <vector>
+
+#include "common/macros.h"
+#include "common/rowid.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/**
+ * RowView reads a row in its serialized form (see Row), typically a tuple inside a TablePage, without copying it.
+ *
+ * Reset() walks the null bitmap and the lengths of the char fields once to find where every column starts. Fields are
+ * only decoded when they are asked for, so a predicate that looks at one column never touches the others. The view
+ * does not own the bytes: while it is used the page they live in must stay pinned and latched.
+ */
+class RowView {
+ public:
+  explicit RowView(const Schema *schema);
+
+  /**
+   * Point the view at a serialized row.
+   * @return the size of the serialized row
+   */
+  uint32_t Reset(const char *data, RowId rid);
+
+  inline RowId GetRowId() const { return rid_; }
+
+  inline uint32_t GetFieldCount() const { return static_cast<uint32_t>(types_.size()); }
+
+  inline bool IsNull(uint32_t idx) const { return (bitmap_[idx / 8] >> (idx % 8)) & 1; }
+
+  inline int32_t GetInt(uint32_t idx) const { return MACH_READ_FROM(int32_t, data_ + offsets_[idx]); }
+
+  inline float GetFloat(uint32_t idx) const { return MACH_READ_FROM(float, data_ + offsets_[idx]); }
+
+  /** @return the characters of a char column, not null terminated */
+  inline const char *GetChars(uint32_t idx) const { return data_ + offsets_[idx] + sizeof(uint32_t); }
+
+  inline uint32_t GetCharLength(uint32_t idx) const { return MACH_READ_UINT32(data_ + offsets_[idx]); }
+
+  /**
+   * Decode a field. A char field points into the viewed bytes instead of owning a copy, it must not outlive them.
+   */
+  Field GetField(uint32_t idx) const;
+
+  /**
+   * Copy the viewed row into row, which owns its fields afterwards.
+   * @param arena if given, the fields and their characters are placed in it, see Row::UseArena
+   */
+  void ToRow(Row *row, MemoryArena *arena = nullptr) const;
+
+  /**
+   * Copy the columns of output_schema out of the viewed row, a column is found by its index in the table.
+   */
+  void ToRow(const Schema *output_schema, Row *row, MemoryArena *arena = nullptr) const;
+
+ private:
+  /** @return a new field holding a copy of column idx, allocated in arena if there is one */
+  Field *CopyField(uint32_t idx, MemoryArena *arena) const;
+
+  std::vector<TypeId> types_;      // type of every column
+  std::vector<uint32_t> offsets_;  // offset of every column from data_, null columns take no space
+  const char *data_{nullptr};
+  const char *bitmap_{nullptr};
+  RowId rid_{};
+};
+
+#endif  // MINISQL_ROW_VIEW_H
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "common/dberr.h"
@@ -10,10 +11,12 @@
 #ifndef MINISQL_SCHEMA_H
 #define MINISQL_SCHEMA_H
 
+class RowCodec;
+
 class Schema {
  public:
   explicit Schema(const std::vector<Column *> columns, bool is_manage_ = true)
-      : columns_(std::move(columns)), is_manage_(is_manage_) {}
+      : columns_(std::move(columns)), is_manage_(is_manage_), row_codec_(BuildRowCodec(columns_)) {}
 
   ~Schema() {
     if (is_manage_) {
@@ -24,7 +27,7 @@ class Schema {
   }
 
   // Copy ctor
-  Schema(const Schema &other) : is_manage_(true) {
+  Schema(const Schema &other) : is_manage_(true), row_codec_(other.row_codec_) {
       columns_.reserve(other.columns_.size());
       for (const Column* col_in_other : other.columns_) {
           if (col_in_other) {
@@ -51,6 +54,11 @@ class Schema {
 
   inline uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
 
+  /**
+   * @return the codec that serializes the rows of this schema, see RowCodec
+   */
+  inline const RowCodec &GetRowCodec() const { return *row_codec_; }
+
   /**
    * Shallow copy schema, only used in index
    *
@@ -93,9 +101,12 @@ class Schema {
   static uint32_t DeserializeFrom(char *buf, Schema *&schema);
 
  private:
+  static std::shared_ptr<const RowCodec> BuildRowCodec(const std::vector<Column *> &columns);
+
   static constexpr uint32_t SCHEMA_MAGIC_NUM = 200715;
   std::vector<Column *> columns_;
   bool is_manage_ = false; /** if false, don't need to delete pointer to column */
+  std::shared_ptr<const RowCodec> row_codec_; /** built from the column types, shared by copies */
 };
 
 using IndexSchema = Schema;
@@ -0,0 +1,196 @@
+#ifndef MINISQL_ASYNC_IO_H
+#define MINISQL_ASYNC_IO_H
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Outcome of one asynchronous request. */
+struct AsyncIOResult {
+  uint64_t tag;    // value passed at submission
+  char *buf;       // buffer of the request
+  size_t len;      // bytes requested
+  size_t offset;   // file offset of the request
+  bool write;      // true for writes
+  ssize_t result;  // bytes transferred, or -errno
+  const iovec *iov{nullptr};  // buffers of a vectored request, buf is unused then
+  int iovcnt{0};
+};
+
+/**
+ * AsyncIOContext keeps up to queue_depth reads and writes on one file in flight.
+ *
+ * Requests are queued with SubmitRead/SubmitWrite and handed to the kernel (or to the workers) at the latest when
+ * Complete() is called, which also reaps finished requests. A context is meant to be driven by a single thread; give
+ * every thread its own context.
+ *
+ * Create() picks io_uring when the kernel offers it and falls back to a pool of threads issuing pread/pwrite.
+ */
+class AsyncIOContext {
+ public:
+  /**
+   * @param fd file the requests go to
+   * @param queue_depth maximum number of requests in flight
+   * @param use_io_uring false to force the thread pool backend
+   */
+  static std::unique_ptr<AsyncIOContext> Create(int fd, size_t queue_depth, bool use_io_uring = true);
+
+  virtual ~AsyncIOContext() = default;
+
+  /** Queue a read of len bytes at offset into buf. @return false if queue_depth requests are already in flight */
+  virtual bool SubmitRead(char *buf, size_t len, size_t offset, uint64_t tag) = 0;
+
+  /** Queue a write of len bytes from buf at offset. @return false if queue_depth requests are already in flight */
+  virtual bool SubmitWrite(const char *buf, size_t len, size_t offset, uint64_t tag) = 0;
+
+  /**
+   * Queue a vectored read of the iovcnt buffers of iov, filled in order from offset on. iov must stay valid until the
+   * request completes. @return false if queue_depth requests are already in flight
+   */
+  virtual bool SubmitReadv(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) = 0;
+
+  /** Queue a vectored write, see SubmitReadv(). */
+  virtual bool SubmitWritev(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) = 0;
+
+  /**
+   * Hand in a request the caller has already carried out itself, Complete() returns it like any other. It counts as in
+   * flight until then. @return false if queue_depth requests are already in flight
+   */
+  bool Post(const AsyncIOResult &result) {
+    if (in_flight_ >= queue_depth_) {
+      return false;
+    }
+    posted_.push_back(result);
+    in_flight_++;
+    return true;
+  }
+
+  /**
+   * Start every queued request, then wait until at least min_complete requests (capped by the number in flight) have
+   * finished and append all finished ones to results.
+   * @return the number of results appended
+   */
+  virtual size_t Complete(std::vector<AsyncIOResult> *results, size_t min_complete) = 0;
+
+  /** @return name of the backend, for diagnostics */
+  virtual const char *GetName() const = 0;
+
+  inline size_t GetQueueDepth() const { return queue_depth_; }
+
+  inline size_t GetInFlight() const { return in_flight_; }
+
+ protected:
+  AsyncIOContext(int fd, size_t queue_depth) : fd_(fd), queue_depth_(queue_depth) {}
+
+  /**
+   * Move the posted requests to results, for Complete().
+   * @return the number of results appended
+   */
+  size_t TakePosted(std::vector<AsyncIOResult> *results) {
+    size_t taken = posted_.size();
+    results->insert(results->end(), posted_.begin(), posted_.end());
+    posted_.clear();
+    in_flight_ -= taken;
+    return taken;
+  }
+
+  int fd_;
+  size_t queue_depth_;
+  size_t in_flight_{0};
+  std::vector<AsyncIOResult> posted_;  // requests handed in with Post(), already done
+};
+
+/**
+ * io_uring backend, talking to the kernel through the raw system calls.
+ */
+class IOUringContext : public AsyncIOContext {
+ public:
+  /** @return nullptr if io_uring cannot be set up */
+  static std::unique_ptr<AsyncIOContext> Create(int fd, size_t queue_depth);
+
+  ~IOUringContext() override;
+
+  bool SubmitRead(char *buf, size_t len, size_t offset, uint64_t tag) override;
+
+  bool SubmitWrite(const char *buf, size_t len, size_t offset, uint64_t tag) override;
+
+  bool SubmitReadv(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) override;
+
+  bool SubmitWritev(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) override;
+
+  size_t Complete(std::vector<AsyncIOResult> *results, size_t min_complete) override;
+
+  const char *GetName() const override { return "io_uring"; }
+
+ private:
+  IOUringContext(int fd, size_t queue_depth) : AsyncIOContext(fd, queue_depth) {}
+
+  bool Setup();
+
+  /** @return true if the kernel supports every opcode Queue() submits */
+  bool SupportsOpcodes();
+
+  bool Queue(const AsyncIOResult &request);
+
+  int ring_fd_{-1};
+  void *sq_ring_{nullptr};
+  void *cq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  size_t cq_ring_size_{0};
+  void *sqes_{nullptr};
+  size_t sqes_size_{0};
+  unsigned *sq_tail_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned *sq_array_{nullptr};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned cq_mask_{0};
+  void *cqes_{nullptr};
+  unsigned to_submit_{0};
+  std::vector<AsyncIOResult> slots_;  // request of every slot in flight, the slot index travels as user data
+  std::vector<size_t> free_slots_;
+};
+
+/**
+ * Fallback backend: a few worker threads issuing blocking pread/pwrite.
+ */
+class ThreadPoolIOContext : public AsyncIOContext {
+ public:
+  ThreadPoolIOContext(int fd, size_t queue_depth);
+
+  ~ThreadPoolIOContext() override;
+
+  bool SubmitRead(char *buf, size_t len, size_t offset, uint64_t tag) override;
+
+  bool SubmitWrite(const char *buf, size_t len, size_t offset, uint64_t tag) override;
+
+  bool SubmitReadv(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) override;
+
+  bool SubmitWritev(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) override;
+
+  size_t Complete(std::vector<AsyncIOResult> *results, size_t min_complete) override;
+
+  const char *GetName() const override { return "thread pool"; }
+
+ private:
+  bool Queue(const AsyncIOResult &request);
+
+  void WorkerLoop();
+
+  std::mutex latch_;
+  std::condition_variable submitted_cv_;
+  std::condition_variable completed_cv_;
+  std::deque<AsyncIOResult> submitted_;
+  std::vector<AsyncIOResult> completed_;
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+};
+
+#endif  // MINISQL_ASYNC_IO_H
@@ -0,0 +1,117 @@
+#ifndef MINISQL_COMPRESSED_PAGE_STORE_H
+#define MINISQL_COMPRESSED_PAGE_STORE_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * CompressedPageStore keeps pages compressed in variable-size slots of a file.
+ *
+ * Every page is compressed on its own (see LzCompress()) and stored in a slot of as many SLOT_SIZE units as it needs,
+ * or raw in a full page slot if it does not compress. The page map tells where the slot of every page is; it is kept
+ * in memory and written to a map file of its own by Flush(), which replaces the map file as a whole.
+ *
+ * The file is never written in place: a page that is rewritten always moves to a fresh slot, and its old slot is
+ * quarantined while the map last synced to disk still refers to it, so that a crash leaves that map pointing at the
+ * old contents. Slots are reused, for pages of the same or a smaller size, once a synced map no longer refers to
+ * them; new slots are appended to the file.
+ *
+ * Reads and writes of different pages may run concurrently; a page must not be read while it is written.
+ */
+class CompressedPageStore {
+ public:
+  static constexpr size_t SLOT_SIZE = 64;
+  static constexpr size_t MAX_SLOT_UNITS = PAGE_SIZE / SLOT_SIZE;
+
+  /**
+   * @param fd file holding the slots
+   * @param map_file file holding the page map, read if it exists
+   */
+  CompressedPageStore(int fd, std::string map_file, bool read_only);
+
+  ~CompressedPageStore();
+
+  /**
+   * Read and decompress a page. A page that was never written reads as zeros.
+   * @return false if the page could not be read or does not decompress
+   */
+  bool Read(page_id_t page_id, char *page_data);
+
+  /**
+   * Compress and write a page.
+   * @return false if the page could not be written, it then keeps its previous contents
+   */
+  bool Write(page_id_t page_id, const char *page_data);
+
+  /**
+   * Release the slot of a page, it reads as zeros until written again.
+   */
+  void Free(page_id_t page_id);
+
+  /**
+   * Write the page map to the map file if it changed. The map goes to a temporary file that is renamed over the map
+   * file; with sync the temporary file is synced before and the directory after the rename, and the slots the map no
+   * longer refers to become free for reuse.
+   * @return false if the map could not be written
+   */
+  bool Flush(bool sync);
+
+  /** @return bytes of the slot file in use or free for reuse */
+  inline size_t GetFileSize() const {
+    return static_cast<size_t>(end_unit_.load(std::memory_order_relaxed)) * SLOT_SIZE;
+  }
+
+  /** @return number of read and write system calls issued so far */
+  inline size_t GetIOCallCount() const { return io_calls_.load(std::memory_order_relaxed); }
+
+  /** @return true if map_file exists, i.e. its store was created before */
+  static bool Exists(const std::string &map_file);
+
+ private:
+  /** Location of a page, length_ 0 if the page has none. */
+  struct Slot {
+    uint32_t unit_;     // first SLOT_SIZE unit of the slot
+    uint16_t length_;   // bytes stored, PAGE_SIZE if the page is stored raw
+    uint16_t units_;    // SLOT_SIZE units of the slot
+  };
+  static_assert(sizeof(Slot) == 8);
+
+  /** Take a slot of units units, reusing a free one if possible. Caller must hold the latch. */
+  uint32_t AllocateSlot(uint16_t units);
+
+  /** Return units units starting at unit to the free lists. Caller must hold the latch. */
+  void FreeSlot(uint32_t unit, uint16_t units);
+
+  /**
+   * Give up slot, the former slot of page page_id: quarantine it if the synced map refers to it, free it otherwise.
+   * Caller must hold the latch.
+   */
+  void ReleaseSlot(page_id_t page_id, const Slot &slot);
+
+  /** Write len bytes of buf to file_name as a whole, and fdatasync it with sync. */
+  bool WriteFile(const std::string &file_name, const char *buf, size_t len, bool sync);
+
+  /** Rebuild the free lists from the gaps between the slots of the page map. */
+  void LoadFreeSlots();
+
+  int fd_;
+  std::string map_file_;
+  bool read_only_;
+  std::mutex flush_latch_;  // serializes Flush()
+  std::mutex latch_;  // protects everything below
+  std::vector<Slot> map_;  // slot of every page, indexed by page id
+  std::vector<Slot> synced_map_;  // the map as last synced, or being synced, to the map file
+  std::vector<std::pair<uint32_t, uint16_t>> quarantined_;  // released slots the synced map still refers to
+  std::vector<uint32_t> free_slots_[MAX_SLOT_UNITS + 1];  // first unit of free slots, by size in units
+  std::atomic<uint32_t> end_unit_{0};  // units of the file handed out so far
+  bool map_dirty_{false};   // changed since the last Flush()
+  bool map_synced_{true};   // not changed since the last Flush() with sync
+  std::atomic<size_t> io_calls_{0};
+};
+
+#endif  // MINISQL_COMPRESSED_PAGE_STORE_H
@@ -2,15 +2,31 @@
 #define DISK_MGR_H
 
 #include <atomic>
-#include <fstream>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "common/config.h"
 #include "common/macros.h"
 #include "page/bitmap_page.h"
 #include "page/disk_file_meta_page.h"
+#include "storage/async_io.h"
+#include "storage/compressed_page_store.h"
+
+/**
+ * When a commit makes its pages durable.
+ */
+enum class SyncPolicy {
+  kNone,       // never sync, the OS writes pages back whenever it likes
+  kPerCommit,  // every commit waits for an fdatasync covering its pages, concurrent commits share one
+  kInterval    // a background thread syncs periodically, commits do not wait
+};
 
 /**
  * DiskManager takes care of the allocation and de allocation of pages within a database. It performs the reading and
@@ -19,10 +35,47 @@
  * Disk page storage format: (Free Page BitMap Size = PAGE_SIZE * 8, we note it as N)
  * | Meta Page | Free Page BitMap 1 | Page 1 | Page 2 | ....
  *      | Page N | Free Page BitMap 2 | Page N+1 | ... | Page 2N | ... |
+ *
+ * Pages are read and written with positional pread/pwrite on a plain file descriptor, so there is no shared seek
+ * position and page reads and writes from different threads do not serialize on a latch. The file size is cached in
+ * memory instead of being queried on every read.
+ *
+ * Besides the blocking ReadPage/WritePage, pages can be read and written through an AsyncIOContext created by
+ * CreateAsyncIOContext(), which keeps many requests in flight on the same file.
+ *
+ * The extent bitmaps are kept in memory once touched and written back together with the meta page by Sync() and
+ * Close(), so allocating and freeing pages costs no I/O. Opening a file that another DiskManager of this process has
+ * open for writing makes that one write them back first, so that the new one sees every page allocated so far. Extents
+ * with free pages are tracked in a bitmap of their own, which makes finding the extent to allocate from a word scan
+ * instead of a walk over every extent.
+ *
+ * Writes are not durable until Sync() returns. Sync() issues one fdatasync covering every page written before it was
+ * called; callers arriving while a sync is running wait for it and share the next one (group commit). Commit() is the
+ * durability point of a commit and syncs according to the SyncPolicy.
+ *
+ * With checksums enabled, every logical page written gets the CRC32C of its contents stored in its trailer (the last
+ * PAGE_CHECKSUM_SIZE bytes) and every page read is verified against it. Once checksums were enabled on a file, the
+ * trailer is written as 0 while they are off, so that no stale checksum is left behind. A page whose trailer is 0 was
+ * written without a checksum, or never, and is not verified, so checksums can be turned on for an existing file. Files
+ * created before pages had a trailer are marked so in the meta page and refuse checksums, their pages keep data there.
+ * The meta and bitmap pages are internal to the disk manager and carry none.
+ *
+ * A file can also be created compressed. Then every physical page (meta, bitmap and logical pages alike) is kept in a
+ * CompressedPageStore: compressed on write into a variable-size slot of the file and decompressed on read, with the
+ * page map in a second file next to it (PageMapFile()). The layout of physical page ids stays the same, so callers only
+ * notice that the file is smaller; page runs are transferred one page at a time and asynchronous requests are carried
+ * out on submission. The page map is written on Close() and Sync().
+ *
+ * A database that is never modified can be opened read-only. The file is then memory-mapped as a whole and
+ * GetMappedPage() hands out pointers into the mapping; every operation that would modify the file fails.
  */
 class DiskManager {
  public:
-  explicit DiskManager(const std::string &db_file);
+  /**
+   * Open db_file, creating it if needed. A file with a page map is opened compressed; with compressed a new (empty)
+   * file is created compressed.
+   */
+  explicit DiskManager(const std::string &db_file, bool read_only = false, bool compressed = false);
 
   ~DiskManager() {
     if (!closed) {
@@ -33,14 +86,127 @@ class DiskManager {
   /**
    * Read page from specific page_id
    * Note: page_id = 0 is reserved for free page bit map
+   * @return false if checksums are enabled and the page does not match its checksum
    */
-  void ReadPage(page_id_t logical_page_id, char *page_data);
+  bool ReadPage(page_id_t logical_page_id, char *page_data);
 
   /**
-   * Write data to specific page
+   * Write data to specific page, storing its checksum in the page trailer if checksums are enabled
    * Note: page_id = 0 is reserved for free page bit map
+   * @return false if the page could not be written
+   */
+  bool WritePage(page_id_t logical_page_id, char *page_data);
+
+  /**
+   * Read count consecutive logical pages starting at first_page_id into page_data[0..count). Pages that are physically
+   * adjacent are read with a single preadv, only the bitmap page between two extents splits a run.
+   * @return false if a page does not match its checksum
+   */
+  bool ReadPages(page_id_t first_page_id, size_t count, char *const *page_data);
+
+  /**
+   * Write count consecutive logical pages starting at first_page_id, see ReadPages().
+   * @return false if a page could not be written
+   */
+  bool WritePages(page_id_t first_page_id, size_t count, char *const *page_data);
+
+  /**
+   * Turn page checksums on or off, they are off by default.
+   * @return false if the file was created before pages had a checksum trailer, checksums then stay off
+   */
+  bool EnableChecksums(bool enabled);
+
+  inline bool IsChecksumEnabled() const { return checksums_.load(std::memory_order_relaxed); }
+
+  /** @return the number of pages read that did not match their checksum */
+  inline size_t GetChecksumFailureCount() const { return checksum_failures_.load(std::memory_order_relaxed); }
+
+  /**
+   * Make every page written and every allocation made before the call durable. Concurrent callers share a single
+   * fdatasync, which also covers the meta page and the extent bitmaps.
+   */
+  void Sync();
+
+  /**
+   * Durability point of a commit: Sync() under SyncPolicy::kPerCommit, nothing otherwise.
+   */
+  void Commit();
+
+  /**
+   * Change the sync policy. Under SyncPolicy::kInterval a background thread syncs every interval if pages were written.
+   */
+  void SetSyncPolicy(SyncPolicy policy, std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+  inline SyncPolicy GetSyncPolicy() const { return sync_policy_; }
+
+  /** @return the number of fdatasync calls issued so far */
+  inline size_t GetSyncCount() const { return syncs_.load(std::memory_order_relaxed); }
+
+  /** @return true if logical page b directly follows logical page a in the file */
+  static inline bool IsNextPhysicalPage(page_id_t a, page_id_t b) {
+    return b == a + 1 && b % static_cast<page_id_t>(BITMAP_SIZE) != 0;
+  }
+
+  /** @return the number of read and write system calls issued for pages so far */
+  inline size_t GetIOCallCount() const {
+    return io_calls_.load(std::memory_order_relaxed) + (store_ != nullptr ? store_->GetIOCallCount() : 0);
+  }
+
+  /** @return true if pages are stored compressed */
+  inline bool IsCompressed() const { return store_ != nullptr; }
+
+  /** @return name of the page map file of a compressed db_file */
+  static std::string PageMapFile(const std::string &db_file) { return db_file + ".map"; }
+
+  /** @return true if the file was opened read-only and memory-mapped */
+  inline bool IsReadOnly() const { return read_only_; }
+
+  /**
+   * Address of a page inside the mapping of a read-only file. The memory must not be written. Pages of a compressed
+   * file are decompressed into memory owned by the disk manager on first use.
+   * @return nullptr if the file is not mapped, the page lies beyond its end or does not match its checksum
+   */
+  char *GetMappedPage(page_id_t logical_page_id);
+
+  /** @return number of logical pages covered by the extents of the file */
+  size_t GetLogicalPageCount();
+
+  /**
+   * Create an asynchronous I/O context on the db file. Each thread doing asynchronous I/O should own its own context.
+   * @param queue_depth maximum number of page requests in flight
+   */
+  std::unique_ptr<AsyncIOContext> CreateAsyncIOContext(size_t queue_depth);
+
+  /**
+   * Queue an asynchronous read of a page, see CompletePages().
+   * @return false if the context already has queue_depth requests in flight
    */
-  void WritePage(page_id_t logical_page_id, const char *page_data);
+  bool SubmitReadPage(AsyncIOContext *io, page_id_t logical_page_id, char *page_data, uint64_t tag);
+
+  /**
+   * Queue an asynchronous write of a page, page_data must stay untouched until the write completes.
+   * @return false if the context already has queue_depth requests in flight
+   */
+  bool SubmitWritePage(AsyncIOContext *io, page_id_t logical_page_id, char *page_data, uint64_t tag);
+
+  /**
+   * Queue an asynchronous read of iovcnt consecutive logical pages starting at first_page_id, one PAGE_SIZE buffer
+   * each. The pages must be physically adjacent (see IsNextPhysicalPage()) and iov must stay valid until completion.
+   * @return false if the context already has queue_depth requests in flight
+   */
+  bool SubmitReadPages(AsyncIOContext *io, page_id_t first_page_id, const iovec *iov, int iovcnt, uint64_t tag);
+
+  /**
+   * Queue an asynchronous write of physically adjacent pages, see SubmitReadPages().
+   */
+  bool SubmitWritePages(AsyncIOContext *io, page_id_t first_page_id, const iovec *iov, int iovcnt, uint64_t tag);
+
+  /**
+   * Wait until at least min_complete page requests of io finished and append them to results. Reads beyond the end
+   * of the file come back zero filled, like ReadPage(). A read with a page not matching its checksum fails with EIO.
+   * @return the number of results appended
+   */
+  size_t CompletePages(AsyncIOContext *io, std::vector<AsyncIOResult> *results, size_t min_complete);
 
   /**
    * Get next free page from disk
@@ -70,35 +236,145 @@ class DiskManager {
   char *GetMetaData() { return meta_data_; }
 
   static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_SIZE>::GetMaxSupportedSize(); // bits
+  static constexpr size_t MAX_EXTENTS = (PAGE_SIZE - 3 * sizeof(uint32_t)) / sizeof(uint32_t);  // fit in the meta page
 
  private:
   /**
    * Helper function to get disk file size
    */
-  int GetFileSize(const std::string &file_name);
+  size_t GetFileSize();
 
   /**
-   * Read physical page from disk
+   * Read physical page from disk, a page past the end of the file reads as zeros
+   * @return false if the read failed or a compressed page could not be read back
    */
-  void ReadPhysicalPage(page_id_t physical_page_id, char *page_data);
+  bool ReadPhysicalPage(page_id_t physical_page_id, char *page_data);
 
   /**
    * Write data to physical page in disk
+   * @return false on an I/O error
+   */
+  bool WritePhysicalPage(page_id_t physical_page_id, const char *page_data);
+
+  /**
+   * Move the iovcnt pages of iov from or to consecutive physical pages with as few preadv/pwritev calls as possible.
+   * Reads beyond the end of the file are zero filled.
+   * @return false on an I/O error, or if a compressed page could not be read back
+   */
+  bool TransferPhysicalPages(bool write, page_id_t first_physical_page_id, iovec *iov, int iovcnt);
+
+  /**
+   * TransferPhysicalPages() of a compressed file, page by page.
+   */
+  bool TransferCompressedPages(bool write, page_id_t first_physical_page_id, const iovec *iov, int iovcnt);
+
+  /**
+   * Store the checksum of a logical page in its trailer, if checksums are enabled.
+   */
+  void StampChecksum(char *page_data);
+
+  /**
+   * @return false if checksums are enabled and the page does not match the checksum in its trailer
    */
-  void WritePhysicalPage(page_id_t physical_page_id, const char *page_data);
+  bool VerifyChecksum(page_id_t logical_page_id, const char *page_data);
 
   /**
    * Map logical page id to physical page id
    */
   page_id_t MapPageId(page_id_t logical_page_id);
 
+  /**
+   * Account for a completed write ending at end: grow the cached file size and make the next Sync() cover it
+   */
+  void RecordWrite(size_t end);
+
+  /**
+   * Body of the interval sync thread.
+   */
+  void SyncLoop(std::chrono::milliseconds interval);
+
+  /** Stop the interval sync thread, if running. */
+  void StopSyncThread();
+
+  /**
+   * Write back the dirty extent bitmaps and the meta page, if the allocation changed. Caller must hold db_io_latch_.
+   */
+  void FlushAllocation();
+
+  /**
+   * Make the DiskManagers of this process that have file_name open for writing write back their allocation and page
+   * map, so that it can be read.
+   */
+  void FlushOpenFile(const std::string &file_name);
+
+  /** Add this DiskManager to the ones that have its file open for writing, once it is open. */
+  void RegisterOpenFile();
+
+  /** Undo RegisterOpenFile(). */
+  void UnregisterOpenFile();
+
+  /**
+   * Bitmap of an extent, read from disk on first use. Caller must hold db_io_latch_.
+   */
+  BitmapPage<PAGE_SIZE> *GetExtentBitmap(uint32_t extent_id);
+
+  /**
+   * @return the first extent with free pages, or the number of extents if all of them are full
+   */
+  uint32_t FindFreeExtent();
+
+  inline void SetExtentFree(uint32_t extent_id, bool free) {
+    if (free) {
+      free_extents_[extent_id / 64] |= 1ULL << (extent_id % 64);
+    } else {
+      free_extents_[extent_id / 64] &= ~(1ULL << (extent_id % 64));
+    }
+  }
+
  private:
-  // stream to write db file
-  std::fstream db_io_;
+  // file descriptor of the db file
+  int db_fd_{-1};
   std::string file_name_;
-  // with multiple buffer pool instances, need to protect file access
+  // cached size of the db file, only ever grows
+  std::atomic<size_t> file_size_{0};
+  std::atomic<size_t> io_calls_{0};
+  std::atomic<bool> checksums_{false};
+  // the logical pages of the file reserve a checksum trailer, see DiskFileMetaPage::HasPageTrailer()
+  bool page_trailer_{false};
+  // checksums were enabled on the file before, see DiskFileMetaPage::HadChecksums()
+  std::atomic<bool> had_checksums_{false};
+  // pages of a compressed file, nullptr for the plain layout
+  std::unique_ptr<CompressedPageStore> store_;
+  // pages of a compressed read-only file handed out by GetMappedPage()
+  std::unordered_map<page_id_t, std::unique_ptr<char[]>> decompressed_;
+  std::mutex decompressed_latch_;
+  std::atomic<size_t> checksum_failures_{0};
+  // group commit: number of completed writes, and how many of them the last fdatasync covered
+  std::atomic<uint64_t> writes_{0};
+  uint64_t synced_writes_{0};
+  bool syncing_{false};
+  std::mutex sync_latch_;  // protects synced_writes_, syncing_ and the sync thread state
+  std::condition_variable sync_cv_;
+  std::atomic<size_t> syncs_{0};
+  SyncPolicy sync_policy_{SyncPolicy::kNone};
+  std::thread sync_thread_;
+  bool sync_thread_stop_{false};
+  // protects the meta page and the bitmap pages, page reads and writes do not need it
   std::recursive_mutex db_io_latch_;
   bool closed{false};
+  bool read_only_{false};
+  // whole file mapping, read-only mode only
+  char *mapping_{nullptr};
+  size_t mapping_size_{0};
+  // extent bitmaps, cached on first use and written back by FlushAllocation()
+  std::unique_ptr<char[]> bitmaps_[MAX_EXTENTS];
+  bool bitmap_dirty_[MAX_EXTENTS]{};
+  bool meta_dirty_{false};
+  // absolute path of the file, the key of this DiskManager among the open files once registered
+  std::string open_file_key_;
+  bool registered_{false};
+  // bit e is set while extent e has free pages
+  uint64_t free_extents_[(MAX_EXTENTS + 63) / 64]{};
   char meta_data_[PAGE_SIZE];
   /**
    * PAGE_SIZE = 4096 Byte
@@ -0,0 +1,96 @@
+#ifndef MINISQL_FREE_SPACE_MAP_H
+#define MINISQL_FREE_SPACE_MAP_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "page/free_space_map_page.h"
+
+/**
+ * FreeSpaceMap records how much free space every page of a table heap has, so that an insert can go straight to a page
+ * with enough room instead of walking the page chain.
+ *
+ * Free space is kept in coarse categories of CATEGORY_SIZE bytes, rounded down: a page of category c has at least
+ * c * CATEGORY_SIZE free bytes. The whole map is cached in memory, pages are bucketed by category, and finding a page
+ * takes constant time. A persistent map writes every category change through to its chain of FreeSpaceMapPages. The
+ * map is only a hint: an insert that does not fit into the page it was given corrects the category of that page and
+ * asks again. The map pages only ever lag behind the heap: a persistent map that fails to grow stops writing, and the
+ * heap pages it has not recorded are found again from the page chain when the table is appended to.
+ */
+class FreeSpaceMap {
+ public:
+  /** Bytes of free space per category. */
+  static constexpr uint32_t CATEGORY_SIZE = PAGE_SIZE / 256;
+
+  /**
+   * Allocate and initialize the first page of a new persistent map.
+   * @return the page id of the map, or INVALID_PAGE_ID if no page could be allocated
+   */
+  static page_id_t NewMap(BufferPoolManager *buffer_pool_manager);
+
+  /**
+   * Load the map starting at first_page_id. With INVALID_PAGE_ID the map is kept in memory only.
+   */
+  explicit FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id);
+
+  /**
+   * @return a heap page that should have at least size free bytes, or INVALID_PAGE_ID if there is none
+   */
+  page_id_t FindPage(uint32_t size);
+
+  /**
+   * Record the free space of a heap page. A page the map does not know yet is added as the last page of the heap.
+   */
+  void Update(page_id_t heap_page_id, uint32_t free_space);
+
+  /** @return the heap page added last, i.e. the tail of the heap, or INVALID_PAGE_ID if the map is empty */
+  page_id_t GetLastPageId();
+
+  /** @return the number of heap pages in the map */
+  size_t GetPageCount();
+
+  /** @return the first page of a persistent map, INVALID_PAGE_ID if the map is in memory only */
+  inline page_id_t GetFirstPageId() const { return first_page_id_; }
+
+  /**
+   * Delete the pages of a persistent map.
+   */
+  void Free();
+
+ private:
+  struct Entry {
+    page_id_t page_id_;
+    uint8_t category_;
+    uint32_t bucket_pos_;  // position of the entry in the bucket of its category
+  };
+
+  static inline uint8_t ToCategory(uint32_t free_space) {
+    return static_cast<uint8_t>(std::min<uint32_t>(free_space / CATEGORY_SIZE, UINT8_MAX));
+  }
+
+  /**
+   * Put an entry into the bucket of its category, or take it out. Caller must hold the latch.
+   */
+  void LinkEntry(uint32_t index);
+
+  void UnlinkEntry(uint32_t index);
+
+  /**
+   * Write the category of an entry to its map page, appending the entry (and a map page) if it is new. Caller must
+   * hold the latch.
+   */
+  void Persist(uint32_t index, bool append);
+
+  BufferPoolManager *buffer_pool_manager_;
+  page_id_t first_page_id_;
+  std::vector<page_id_t> map_pages_;                  // pages of the map, entry i lives in map_pages_[i / MAX_ENTRIES]
+  std::vector<Entry> entries_;                        // heap pages in the order they were added
+  std::unordered_map<page_id_t, uint32_t> indexes_;   // heap page id -> index of its entry
+  std::vector<std::vector<uint32_t>> buckets_;        // category -> entries of that category
+  bool persistent_;  // category changes are written to the map pages
+  std::mutex latch_;
+};
+
+#endif  // MINISQL_FREE_SPACE_MAP_H
@@ -1,11 +1,15 @@
 #ifndef MINISQL_TABLE_HEAP_H
 #define MINISQL_TABLE_HEAP_H
 
+#include <memory>
+#include <mutex>
+
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/lock_manager.h"
 #include "page/header_page.h"
 #include "page/table_page.h"
 #include "recovery/log_manager.h"
+#include "storage/free_space_map.h"
 #include "storage/table_iterator.h"
 
 class TableHeap {
@@ -17,21 +21,38 @@ class TableHeap {
     return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager);
   }
 
+  /**
+   * Open an existing table heap. Without the page of its free space map, the map is rebuilt in memory from the page
+   * chain by the first operation that needs it.
+   */
   static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                           LogManager *log_manager, LockManager *lock_manager) {
-    return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
+                           LogManager *log_manager, LockManager *lock_manager,
+                           page_id_t free_space_map_page_id = INVALID_PAGE_ID) {
+    return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager,
+                         free_space_map_page_id);
   }
 
   ~TableHeap() {}
 
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * The tuple goes to a page the free space map has room on, or to a new page appended at the tail.
    * @param[in/out] row Tuple Row to insert, the rid of the inserted tuple is wrapped in object row
    * @param[in] txn The recovery performing the insert
    * @return true iff the insert is successful
    */
   bool InsertTuple(Row &row, Txn *txn);
 
+  /**
+   * Insert a batch of tuples at the tail of the table. The last page is filled first, the rest is packed into new pages
+   * that are linked into the page chain at once. Unlike InsertTuple, free space in earlier pages is not reused.
+   * @param[in/out] rows Tuples to insert, the rid of every inserted tuple is wrapped in its row
+   * @param[in] txn The transaction performing the insert
+   * @return the number of rows inserted, from the front of rows; less than rows.size() only if no page could be allocated
+   * or a row does not fit into a page
+   */
+  size_t BulkInsert(std::vector<Row> &rows, Txn *txn);
+
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
    * @param[in] rid Resource id of the tuple of delete
@@ -81,6 +102,9 @@ class TableHeap {
       buffer_pool_manager_->UnpinPage(old_page_id, false);
       buffer_pool_manager_->DeletePage(old_page_id);
     }
+    if (free_space_map_ != nullptr) {
+      free_space_map_->Free();
+    }
   }
 
   /**
@@ -108,6 +132,13 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * @return the first page of the persistent free space map, INVALID_PAGE_ID if the map is kept in memory only
+   */
+  inline page_id_t GetFreeSpaceMapPageId() const {
+    return free_space_map_ == nullptr ? INVALID_PAGE_ID : free_space_map_->GetFirstPageId();
+  }
+
  private:
   /**
    * create table heap and initialize first page
@@ -122,24 +153,48 @@ class TableHeap {
 
     // Fatch a new page.
     page_id_t newPageId;
-    buffer_pool_manager_->NewPage(newPageId);
-    auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(newPageId));
+    auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(newPageId));
     
     // Initialize and unpin and record the first page id.
     newPage->WLatch();
     newPage->Init(newPageId, INVALID_PAGE_ID, log_manager_, txn);
+    uint32_t free_space = newPage->GetFreeSpaceRemaining();
     newPage->WUnlatch();
     buffer_pool_manager_->UnpinPage(newPageId, true);
     first_page_id_ = newPageId;
+
+    // Create the free space map, it starts out with the first page.
+    free_space_map_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_, FreeSpaceMap::NewMap(buffer_pool_manager_));
+    free_space_map_->Update(newPageId, free_space);
   };
 
   explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                     LogManager *log_manager, LockManager *lock_manager)
+                     LogManager *log_manager, LockManager *lock_manager, page_id_t free_space_map_page_id)
       : buffer_pool_manager_(buffer_pool_manager),
         first_page_id_(first_page_id),
         schema_(schema),
         log_manager_(log_manager),
-        lock_manager_(lock_manager) {}
+        lock_manager_(lock_manager) {
+    if (free_space_map_page_id != INVALID_PAGE_ID) {
+      free_space_map_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_, free_space_map_page_id);
+    }
+  }
+
+  /**
+   * @return the free space map, rebuilt from the page chain on first use if the heap was opened without one
+   */
+  FreeSpaceMap *GetFreeSpaceMap();
+
+  /**
+   * Insert a tuple at the tail of the heap, appending a new page if the last page is full.
+   */
+  bool AppendTuple(Row &row, Txn *txn);
+
+  /**
+   * Find the last page of the chain. Caller must hold the append latch.
+   * @return the tail, pinned and write latched, or nullptr if a page could not be fetched
+   */
+  TablePage *FetchTail(page_id_t *tail_page_id);
 
  private:
   BufferPoolManager *buffer_pool_manager_;
@@ -147,6 +202,9 @@ class TableHeap {
   Schema *schema_;
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
+  std::unique_ptr<FreeSpaceMap> free_space_map_;
+  std::once_flag free_space_map_built_;
+  std::mutex append_latch_;  // serializes appending pages at the tail
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
@@ -17,12 +17,17 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size) {
 
-    // Default size.
-    if (leaf_max_size_ == UNDEFINED_SIZE) {
-        leaf_max_size_ = (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(RowId));
+    // Default size, as many pairs as fit in a page. Pages of packable keys also hold them packed, which leaves room
+    // for fewer pairs.
+    bool packed_keys = processor_.IsPackable();
+    int leaf_capacity = BPlusTreePage::GetCapacity(LEAF_PAGE_HEADER_SIZE, processor_.GetKeySize() + sizeof(RowId), packed_keys);
+    int internal_capacity =
+        BPlusTreePage::GetCapacity(INTERNAL_PAGE_HEADER_SIZE, processor_.GetKeySize() + sizeof(page_id_t), packed_keys);
+    if (leaf_max_size_ == UNDEFINED_SIZE || leaf_max_size_ > leaf_capacity) {
+        leaf_max_size_ = leaf_capacity;
     }
-    if (internal_max_size_ == UNDEFINED_SIZE) {
-        internal_max_size_ = (PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(page_id_t));
+    if (internal_max_size_ == UNDEFINED_SIZE || internal_max_size_ > internal_capacity) {
+        internal_max_size_ = internal_capacity;
     }
 
     // Load root_page_id_ from header page.
@@ -31,16 +36,20 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
         LOG(WARNING) << "Faied to fatch index roots page.";
     } else {
         auto *root_node = reinterpret_cast<IndexRootsPage *>(root_page->GetData());
-        root_node->GetRootId(index_id_, &root_page_id_);
+        page_id_t root_page_id = INVALID_PAGE_ID;
+        root_node->GetRootId(index_id_, &root_page_id);
+        root_page_id_ = root_page_id;
     }
     buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
 }
 
 void BPlusTree::Destroy(page_id_t current_page_id) {
     // If called with default, destroy the whole tree.
-    if (current_page_id == INVALID_PAGE_ID)
-        if (root_page_id_ == INVALID_FRAME_ID) { return; } // The tree is already destroyed.
+    if (current_page_id == INVALID_PAGE_ID) {
+        DeletePages({});
+        if (root_page_id_ == INVALID_PAGE_ID) { return; } // The tree is already destroyed.
         current_page_id = root_page_id_;
+    }
 
     auto *node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(current_page_id)->GetData());
     if (node == nullptr) { return; }
@@ -78,17 +87,16 @@ bool BPlusTree::IsEmpty() const {
  * @return : true means key exists
  */
 bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction) {
-    if (IsEmpty()) { return false; }
-    auto *leaf_node = reinterpret_cast<LeafPage *>(FindLeafPage(key, root_page_id_, false)->GetData());
-
-    // Invalid key.
-    if (leaf_node == nullptr) { return false; }
+    Page *leaf_page = FindLeafPageOptimistic(key, false, false);
+    if (leaf_page == nullptr) { return false; } // Empty tree.
+    auto *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
 
     // Look up in the leaf node.
     RowId value;
     bool found = leaf_node->Lookup(key, value, processor_);
 
-    buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), false);
+    leaf_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
 
     if (found) {
         result.push_back(value);
@@ -107,11 +115,38 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn
  * keys return false, otherwise return true.
  */
 bool BPlusTree::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
-    if (IsEmpty()) {
+    // Optimistic: most inserts fit in their leaf, which is then the only page to write latch.
+    Page *leaf_page = FindLeafPageOptimistic(key, false, true);
+    if (leaf_page != nullptr) {
+        auto *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+        RowId old_value;
+        if (leaf_node->Lookup(key, old_value, processor_)) { // Duplicated key.
+            leaf_page->WUnlatch();
+            buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+            return false;
+        }
+        if (IsSafe(leaf_node, Operation::kInsert)) {
+            leaf_node->Insert(key, value, processor_);
+            leaf_page->WUnlatch();
+            buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
+            return true;
+        }
+        leaf_page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+    }
+
+    // Pessimistic: the leaf splits, or the tree is empty.
+    std::vector<Page *> latched;
+    bool root_latched = false;
+    leaf_page = FindLeafPagePessimistic(key, Operation::kInsert, latched, root_latched);
+    bool inserted = true;
+    if (leaf_page == nullptr) {
         StartNewTree(key, value);
-        return true;
+    } else {
+        inserted = InsertIntoLeaf(reinterpret_cast<LeafPage *>(leaf_page->GetData()), key, value, transaction);
     }
-    return InsertIntoLeaf(key, value, transaction);
+    ReleaseLatches(latched, root_latched, inserted);
+    return inserted;
 }
 /*
  * Insert constant key & value pair into an empty tree
@@ -128,7 +163,7 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
     UpdateRootPageId(1);
     
     auto *root_node = reinterpret_cast<LeafPage *>(root_page->GetData());
-    root_node->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_);
+    root_node->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_, processor_.IsPackable());
     root_node->Insert(key, value, processor_);
     
     buffer_pool_manager_->UnpinPage(root_page_id_, true);
@@ -136,28 +171,23 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
 
 /*
  * Insert constant key & value pair into leaf page
- * User needs to first find the right leaf page as insertion target, then look
- * through leaf page to see whether insert key exist or not. If exist, return
- * immediately, otherwise insert entry. Remember to deal with split if necessary.
+ * The leaf page is the right one for key, write latched with every page a split
+ * would change and pinned by the caller. Look through leaf page to see whether
+ * insert key exist or not. If exist, return immediately, otherwise insert entry.
+ * Remember to deal with split if necessary.
  * @return: since we only support unique key, if user try to insert duplicate
  * keys return false, otherwise return true.
  */
-bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transaction) {
-    Page *leaf_page = FindLeafPage(key, root_page_id_, false);
-    if (leaf_page == nullptr) { return false; } // Not found.
-    auto *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
-
+bool BPlusTree::InsertIntoLeaf(LeafPage *leaf_node, GenericKey *key, const RowId &value, Txn *transaction) {
     // Check for duplications.
     RowId val;
     if (leaf_node->Lookup(key, val, processor_)) {
-       buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), false);
        return false;
     }
 
     // If the leaf node has extra space.
     if (leaf_node->GetSize() < leaf_node->GetMaxSize()) {
         leaf_node->Insert(key, value, processor_);
-        buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), true);  
 
         // std::cout << "Insert. Not spliting." << endl;
 
@@ -174,7 +204,6 @@ bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transac
         }
 
         InsertIntoParent(leaf_node, middle_key, new_leaf_node, transaction); // Set to the parent node.
-        buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), true);
         buffer_pool_manager_->UnpinPage(new_leaf_node->GetPageId(), true);
     }
 
@@ -193,7 +222,7 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Txn *transaction) {
     Page *new_internal_page = buffer_pool_manager_->NewPage(new_page_id);
     if (new_internal_page == nullptr) { throw std::runtime_error("Out of memory error! Can't allocate a new page for split!"); }
     auto *new_internal_node = reinterpret_cast<InternalPage *>(new_internal_page->GetData());
-    new_internal_node->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_);
+    new_internal_node->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_, processor_.IsPackable());
     node->MoveHalfTo(new_internal_node, buffer_pool_manager_);
 
     // Unpinned in the BPlusTree::InsertIntoParent()
@@ -205,7 +234,7 @@ BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Txn *transaction) {
     Page *new_leaf_page = buffer_pool_manager_->NewPage(new_page_id);
     if (new_leaf_page == nullptr) { throw std::runtime_error("Out of memory error! Can't allocate a new page for split!"); }
     auto *new_leaf_node = reinterpret_cast<LeafPage *>(new_leaf_page->GetData());
-    new_leaf_node->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_);
+    new_leaf_node->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_, processor_.IsPackable());
     node->MoveHalfTo(new_leaf_node);
 
     new_leaf_node->SetNextPageId(node->GetNextPageId());
@@ -230,7 +259,7 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
         Page *new_root_page = buffer_pool_manager_->NewPage(new_root_page_id);
         if (new_root_page == nullptr) { throw std::runtime_error("Out of memory error! Can't allocate a new page for split!"); }
         auto *new_root_node = reinterpret_cast<InternalPage *>(new_root_page->GetData());
-        new_root_node->Init(new_root_page_id, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_);
+        new_root_node->Init(new_root_page_id, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_, processor_.IsPackable());
 
         // Populate new root page with old_value + new_key & new_value
         new_root_node->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
@@ -272,6 +301,135 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
     }
 }
 
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+namespace {
+
+/*
+ * Number of pages to spread count pairs over, so that every page holds about
+ * fill_factor of max_size of them and no page but the root less than min_size.
+ */
+size_t BulkLoadPageCount(size_t count, int max_size, int min_size, double fill_factor) {
+    size_t per_page = std::min(std::max(static_cast<int>(max_size * fill_factor), 1), max_size);
+    size_t pages = (count + per_page - 1) / per_page;
+    while (pages > 1 && count / pages < static_cast<size_t>(min_size)) { pages--; }
+    return pages;
+}
+
+/*
+ * Pairs of the index-th of pages holding count pairs together, the first ones
+ * take one more if they do not divide evenly.
+ */
+int BulkLoadPageSize(size_t count, size_t pages, size_t index) {
+    return static_cast<int>(count / pages + (index < count % pages ? 1 : 0));
+}
+
+}  // namespace
+
+bool BPlusTree::BulkLoad(size_t count, const std::function<bool(GenericKey *key, RowId *value)> &next,
+                         double fill_factor) {
+    root_latch_.WLock();
+    if (!IsEmpty()) {
+        root_latch_.WUnlock();
+        return false;
+    }
+    if (count == 0) {
+        root_latch_.WUnlock();
+        return true;
+    }
+
+    // Leaves, left to right, each pinned until the next one is linked to it.
+    int key_size = processor_.GetKeySize();
+    size_t leaf_count = BulkLoadPageCount(count, leaf_max_size_, leaf_max_size_ / 2, fill_factor);
+    std::vector<page_id_t> leaves;
+    std::vector<char> leaf_keys(leaf_count * key_size);
+    GenericKey *key = processor_.InitKey();
+    RowId value;
+    LeafPage *prev_leaf = nullptr;
+    bool ordered = true;
+    for (size_t i = 0; i < leaf_count && ordered; i++) {
+        page_id_t page_id;
+        Page *page = buffer_pool_manager_->NewPage(page_id);
+        if (page == nullptr) { throw std::runtime_error("Out of memory error! Can't allocate a new page for bulk load!"); }
+        auto *leaf_node = reinterpret_cast<LeafPage *>(page->GetData());
+        leaf_node->Init(page_id, INVALID_PAGE_ID, key_size, leaf_max_size_, processor_.IsPackable());
+        int size = BulkLoadPageSize(count, leaf_count, i);
+        for (int j = 0; j < size; j++) {
+            // Keys strictly increase, across leaves too.
+            const GenericKey *last_key = nullptr;
+            if (j > 0) {
+                last_key = leaf_node->KeyAt(j - 1);
+            } else if (prev_leaf != nullptr) {
+                last_key = prev_leaf->KeyAt(prev_leaf->GetSize() - 1);
+            }
+            if (!next(key, &value) || (last_key != nullptr && processor_.CompareKeys(last_key, key) >= 0)) {
+                ordered = false;
+                break;
+            }
+            leaf_node->SetKeyAt(j, key);
+            leaf_node->SetValueAt(j, value);
+            leaf_node->IncreaseSize(1);
+        }
+        memcpy(&leaf_keys[i * key_size], leaf_node->KeyAt(0), key_size);
+        leaves.push_back(page_id);
+        if (prev_leaf != nullptr) {
+            prev_leaf->SetNextPageId(page_id);
+            buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+        }
+        prev_leaf = leaf_node;
+    }
+    buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+    free(key);
+
+    if (!ordered) { // Nothing links to the leaves yet, drop them.
+        for (page_id_t page_id : leaves) {
+            buffer_pool_manager_->DeletePage(page_id);
+        }
+        root_latch_.WUnlock();
+        return false;
+    }
+
+    root_page_id_ = BulkLoadInternals(std::move(leaves), std::move(leaf_keys), fill_factor);
+    UpdateRootPageId(1);
+    root_latch_.WUnlock();
+    return true;
+}
+
+page_id_t BPlusTree::BulkLoadInternals(std::vector<page_id_t> children, std::vector<char> child_keys,
+                                       double fill_factor) {
+    int key_size = processor_.GetKeySize();
+    while (children.size() > 1) {
+        size_t page_count = BulkLoadPageCount(children.size(), internal_max_size_, internal_max_size_ / 2, fill_factor);
+        std::vector<page_id_t> pages;
+        std::vector<char> page_keys(page_count * key_size);
+        size_t child = 0;
+        for (size_t i = 0; i < page_count; i++) {
+            page_id_t page_id;
+            Page *page = buffer_pool_manager_->NewPage(page_id);
+            if (page == nullptr) { throw std::runtime_error("Out of memory error! Can't allocate a new page for bulk load!"); }
+            auto *internal_node = reinterpret_cast<InternalPage *>(page->GetData());
+            internal_node->Init(page_id, INVALID_PAGE_ID, key_size, internal_max_size_, processor_.IsPackable());
+            int size = BulkLoadPageSize(children.size(), page_count, i);
+            // The first key is never searched, it keeps the first key of the subtree as after a split.
+            for (int j = 0; j < size; j++, child++) {
+                internal_node->SetKeyAt(j, reinterpret_cast<GenericKey *>(&child_keys[child * key_size]));
+                internal_node->SetValueAt(j, children[child]);
+                Page *child_page = buffer_pool_manager_->FetchPage(children[child]);
+                reinterpret_cast<BPlusTreePage *>(child_page->GetData())->SetParentPageId(page_id);
+                buffer_pool_manager_->UnpinPage(children[child], true);
+            }
+            internal_node->SetSize(size);
+            memcpy(&page_keys[i * key_size], internal_node->KeyAt(0), key_size);
+            pages.push_back(page_id);
+            buffer_pool_manager_->UnpinPage(page_id, true);
+        }
+        children = std::move(pages);
+        child_keys = std::move(page_keys);
+    }
+    return children[0];
+}
+
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
@@ -283,53 +441,67 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
  * necessary.
  */
 void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
-    if (IsEmpty()) { return; }
-
-    // Find the right leaf page as deletion target.
-    Page *leaf_page = FindLeafPage(key, root_page_id_, false);
-    if (leaf_page == nullptr) { return; }
+    // Optimistic: most deletions leave their leaf at least half full, which is then the only page to write latch.
+    Page *leaf_page = FindLeafPageOptimistic(key, false, true);
+    if (leaf_page == nullptr) { return; } // Empty tree.
     auto *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    int key_index = leaf_node->KeyIndex(key, processor_);
+    bool found = key_index < leaf_node->GetSize() && processor_.CompareKeys(key, leaf_node->KeyAt(key_index)) == 0;
+    bool safe = IsSafe(leaf_node, Operation::kRemove);
+    if (found && safe) {
+        leaf_node->RemoveAndDeleteRecord(key, processor_);
+    }
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), found && safe);
+    if (!found || safe) { return; }
+
+    // Pessimistic: the leaf underflows. Pages may be merged away, which no iterator may be on.
+    scan_gate_.EnterMerge();
+    std::vector<Page *> latched;
+    bool root_latched = false;
+    std::vector<page_id_t> deleted;
+    leaf_page = FindLeafPagePessimistic(key, Operation::kRemove, latched, root_latched);
+    if (leaf_page != nullptr) {
+        RemoveFromLeaf(reinterpret_cast<LeafPage *>(leaf_page->GetData()), key, deleted, transaction);
+    }
+    ReleaseLatches(latched, root_latched, true);
+    DeletePages(deleted);
+    scan_gate_.ExitMerge();
+}
 
-    int size_before_delete = leaf_node->GetSize();
-    
+void BPlusTree::DeletePages(const std::vector<page_id_t> &deleted) {
+    // Unreachable from the tree, and no longer pinned by the descent. Readers that saw them before they were merged
+    // away unpin them right after unlatching them.
+    std::scoped_lock<std::mutex> lock(deleted_latch_);
+    deleted_pages_.insert(deleted_pages_.end(), deleted.begin(), deleted.end());
+    auto pinned = deleted_pages_.begin();
+    for (page_id_t page_id : deleted_pages_) {
+        if (!buffer_pool_manager_->DeletePage(page_id)) {
+            *pinned++ = page_id;
+        }
+    }
+    deleted_pages_.erase(pinned, deleted_pages_.end());
+}
+
+/*
+ * Delete key & value pair from the leaf page, which is the right one for key,
+ * write latched with every page a merge would change and pinned by the caller.
+ * Redistribute or merge if necessary.
+ */
+void BPlusTree::RemoveFromLeaf(LeafPage *leaf_node, const GenericKey *key, std::vector<page_id_t> &deleted,
+                               Txn *transaction) {
     // Get key index.
     int key_index = leaf_node->KeyIndex(key, processor_);
-    if (processor_.CompareKeys(key, leaf_node->KeyAt(key_index)) != 0) { // Not found.
-        buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), false);
-        return; 
+    if (key_index >= leaf_node->GetSize() || processor_.CompareKeys(key, leaf_node->KeyAt(key_index)) != 0) {
+        return; // Not found.
     }
 
     // Remove key_index.
     leaf_node->RemoveAndDeleteRecord(key, processor_);
 
-    bool unpin_dirty = true; // Mark if the page still needs unpinning.
-
-    // Redistribute or merge(coalesce).
+    // Redistribute or merge(coalesce). A root leaf left empty is deleted by AdjustRoot().
     if (leaf_node->GetSize() < leaf_node->GetMinSize()) {
-        // The BPlusTree::CoalesceOrRedistribute() function is supposed to handle unpinning of the node it processes/deletes.
-        bool node_deleted = CoalesceOrRedistribute(leaf_node, transaction);
-        if (node_deleted) { unpin_dirty = false; }
-    }
-
-    // Make sure the page is unpinned.
-    if (unpin_dirty && leaf_page->GetPageId() == leaf_node->GetPageId()) 
-        buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), true);
-    else if (!unpin_dirty) {}  // The page is already handled. 
-    else // Not supposed to get here.
-        buffer_pool_manager_->UnpinPage(leaf_node->GetPageId(), true);
-
-    // Check if root has became empty.  
-    if (!IsEmpty()) {
-        Page *root_page = buffer_pool_manager_->FetchPage(root_page_id_);
-        auto *root_node = reinterpret_cast<BPlusTreePage *>(root_page->GetData());
-        if (root_node->IsLeafPage() && root_node->GetSize() == 0) {
-            buffer_pool_manager_->UnpinPage(root_page_id_, false);
-            buffer_pool_manager_->DeletePage(root_page_id_);
-            root_page_id_ = INVALID_PAGE_ID;
-            UpdateRootPageId();
-        } else {
-            buffer_pool_manager_->UnpinPage(root_page_id_, false);
-        }
+        CoalesceOrRedistribute(leaf_node, deleted, transaction);
     }
 }
 
@@ -341,15 +513,16 @@ void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
  * deletion happens
  */
 template <typename N>
-bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
+bool BPlusTree::CoalesceOrRedistribute(N *&node, std::vector<page_id_t> &deleted, Txn *transaction) {
     /**
      * 1. If the node is smaller than the minimum size(underflow):
      *    - Try to borrow from siblings(Redistribute);
      *    - If can't, merge the node with its sibiling(Coalesce).
      * 2. If Coalesce causes underflowing in parent node, recursively handling parent nodes.
      */
-    if (node->IsRootPage()) { return AdjustRoot(node); }
+    if (node->IsRootPage()) { return AdjustRoot(node, deleted); }
 
+    // The parent is write latched by the caller as the node is not safe, the siblings are latched here.
     Page *parent_page = buffer_pool_manager_->FetchPage(node->GetParentPageId());
     auto *parent_node = reinterpret_cast<InternalPage *>(parent_page->GetData());
     // Get the index in its parent node.
@@ -362,6 +535,7 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
     if (index_in_parent > 0) { // Not the first one -> must have a left sibling.
         page_id_t left_sibling_page_id = parent_node->ValueAt(index_in_parent - 1);
         left_sibling_page = buffer_pool_manager_->FetchPage(left_sibling_page_id);
+        left_sibling_page->WLatch();
         left_sibling_node = reinterpret_cast<N *>(left_sibling_page->GetData());
 
         if (left_sibling_node->GetSize() > left_sibling_node->GetMinSize()) { // At least one element can be borrowed from the left sibling node.
@@ -376,6 +550,7 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
             // Redistribute(left_sibling_node, node, index_in_parent);
             Redistribute(left_sibling_node, node, 1);
             buffer_pool_manager_->UnpinPage(parent_node->GetPageId(), true);
+            left_sibling_page->WUnlatch();
             buffer_pool_manager_->UnpinPage(left_sibling_node->GetPageId(), true);
             return false; // Not need for deleting node.
         }
@@ -387,15 +562,19 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
     if (index_in_parent < parent_node->GetSize() - 1) { // Not the last one -> must have a right sibling.
         page_id_t right_sibling_page_id = parent_node->ValueAt(index_in_parent + 1);
         right_sibling_page = buffer_pool_manager_->FetchPage(right_sibling_page_id);
+        right_sibling_page->WLatch();
         right_sibling_node = reinterpret_cast<N *>(right_sibling_page->GetData());
 
         if (right_sibling_node->GetSize() > right_sibling_node->GetMinSize()) { // At least one element can be borrowed from the right sibling node.
             // Redistribute(right_sibling_node, node, index_in_parent + 1);
             Redistribute(right_sibling_node, node, 0);
             buffer_pool_manager_->UnpinPage(parent_node->GetPageId(), true);
+            right_sibling_page->WUnlatch();
             buffer_pool_manager_->UnpinPage(right_sibling_node->GetPageId(), true);
-            if (left_sibling_page) // If fechted but not used, unpin it.
+            if (left_sibling_page) { // If fechted but not used, unpin it.
+                left_sibling_page->WUnlatch();
                 buffer_pool_manager_->UnpinPage(left_sibling_page->GetPageId(), false);
+            }
             return false; // Not need for deleting node.
         }
     }
@@ -403,20 +582,28 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
     // Coalesce
     bool coalesce_with_left = false;
     if (left_sibling_node) { // Coalesce with left sibling.
-        Coalesce(left_sibling_node, node, parent_node, index_in_parent, transaction);
+        Coalesce(left_sibling_node, node, parent_node, index_in_parent, deleted, transaction);
+        left_sibling_page->WUnlatch();
         buffer_pool_manager_->UnpinPage(left_sibling_node->GetPageId(), true);
-        if (right_sibling_page) 
+        if (right_sibling_page) {
+            right_sibling_page->WUnlatch();
             buffer_pool_manager_->UnpinPage(right_sibling_page->GetPageId(), false);
+        }
         return true; // Merge this node into the left sibling.
     } else if (right_sibling_node) {  // Coalesce with right sibling.(only the first node)
-        Coalesce(node, right_sibling_node, parent_node, index_in_parent + 1, transaction);
+        Coalesce(node, right_sibling_node, parent_node, index_in_parent + 1, deleted, transaction);
+        right_sibling_page->WUnlatch();
         buffer_pool_manager_->UnpinPage(right_sibling_node->GetPageId(), true);
         return false;
     } else { // Should not happen.
-        if (left_sibling_page) 
+        if (left_sibling_page) {
+            left_sibling_page->WUnlatch();
             buffer_pool_manager_->UnpinPage(left_sibling_page->GetPageId(), false);
-        if (right_sibling_page)
+        }
+        if (right_sibling_page) {
+            right_sibling_page->WUnlatch();
             buffer_pool_manager_->UnpinPage(right_sibling_page->GetPageId(), false);
+        }
         buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), false);
         return false; // Merge the right sibling into this node.
     }
@@ -436,15 +623,17 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
  * @return  true means parent node should be deleted, false means no deletion happened
  */
 bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage *&parent, int index,
-                         Txn *transaction) {
+                         std::vector<page_id_t> &deleted, Txn *transaction) {
     node->MoveAllTo(neighbor_node);
     neighbor_node->SetNextPageId(node->GetNextPageId());
     parent->Remove(index);
-    buffer_pool_manager_->DeletePage(node->GetPageId());
+    deleted.push_back(node->GetPageId());
 
-    // If parent node underflows.
+    // If parent node underflows. The parent stays pinned by the descent, drop the pin CoalesceOrRedistribute() took.
     if (parent->GetSize() < parent->GetMinSize()) {
-        return CoalesceOrRedistribute<BPlusTree::InternalPage>(parent, transaction);
+        bool parent_deleted = CoalesceOrRedistribute<BPlusTree::InternalPage>(parent, deleted, transaction);
+        buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
+        return parent_deleted;
     } else {
         buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
         return false;
@@ -452,15 +641,17 @@ bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage
 }
 
 bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, InternalPage *&parent, int index,
-                         Txn *transaction) {
+                         std::vector<page_id_t> &deleted, Txn *transaction) {
     GenericKey *key_from_parent = parent->KeyAt(index);
     node->MoveAllTo(neighbor_node, key_from_parent, buffer_pool_manager_);
     parent->Remove(index);
-    buffer_pool_manager_->DeletePage(node->GetPageId());
+    deleted.push_back(node->GetPageId());
 
-    // If parent node underflows.                       
+    // If parent node underflows. The parent stays pinned by the descent, drop the pin CoalesceOrRedistribute() took.
     if (parent->GetSize() < parent->GetMinSize()) {
-        return CoalesceOrRedistribute<BPlusTree::InternalPage>(parent, transaction);
+        bool parent_deleted = CoalesceOrRedistribute<BPlusTree::InternalPage>(parent, deleted, transaction);
+        buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
+        return parent_deleted;
     } else {
         buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
         return false;
@@ -487,7 +678,7 @@ void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, int index)
         neighbor_node->MoveFirstToEndOf(node);
         parent_node->SetKeyAt(parent_node->ValueIndex(neighbor_node->GetPageId()), neighbor_node->KeyAt(0));
     }
-    // Unpinned by the caller.
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
 }
 void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, int index) {
     Page *parent_page = buffer_pool_manager_->FetchPage(node->GetParentPageId());
@@ -495,16 +686,23 @@ void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, in
 
     if (index != 0) {  // Sibling is left node.
         int middle_key_index = parent_node->ValueIndex(node->GetPageId());
+        // The last key of the sibling separates the two nodes after the move.
+        GenericKey *new_middle_key = processor_.InitKey();
+        memcpy(new_middle_key, neighbor_node->KeyAt(neighbor_node->GetSize() - 1), processor_.GetKeySize());
         neighbor_node->MoveLastToFrontOf(node,
                                          parent_node->KeyAt(middle_key_index),
                                          buffer_pool_manager_);
+        parent_node->SetKeyAt(middle_key_index, new_middle_key);
+        free(new_middle_key);
     } else {  // Sibling is right node.
         int middle_key_index = parent_node->ValueIndex(neighbor_node->GetPageId());
         neighbor_node->MoveFirstToEndOf(node,
                                         parent_node->KeyAt(middle_key_index),
                                         buffer_pool_manager_);
+        // The second key of the sibling, now its first, separates the two nodes.
+        parent_node->SetKeyAt(middle_key_index, neighbor_node->KeyAt(0));
     }
-    // Unpinned by the caller.
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
 }
 /*
  * Update root page if necessary
@@ -516,10 +714,10 @@ void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, in
  * @return : true means root page should be deleted, false means no deletion
  * happened
  */
-bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
+bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node, std::vector<page_id_t> &deleted) {
     if (old_root_node->IsLeafPage()) {
         if (old_root_node->GetSize() == 0) {
-            buffer_pool_manager_->DeletePage(old_root_node->GetPageId());
+            deleted.push_back(old_root_node->GetPageId());
             root_page_id_ = INVALID_PAGE_ID;
             UpdateRootPageId();
             return true; // Root has deleted.
@@ -529,8 +727,8 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
          * Internal root case, where for a internal node, there is no key left but a child.
          * In this case, we need to set the child as the new root.
          */
-        auto *internal_root_node = reinterpret_cast<InternalPage *>(old_root_node->GetPageId());
-        if (internal_root_node->GetSize() == 0) {
+        auto *internal_root_node = reinterpret_cast<InternalPage *>(old_root_node);
+        if (internal_root_node->GetSize() == 1) {
             root_page_id_ = internal_root_node->ValueAt(0); // The child becomes the new root.
             UpdateRootPageId();
             // Set the parent_id of the new root as INVALID_PAGE_ID.
@@ -539,7 +737,7 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
             new_root_node->SetParentPageId(INVALID_PAGE_ID);
             buffer_pool_manager_->UnpinPage(root_page_id_, true);
             // Delete the old one.
-            buffer_pool_manager_->DeletePage(old_root_node->GetPageId());
+            deleted.push_back(old_root_node->GetPageId());
             return true; // Root has deleted.
         }
     }
@@ -556,13 +754,16 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin() {
-    if (IsEmpty()) { return End(); }
-    Page *leaf_page = FindLeafPage(nullptr, root_page_id_, true);
-    if (leaf_page == nullptr) { return End(); }
-
-    // Construct the iterator.
-    IndexIterator iter(leaf_page->GetPageId(), buffer_pool_manager_, 0);
+    scan_gate_.EnterScan();
+    Page *leaf_page = FindLeafPageOptimistic(nullptr, true, false);
+    if (leaf_page == nullptr) {
+        scan_gate_.ExitScan();
+        return End();
+    }
+    leaf_page->RUnlatch();
 
+    // Construct the iterator, which takes over the scan.
+    IndexIterator iter(leaf_page->GetPageId(), buffer_pool_manager_, &processor_, nullptr, &scan_gate_);
     buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
     
     return iter;
@@ -574,24 +775,17 @@ IndexIterator BPlusTree::Begin() {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin(const GenericKey *key) {
-    if (IsEmpty()) { return End(); }
-    Page *leaf_page = FindLeafPage(key, root_page_id_, false);
-    if (leaf_page == nullptr) { return End(); }
-    auto *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
-    int key_index = leaf_node->KeyIndex(key, processor_);
-
-    // LeafPage::KeyIndex() returns GetSize() when key is larger then every one in the page
-    // When key_index == GetSize(), it should not be used to construct the iterator
-    if (key_index == leaf_node->GetSize()) {
-        if (leaf_node->GetNextPageId() == INVALID_PAGE_ID) {
-            buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
-            return End();
-        }
+    scan_gate_.EnterScan();
+    Page *leaf_page = FindLeafPageOptimistic(key, false, false);
+    if (leaf_page == nullptr) {
+        scan_gate_.ExitScan();
+        return End();
     }
+    leaf_page->RUnlatch();
 
-    // Construct the iterator.
-    IndexIterator iter(leaf_page->GetPageId(), buffer_pool_manager_, key_index);
-
+    // Construct the iterator, which takes over the scan. It looks for key in the leaf itself, the leaf may change as
+    // soon as it is unlatched.
+    IndexIterator iter(leaf_page->GetPageId(), buffer_pool_manager_, &processor_, key, &scan_gate_);
     buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
 
     return iter;
@@ -618,7 +812,7 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
     if (IsEmpty()) { return nullptr; }
     
     // If page_id is not provided or invalid, use root_page_id_.
-    page_id_t cur_page_id = (page_id == INVALID_PAGE_ID || page_id == 0) ? root_page_id_ : page_id;
+    page_id_t cur_page_id = (page_id == INVALID_PAGE_ID || page_id == 0) ? root_page_id_.load() : page_id;
     if (cur_page_id == INVALID_PAGE_ID) { return nullptr; }
 
     Page *page = buffer_pool_manager_->FetchPage(cur_page_id);
@@ -643,6 +837,97 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
     return page;
 }
 
+/*
+ * Find leaf page containing particular key, or the left most one, for a
+ * lookup or an optimistic modification: crab read latches down, taking the
+ * latch of a child before releasing the one of its parent, root_latch_ for the
+ * root. The leaf is latched for reading, or for writing if write_leaf.
+ * Note: the leaf page is pinned and latched, you need to unlatch and unpin it after use.
+ */
+Page *BPlusTree::FindLeafPageOptimistic(const GenericKey *key, bool left_most, bool write_leaf) {
+    root_latch_.RLock();
+    if (IsEmpty()) {
+        root_latch_.RUnlock();
+        return nullptr;
+    }
+    Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+    page->RLatch();
+    Page *parent_page = nullptr; // Still latched while page is latched, nullptr for root_latch_.
+
+    while (true) {
+        auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+        if (node->IsLeafPage() && write_leaf) {
+            // The parent is still latched, so the page stays the leaf for key while its latch is traded.
+            page->RUnlatch();
+            page->WLatch();
+        }
+        if (parent_page == nullptr) {
+            root_latch_.RUnlock();
+        } else {
+            parent_page->RUnlatch();
+            buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), false);
+        }
+        if (node->IsLeafPage()) { return page; }
+
+        auto *internal_node = reinterpret_cast<InternalPage *>(node);
+        page_id_t child_page_id = left_most ? internal_node->ValueAt(0) : internal_node->Lookup(key, processor_);
+        parent_page = page;
+        page = buffer_pool_manager_->FetchPage(child_page_id);
+        page->RLatch();
+    }
+}
+
+/*
+ * Find leaf page containing particular key for a modification that may split
+ * or merge pages: write latch from the root down, and release the pages above
+ * a safe node, which the modification can not reach.
+ */
+Page *BPlusTree::FindLeafPagePessimistic(const GenericKey *key, Operation op, std::vector<Page *> &latched,
+                                         bool &root_latched) {
+    root_latch_.WLock();
+    root_latched = true;
+    if (IsEmpty()) { return nullptr; }
+
+    Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+    while (true) {
+        page->WLatch();
+        auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+        if (IsSafe(node, op)) {
+            ReleaseLatches(latched, root_latched, false);
+        }
+        latched.push_back(page);
+        if (node->IsLeafPage()) { return page; }
+        page = buffer_pool_manager_->FetchPage(reinterpret_cast<InternalPage *>(node)->Lookup(key, processor_));
+    }
+}
+
+/*
+ * Unlatch and unpin the pages of a pessimistic descent, top down.
+ */
+void BPlusTree::ReleaseLatches(std::vector<Page *> &latched, bool &root_latched, bool is_dirty) {
+    if (root_latched) {
+        root_latch_.WUnlock();
+        root_latched = false;
+    }
+    for (Page *page : latched) {
+        page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), is_dirty);
+    }
+    latched.clear();
+}
+
+/*
+ * A node is safe for an insertion if it has room for one more pair, and for a
+ * deletion if it stays at least half full without one, so that a split or a
+ * merge below it stops there.
+ */
+bool BPlusTree::IsSafe(const BPlusTreePage *node, Operation op) const {
+    if (op == Operation::kInsert) {
+        return node->GetSize() < node->GetMaxSize();
+    }
+    return node->GetSize() > node->GetMinSize();
+}
+
 /*
  * Update/Insert root page id in header page(where page_id = INDEX_ROOTS_PAGE_ID,
  * header_page is defined under include/page/header_page.h)
@@ -658,12 +943,15 @@ void BPlusTree::UpdateRootPageId(int insert_record) {
     }
     auto *index_roots_page = reinterpret_cast<IndexRootsPage *>(header_page->GetData());
 
+    // Every index keeps its root in this page, and they change it concurrently.
+    header_page->WLatch();
     if (insert_record == 1) // Insert a new root.
         index_roots_page->Insert(index_id_, root_page_id_);
     else if (root_page_id_ == INVALID_PAGE_ID) // Tree deleted.
         index_roots_page->Delete(index_id_);
     else // Root page_id changed.
         index_roots_page->Update(index_id_, root_page_id_);
+    header_page->WUnlatch();
 
     buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
 }
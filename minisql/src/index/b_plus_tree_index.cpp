@@ -1,5 +1,6 @@
 #include "index/b_plus_tree_index.h"
 
+#include "index/external_sorter.h"
 #include "index/generic_key.h"
 #include "utils/tree_file_mgr.h"
 #include <fstream>
@@ -93,6 +94,38 @@ dberr_t BPlusTreeIndex::Destroy() {
   return DB_SUCCESS;
 }
 
+dberr_t BPlusTreeIndex::BulkLoad(const std::function<bool(Row *key, RowId *row_id)> &next, Txn *txn) {
+  if (!container_.IsEmpty()) {
+    return Index::BulkLoad(next, txn);
+  }
+  uint32_t key_size = processor_.GetKeySize();
+  ExternalSorter sorter(key_size + sizeof(RowId), key_size);
+  std::vector<char> record(key_size + sizeof(RowId));
+  Row key;
+  RowId row_id;
+  while (next(&key, &row_id)) {
+    processor_.SerializeFromKey(reinterpret_cast<GenericKey *>(record.data()), key, key_schema_);
+    memcpy(record.data() + key_size, &row_id, sizeof(RowId));
+    if (!sorter.Add(record.data())) {
+      return DB_FAILED;
+    }
+  }
+  if (!sorter.Sort()) {
+    return DB_FAILED;
+  }
+  bool status = container_.BulkLoad(sorter.GetCount(), [&](GenericKey *index_key, RowId *value) {
+    const char *sorted = sorter.Next();
+    if (sorted == nullptr) {
+      return false;
+    }
+    memcpy(index_key, sorted, key_size);
+    memcpy(value, sorted + key_size, sizeof(RowId));
+    return true;
+  });
+  // Duplicate keys make the bulk load fail, as they would fail an insert.
+  return status ? DB_SUCCESS : DB_FAILED;
+}
+
 IndexIterator BPlusTreeIndex::GetBeginIterator() {
   return container_.Begin();
 }
@@ -0,0 +1,149 @@
+#include "index/external_sorter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr size_t WRITE_BLOCK_SIZE = 1 << 16;  // bytes of a run written with one fwrite
+constexpr size_t INITIAL_CAPACITY = 1024;     // records the buffer starts with, it doubles up to the capacity
+
+}  // namespace
+
+ExternalSorter::ExternalSorter(uint32_t record_size, uint32_t key_size, size_t memory_size)
+    : record_size_(record_size),
+      key_size_(key_size),
+      capacity_(std::max<size_t>(1, memory_size / (record_size + sizeof(Entry)))) {
+  ASSERT(key_size <= record_size, "Key larger than the record.");
+}
+
+ExternalSorter::~ExternalSorter() {
+  for (auto &run : runs_) {
+    fclose(run.file_);
+  }
+}
+
+bool ExternalSorter::Add(const char *record) {
+  ASSERT(!sorted_, "Record added after Sort.");
+  if (entries_.size() == capacity_ && !WriteRun()) {
+    return false;
+  }
+  size_t offset = entries_.size() * record_size_;
+  if (offset + record_size_ > buffer_.size()) {
+    buffer_.resize(std::min(capacity_, std::max(INITIAL_CAPACITY, 2 * entries_.size())) * record_size_);
+  }
+  memcpy(&buffer_[offset], record, record_size_);
+  uint64_t prefix = 0;
+  memcpy(&prefix, record, std::min<size_t>(key_size_, sizeof(prefix)));
+  entries_.push_back({__builtin_bswap64(prefix), static_cast<uint32_t>(offset)});
+  count_++;
+  return true;
+}
+
+void ExternalSorter::SortBuffer() {
+  const char *buffer = buffer_.data();
+  std::sort(entries_.begin(), entries_.end(), [&](const Entry &lhs, const Entry &rhs) {
+    if (lhs.prefix_ != rhs.prefix_) {
+      return lhs.prefix_ < rhs.prefix_;
+    }
+    return key_size_ > sizeof(uint64_t) &&
+           memcmp(buffer + lhs.offset_ + sizeof(uint64_t), buffer + rhs.offset_ + sizeof(uint64_t),
+                  key_size_ - sizeof(uint64_t)) < 0;
+  });
+}
+
+bool ExternalSorter::WriteRun() {
+  SortBuffer();
+  FILE *file = tmpfile();
+  if (file == nullptr) {
+    return false;
+  }
+  runs_.push_back({file, nullptr, 0, 0});
+  // gather the records in order into blocks, so that they are written with a few large writes
+  std::vector<char> block(std::max<size_t>(WRITE_BLOCK_SIZE / record_size_, 1) * record_size_);
+  size_t filled = 0;
+  for (const auto &entry : entries_) {
+    memcpy(&block[filled], &buffer_[entry.offset_], record_size_);
+    filled += record_size_;
+    if (filled == block.size()) {
+      if (fwrite(block.data(), 1, filled, file) != filled) {
+        return false;
+      }
+      filled = 0;
+    }
+  }
+  if ((filled > 0 && fwrite(block.data(), 1, filled, file) != filled) || fflush(file) != 0) {
+    return false;
+  }
+  entries_.clear();
+  return true;
+}
+
+bool ExternalSorter::Sort() {
+  sorted_ = true;
+  if (runs_.empty()) {
+    SortBuffer();
+    return true;
+  }
+  if (!entries_.empty() && !WriteRun()) {
+    return false;
+  }
+  // the memory of the records now holds a part of every run
+  size_t run_capacity = std::max<size_t>(1, capacity_ / runs_.size());
+  buffer_.resize(runs_.size() * run_capacity * record_size_);
+  buffer_.shrink_to_fit();
+  entries_.clear();
+  entries_.shrink_to_fit();
+  for (size_t i = 0; i < runs_.size(); i++) {
+    runs_[i].buffer_ = &buffer_[i * run_capacity * record_size_];
+    rewind(runs_[i].file_);
+  }
+  run_capacity_ = run_capacity;
+  auto greater = [&](size_t lhs, size_t rhs) { return Less(Current(runs_[rhs]), Current(runs_[lhs])); };
+  for (size_t i = 0; i < runs_.size(); i++) {
+    if (Current(runs_[i]) != nullptr) {
+      heap_.push_back(i);
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    }
+  }
+  return true;
+}
+
+const char *ExternalSorter::Current(Run &run) {
+  if (run.position_ == run.buffered_) {
+    run.buffered_ = fread(run.buffer_, record_size_, run_capacity_, run.file_);
+    run.position_ = 0;
+    if (run.buffered_ == 0) {
+      return nullptr;
+    }
+  }
+  return run.buffer_ + run.position_ * record_size_;
+}
+
+const char *ExternalSorter::Next() {
+  ASSERT(sorted_, "Next called before Sort.");
+  if (runs_.empty()) {
+    return next_ < entries_.size() ? &buffer_[entries_[next_++].offset_] : nullptr;
+  }
+  auto greater = [&](size_t lhs, size_t rhs) { return Less(Current(runs_[rhs]), Current(runs_[lhs])); };
+  // The run of the record returned last was left at the back of heap_, out of the heap: move past that record now
+  // that it is no longer used, and put the run back unless it is exhausted.
+  if (returned_) {
+    returned_ = false;
+    Run &last = runs_[heap_.back()];
+    last.position_++;
+    if (Current(last) != nullptr) {
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    } else {
+      heap_.pop_back();
+    }
+  }
+  if (heap_.empty()) {
+    return nullptr;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), greater);
+  returned_ = true;
+  return Current(runs_[heap_.back()]);
+}
+
+bool ExternalSorter::Less(const char *lhs, const char *rhs) const { return memcmp(lhs, rhs, key_size_) < 0; }
@@ -0,0 +1,113 @@
+#include "index/generic_key.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr uint32_t CHAR_LENGTH_SIZE = 2;  // bytes of the length stored after the characters of a char column
+
+inline void WriteBigEndian(char *buf, uint32_t value) {
+  buf[0] = static_cast<char>(value >> 24);
+  buf[1] = static_cast<char>(value >> 16);
+  buf[2] = static_cast<char>(value >> 8);
+  buf[3] = static_cast<char>(value);
+}
+
+inline uint32_t ReadBigEndian(const char *buf) {
+  auto bytes = reinterpret_cast<const unsigned char *>(buf);
+  return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+         static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+}
+
+/** @return the bytes a column takes in a key, without its null marker */
+inline uint32_t EncodedColumnSize(const Column *column) {
+  return column->GetType() == kTypeChar ? column->GetLength() + CHAR_LENGTH_SIZE : sizeof(uint32_t);
+}
+
+}  // namespace
+
+uint32_t KeyManager::GetEncodedSize(const Schema *key_schema) {
+  uint32_t size = 0;
+  for (auto column : key_schema->GetColumns()) {
+    size += 1 + EncodedColumnSize(column);
+  }
+  return size;
+}
+
+void KeyManager::SerializeFromKey(GenericKey *key_buf, const Row &key, Schema *schema) const {
+  ASSERT(key.GetFieldCount() == schema->GetColumnCount(), "field nums not match.");
+  ASSERT(GetEncodedSize(schema) <= (uint32_t)key_size_, "Index key size exceed max key size.");
+  // initialize to 0, which is also how nulls and the padding of chars are stored
+  memset(key_buf->data, 0, key_size_);
+  char *buf = key_buf->data;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    const Column *column = schema->GetColumn(i);
+    const Field *field = key.GetField(i);
+    uint32_t size = EncodedColumnSize(column);
+    if (field->IsNull()) {
+      buf += 1 + size;
+      continue;
+    }
+    *buf++ = 1;
+    switch (column->GetType()) {
+      case kTypeInt:
+        WriteBigEndian(buf, static_cast<uint32_t>(field->value_.integer_) ^ 0x80000000u);
+        break;
+      case kTypeFloat: {
+        // -0 and 0 are equal, and so have to be their keys
+        float value = field->value_.float_ == 0.0f ? 0.0f : field->value_.float_;
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        WriteBigEndian(buf, bits & 0x80000000u ? ~bits : bits ^ 0x80000000u);
+        break;
+      }
+      case kTypeChar: {
+        // A value longer than the column, such as the constant of a predicate, keeps its real length: past the
+        // characters that fit it then sorts after every value the column can hold, as it should.
+        uint32_t len = std::min<uint32_t>(field->len_, 0xFFFF);
+        memcpy(buf, field->value_.chars_, std::min(len, column->GetLength()));
+        buf[column->GetLength()] = static_cast<char>(len >> 8);
+        buf[column->GetLength() + 1] = static_cast<char>(len);
+        break;
+      }
+      default:
+        ASSERT(false, "Invalid type.");
+    }
+    buf += size;
+  }
+}
+
+void KeyManager::DeserializeToKey(const GenericKey *key_buf, Row &key, Schema *schema) const {
+  key.destroy();
+  auto &fields = key.GetFields();
+  const char *buf = key_buf->data;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    const Column *column = schema->GetColumn(i);
+    uint32_t size = EncodedColumnSize(column);
+    if (*buf++ == 0) {
+      fields.push_back(new Field(column->GetType()));
+      buf += size;
+      continue;
+    }
+    switch (column->GetType()) {
+      case kTypeInt:
+        fields.push_back(new Field(kTypeInt, static_cast<int32_t>(ReadBigEndian(buf) ^ 0x80000000u)));
+        break;
+      case kTypeFloat: {
+        uint32_t bits = ReadBigEndian(buf);
+        bits = bits & 0x80000000u ? bits ^ 0x80000000u : ~bits;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        fields.push_back(new Field(kTypeFloat, value));
+        break;
+      }
+      default: {
+        auto len_bytes = reinterpret_cast<const unsigned char *>(buf + column->GetLength());
+        uint32_t len = std::min(static_cast<uint32_t>(len_bytes[0]) << 8 | len_bytes[1], column->GetLength());
+        fields.push_back(new Field(kTypeChar, const_cast<char *>(buf), len, true));
+        break;
+      }
+    }
+    buf += size;
+  }
+}
@@ -1,25 +1,155 @@
 #include "index/index_iterator.h"
 
+#include <cstring>
+#include <unordered_map>
+
 #include "index/basic_comparator.h"
 #include "index/generic_key.h"
 
+namespace {
+// scans the current thread runs, per gate, a gate leaves once its last scan of the thread ended
+thread_local std::unordered_map<const ScanGate *, int> scans_held;
+}  // namespace
+
+void ScanGate::EnterScan() {
+  std::unique_lock<std::mutex> lock(latch_);
+  auto held = scans_held.find(this);
+  cv_.wait(lock, [this, &held] { return merges_ == 0 && (waiting_merges_ == 0 || held != scans_held.end()); });
+  scans_++;
+  scans_held[this]++;
+}
+
+void ScanGate::ExitScan() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto held = scans_held.find(this);
+  if (--held->second == 0) {
+    scans_held.erase(held);
+  }
+  if (--scans_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+void ScanGate::EnterMerge() {
+  std::unique_lock<std::mutex> lock(latch_);
+  waiting_merges_++;
+  cv_.wait(lock, [this] { return scans_ == 0; });
+  waiting_merges_--;
+  merges_++;
+}
+
+void ScanGate::ExitMerge() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (--merges_ == 0) {
+    cv_.notify_all();
+  }
+}
+
 IndexIterator::IndexIterator() = default;
 
-IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index)
-    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm) {
-  page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
+IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, const KeyManager *processor,
+                             const GenericKey *key, ScanGate *gate)
+    : current_page_id(page_id),
+      buffer_pool_manager(bpm),
+      gate_(gate),
+      processor_(processor),
+      key_(new char[processor->GetKeySize()]) {
+  current_page = buffer_pool_manager->FetchPage(current_page_id);
+  page = reinterpret_cast<LeafPage *>(current_page->GetData());
+  current_page->RLatch();
+  page_id_t next_page_id = page->GetNextPageId();
+  current_page->RUnlatch();
+  if (next_page_id != INVALID_PAGE_ID)
+    buffer_pool_manager->Prefetch(next_page_id);
+  if (key != nullptr)
+    memcpy(key_.get(), key, processor_->GetKeySize());
+  Seek(key == nullptr, false);
+}
+
+IndexIterator::IndexIterator(IndexIterator &&other) noexcept
+    : current_page_id(other.current_page_id),
+      page(other.page),
+      item_index(other.item_index),
+      buffer_pool_manager(other.buffer_pool_manager),
+      current_page(other.current_page),
+      gate_(other.gate_),
+      processor_(other.processor_),
+      key_(std::move(other.key_)) {
+  other.current_page_id = INVALID_PAGE_ID;
+  other.page = nullptr;
+  other.current_page = nullptr;
+  other.gate_ = nullptr;
 }
 
 IndexIterator::~IndexIterator() {
   if (current_page_id != INVALID_PAGE_ID)
     buffer_pool_manager->UnpinPage(current_page_id, false);
+  if (gate_ != nullptr)
+    gate_->ExitScan();
+}
+
+bool IndexIterator::IsAtKey() {
+  return item_index < page->GetSize() && memcmp(page->KeyAt(item_index), key_.get(), processor_->GetKeySize()) == 0;
+}
+
+void IndexIterator::Seek(bool from_start, bool after) {
+  while (true) {
+    current_page->RLatch();
+    int size = page->GetSize();
+    int index = 0;
+    if (!from_start) {
+      index = page->KeyIndex(reinterpret_cast<GenericKey *>(key_.get()), *processor_);
+      item_index = index;
+      if (after && IsAtKey())
+        index++;
+    }
+    if (index < size) {
+      item_index = index;
+      memcpy(key_.get(), page->KeyAt(index), processor_->GetKeySize());
+      current_page->RUnlatch();
+      return;
+    }
+
+    // Nothing left in this leaf. A split only moves keys to a new leaf on its right, so they are found further along.
+    // The scan keeps merges away, so the next leaf is still linked from this one.
+    page_id_t next_page_id = page->GetNextPageId();
+    current_page->RUnlatch();
+    buffer_pool_manager->UnpinPage(current_page_id, false);
+    if (next_page_id == INVALID_PAGE_ID) {
+      current_page_id = INVALID_PAGE_ID;
+      current_page = nullptr;
+      page = nullptr;
+      item_index = 0;
+      return;
+    }
+    current_page = buffer_pool_manager->FetchPage(next_page_id);
+    current_page_id = next_page_id;
+    page = reinterpret_cast<LeafPage *>(current_page->GetData());
+    // Leaves are linked in key order, not page id order, so only the next one is known.
+    current_page->RLatch();
+    next_page_id = page->GetNextPageId();
+    current_page->RUnlatch();
+    if (next_page_id != INVALID_PAGE_ID)
+      buffer_pool_manager->Prefetch(next_page_id);
+  }
 }
 
 /**
  * TODO: Student Implement
  */
 std::pair<GenericKey *, RowId> IndexIterator::operator*() {
-    return page->GetItem(item_index);
+    current_page->RLatch();
+    while (!IsAtKey()) {
+        // Shifted by an insert or remove in this leaf, or moved to the right by a split: find it again. If it was
+        // removed, the scan goes on from the key after it.
+        current_page->RUnlatch();
+        Seek(false, false);
+        if (page == nullptr) { return {nullptr, RowId()}; }
+        current_page->RLatch();
+    }
+    RowId value = page->ValueAt(item_index);
+    current_page->RUnlatch();
+    return {reinterpret_cast<GenericKey *>(key_.get()), value};
 }
 
 /**
@@ -27,28 +157,19 @@ std::pair<GenericKey *, RowId> IndexIterator::operator*() {
  */
 IndexIterator &IndexIterator::operator++() {
     if (page == nullptr) { return *this; }
-    
-    // Still have key-value pairs remaining in this page, just moving index.
-    if (item_index + 1 < page->GetSize()) {
+
+    // The current key is where it was and another one follows it in this page, just moving index.
+    current_page->RLatch();
+    if (IsAtKey() && item_index + 1 < page->GetSize()) {
         ++item_index;
+        memcpy(key_.get(), page->KeyAt(item_index), processor_->GetKeySize());
+        current_page->RUnlatch();
         return *this;
     }
+    current_page->RUnlatch();
 
-    // Go to the next page if can.
-    page_id_t next_page_id = page->GetNextPageId();
-    buffer_pool_manager->UnpinPage(current_page_id, false);
-
-    if (next_page_id == INVALID_PAGE_ID) {
-        current_page_id = INVALID_PAGE_ID;
-        page = nullptr;
-        item_index = 0;
-        return *this;
-    }
-    
-    Page *next_page = buffer_pool_manager->FetchPage(next_page_id);
-    current_page_id = next_page_id;
-    page = reinterpret_cast<LeafPage *>(next_page->GetData());
-    item_index = 0;
+    // The last key of the page, or the page changed since: find the key after the current one.
+    Seek(false, true);
     return *this;
 }
 
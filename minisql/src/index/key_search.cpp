@@ -0,0 +1,114 @@
+#include "index/key_search.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KEY_SEARCH_X86
+#endif
+
+namespace {
+
+using LowerBoundFunc = int (*)(const int64_t *keys, int n, int64_t key);
+
+inline int CountLessScalar(const int64_t *keys, int n, int64_t key) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    count += keys[i] < key;
+  }
+  return count;
+}
+
+/**
+ * Halves the range without branches, which a conditional move does better than a mispredicted jump, until at most
+ * WINDOW_SIZE keys are left, then counts the keys of the window smaller than key with count_less.
+ */
+template <typename CountLess>
+__attribute__((always_inline)) inline int LowerBoundWith(const int64_t *keys, int n, int64_t key, CountLess count_less) {
+  // the keys before base are smaller than key, those from base + len on are not
+  const int64_t *base = keys;
+  int len = n;
+  while (len > KeySearch::WINDOW_SIZE) {
+    int half = len / 2;
+    base = base[half - 1] < key ? base + half : base;
+    len -= half;
+  }
+  return static_cast<int>(base - keys) + count_less(base, len, key);
+}
+
+int LowerBoundScalarWindow(const int64_t *keys, int n, int64_t key) {
+  return LowerBoundWith(keys, n, key, CountLessScalar);
+}
+
+#ifdef KEY_SEARCH_X86
+__attribute__((target("avx2"))) inline int CountLessAvx2(const int64_t *keys, int n, int64_t key) {
+  __m256i target = _mm256_set1_epi64x(key);
+  int count = 0;
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+    // a lane is all ones where the key is smaller than the searched one
+    __m256i less = _mm256_cmpgt_epi64(target, values);
+    count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(less)));
+  }
+  return count + CountLessScalar(keys + i, n - i, key);
+}
+
+__attribute__((target("avx2"))) int LowerBoundAvx2(const int64_t *keys, int n, int64_t key) {
+  return LowerBoundWith(keys, n, key, CountLessAvx2);
+}
+
+__attribute__((target("sse4.2"))) inline int CountLessSse42(const int64_t *keys, int n, int64_t key) {
+  __m128i target = _mm_set1_epi64x(key);
+  int count = 0;
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+    __m128i less = _mm_cmpgt_epi64(target, values);
+    count += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(less)));
+  }
+  return count + CountLessScalar(keys + i, n - i, key);
+}
+
+__attribute__((target("sse4.2"))) int LowerBoundSse42(const int64_t *keys, int n, int64_t key) {
+  return LowerBoundWith(keys, n, key, CountLessSse42);
+}
+#endif
+
+struct Searcher {
+  LowerBoundFunc lower_bound_;
+  const char *name_;
+};
+
+Searcher ChooseSearcher() {
+#ifdef KEY_SEARCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {LowerBoundAvx2, "avx2"};
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return {LowerBoundSse42, "sse4.2"};
+  }
+#endif
+  return {LowerBoundScalarWindow, "scalar"};
+}
+
+const Searcher searcher = ChooseSearcher();
+
+}  // namespace
+
+int KeySearch::LowerBound(const int64_t *keys, int n, int64_t key) { return searcher.lower_bound_(keys, n, key); }
+
+int KeySearch::LowerBoundScalar(const int64_t *keys, int n, int64_t key) {
+  int left = 0;
+  int right = n;
+  while (left < right) {
+    int mid = (left + right) / 2;
+    if (keys[mid] < key) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  return left;
+}
+
+const char *KeySearch::GetInstructionSet() { return searcher.name_; }
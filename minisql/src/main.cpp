@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 
 #include "executor/execute_engine.h"
 #include "glog/logging.h"
@@ -36,8 +37,31 @@ int main(int argc, char **argv) {
   // command buffer
   const int buf_size = 1024;
   char cmd[buf_size];
-  // executor engine
-  ExecuteEngine engine;
+  // executor engine, "--read-only" memory-maps the databases and rejects modifications,
+  // "--sync=none|commit|interval" chooses when committed changes are synced to disk,
+  // "--checksums" checksums pages when they are written and verifies them when they are read,
+  // "--compressed" creates new databases with compressed pages
+  bool read_only = false;
+  SyncPolicy sync_policy = SyncPolicy::kNone;
+  bool checksums = false;
+  bool compressed = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--read-only") == 0) {
+      read_only = true;
+    } else if (strcmp(argv[i], "--checksums") == 0) {
+      checksums = true;
+    } else if (strcmp(argv[i], "--compressed") == 0) {
+      compressed = true;
+    } else if (strcmp(argv[i], "--sync=commit") == 0) {
+      sync_policy = SyncPolicy::kPerCommit;
+    } else if (strcmp(argv[i], "--sync=interval") == 0) {
+      sync_policy = SyncPolicy::kInterval;
+    } else if (strcmp(argv[i], "--sync=none") != 0) {
+      printf("Unknown option %s.\n", argv[i]);
+      return 1;
+    }
+  }
+  ExecuteEngine engine(read_only, sync_policy, checksums, compressed);
   // for print syntax tree
   TreeFileManagers syntax_tree_file_mgr("syntax_tree_");
   uint32_t syntax_tree_id = 0;
@@ -1,6 +1,7 @@
 #include "page/b_plus_tree_internal_page.h"
 
 #include "index/generic_key.h"
+#include "index/key_search.h"
 
 #define pairs_off (data_)
 #define pair_size (GetKeySize() + sizeof(page_id_t))
@@ -18,13 +19,14 @@
  * Including set page type, set current size, set page id, set parent id and set
  * max page size
  */
-void InternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void InternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size, bool packed_keys) {
     SetPageType(IndexPageType::INTERNAL_PAGE);
     SetKeySize(key_size);
     SetSize(0); // Initialized as empty.
     SetPageId(page_id);
     SetParentPageId(parent_id);
     SetMaxSize(max_size);
+    SetPackedKeys(packed_keys);
 }
 /*
  * Helper method to get/set the key associated with input "index"(a.k.a
@@ -36,6 +38,22 @@ GenericKey *InternalPage::KeyAt(int index) {
 
 void InternalPage::SetKeyAt(int index, GenericKey *key) {
   memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
+  if (HasPackedKeys()) {
+    PackedKeys()[index] = KeyManager::PackKey(key, GetKeySize());
+  }
+}
+
+/*
+ * Refresh the packed keys of [begin, end) from the pairs
+ */
+void InternalPage::PackKeys(int begin, int end) {
+  if (!HasPackedKeys()) {
+    return;
+  }
+  int64_t *packed_keys = PackedKeys();
+  for (int i = begin; i < end; i++) {
+    packed_keys[i] = KeyManager::PackKey(KeyAt(i), GetKeySize());
+  }
 }
 
 page_id_t InternalPage::ValueAt(int index) const {
@@ -76,6 +94,14 @@ page_id_t InternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
     if (cur_size == 0) { return INVALID_PAGE_ID; }
     if (cur_size ==1 ) { return ValueAt(0); }
 
+    if (HasPackedKeys()) {
+        // The child to follow is the one after the last key not greater than the searched key, its index is the number
+        // of such keys among keys 1 to size - 1. Packed keys are integers, so those are the keys smaller than key + 1,
+        // which cannot overflow as the marker byte of a key is 0 or 1.
+        int64_t packed_key = KeyManager::PackKey(key, GetKeySize());
+        return ValueAt(KeySearch::LowerBound(PackedKeys() + 1, cur_size - 1, packed_key + 1));
+    }
+
     // Start the search from the second key.
     int left = 1;
     int right = cur_size - 1;
@@ -164,6 +190,7 @@ void InternalPage::CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool
     int start_index = GetSize();
     // PairCopy(pairs_off + start_index * pair_size, src, size);
     PairCopy(PairPtrAt(start_index), src, size);
+    PackKeys(start_index, start_index + size);
     // Update the parent id for all the children.
     for (int i = start_index; i < start_index + size; i++) {
         page_id_t child_page_id  = ValueAt(i);
@@ -224,10 +251,10 @@ page_id_t InternalPage::RemoveAndReturnOnlyChild() {
  */
 void InternalPage::MoveAllTo(InternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager) {
     int recipient_index = recipient->GetSize();
-    // Insert the middle key to the first position.
+    // Copy all the pairs, the first child included.
+    recipient->CopyNFrom(PairPtrAt(0), GetSize(), buffer_pool_manager);
+    // The middle key separates the first child from the recipient's own children.
     recipient->SetKeyAt(recipient_index, middle_key);
-    // Copy all the remaining pairs.
-    recipient->CopyNFrom(KeyAt(1), GetSize() - 1, buffer_pool_manager);
 
     SetSize(0);
 }
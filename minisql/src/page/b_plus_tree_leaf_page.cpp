@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "index/generic_key.h"
+#include "index/key_search.h"
 
 #define pairs_off (data_)
 #define pair_size (GetKeySize() + sizeof(RowId))
@@ -21,7 +22,7 @@
  * next page id and set max size
  * 未初始化next_page_id
  */
-void LeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void LeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size, bool packed_keys) {
     SetPageType(IndexPageType::LEAF_PAGE);
     SetKeySize(key_size);
     SetSize(0); // Initialized as empty.
@@ -30,6 +31,7 @@ void LeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int ma
     SetMaxSize(max_size);
     SetKeySize(key_size);
     SetNextPageId(INVALID_PAGE_ID); // Or it would be unexpectedly set to 0.
+    SetPackedKeys(packed_keys);
 }
 
 /**
@@ -58,6 +60,10 @@ int LeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
     int cur_size = GetSize();
     if (cur_size == 0) { return 0; }
 
+    if (HasPackedKeys()) {
+        return KeySearch::LowerBound(PackedKeys(), cur_size, KeyManager::PackKey(key, GetKeySize()));
+    }
+
     // Binary search.
     int left = 0;
     int right = cur_size - 1;
@@ -103,6 +109,22 @@ GenericKey *LeafPage::KeyAt(int index) {
 
 void LeafPage::SetKeyAt(int index, GenericKey *key) {
   memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
+  if (HasPackedKeys()) {
+    PackedKeys()[index] = KeyManager::PackKey(key, GetKeySize());
+  }
+}
+
+/*
+ * Refresh the packed keys of [begin, end) from the pairs
+ */
+void LeafPage::PackKeys(int begin, int end) {
+  if (!HasPackedKeys()) {
+    return;
+  }
+  int64_t *packed_keys = PackedKeys();
+  for (int i = begin; i < end; i++) {
+    packed_keys[i] = KeyManager::PackKey(KeyAt(i), GetKeySize());
+  }
 }
 
 RowId LeafPage::ValueAt(int index) const {
@@ -183,6 +205,7 @@ void LeafPage::CopyNFrom(void *src, int size) {
 
     // Copy the pairs.
     PairCopy(PairPtrAt(start_index), src, size);
+    PackKeys(start_index, start_index + size);
 
     IncreaseSize(size);
 }
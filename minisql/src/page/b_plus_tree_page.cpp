@@ -77,8 +77,8 @@ void BPlusTreePage::SetMaxSize(int size) {
  * TODO: Student Implement
  */
 int BPlusTreePage::GetMinSize() const {
-    if (IsRootPage())
-        return 1;
+    if (IsRootPage()) // an internal root with a single child is replaced by it
+        return IsLeafPage() ? 1 : 2;
     else 
         return max_size_ / 2;
 }
@@ -113,4 +113,36 @@ void BPlusTreePage::SetPageId(page_id_t page_id) {
  */
 void BPlusTreePage::SetLSN(lsn_t lsn) {
   lsn_ = lsn;
-}
\ No newline at end of file
+}
+
+/*
+ * Helper methods to get/set whether the page keeps its keys packed
+ */
+bool BPlusTreePage::HasPackedKeys() const {
+  return packed_keys_ != 0;
+}
+
+void BPlusTreePage::SetPackedKeys(bool packed_keys) {
+  packed_keys_ = packed_keys ? 1 : 0;
+}
+
+/*
+ * The packed keys take the last (max size + 1) int64 before the checksum, moved down to a cache line boundary of the
+ * page, the pairs grow towards them from the header.
+ */
+int BPlusTreePage::GetCapacity(int header_size, int pair_size, bool packed_keys) {
+  int space = PAGE_SIZE - PAGE_CHECKSUM_SIZE - header_size;
+  if (!packed_keys) {
+    return space / pair_size;
+  }
+  return (space - static_cast<int>(sizeof(int64_t)) - (CACHE_LINE_SIZE - 1)) / (pair_size + static_cast<int>(sizeof(int64_t)));
+}
+
+int64_t *BPlusTreePage::PackedKeys() {
+  int offset = (PAGE_SIZE - PAGE_CHECKSUM_SIZE - (max_size_ + 1) * static_cast<int>(sizeof(int64_t))) & ~(CACHE_LINE_SIZE - 1);
+  return reinterpret_cast<int64_t *>(reinterpret_cast<char *>(this) + offset);
+}
+
+const int64_t *BPlusTreePage::PackedKeys() const {
+  return const_cast<BPlusTreePage *>(this)->PackedKeys();
+}
@@ -1,4 +1,5 @@
 #include "page/bitmap_page.h"
+#include <cstring>
 #include <iostream>
 #include "glog/logging.h"
 
@@ -7,34 +8,20 @@
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
-    if (page_allocated_ >= GetMaxSupportedSize() || next_free_page_ >= GetMaxSupportedSize()) {// out of space or invalid
-        // std::cout << "page_allocated_ = " << page_allocated_ << std::endl;
-        // std::cout << "GetMaxSupportedSize() = " << GetMaxSupportedSize() << std::endl;
-        // std::cout << "next_free_page_ = " << page_allocated_ << std::endl;
-        // std::cout << "return False!!!" << std::endl;
+    if (page_allocated_ >= GetMaxSupportedSize() || next_free_page_ >= GetMaxSupportedSize()) // out of space or invalid
         return false;
-
+    if (!IsPageFree(next_free_page_)) { // hint left behind by an older version, rescan
+        next_free_page_ = FindFreePage(0);
+        if (next_free_page_ >= GetMaxSupportedSize())
+            return false;
     }
-    // std::cout << "page_allocated_ = " << page_allocated_ << std::endl;
-    // std::cout << "GetMaxSupportedSize() = " << GetMaxSupportedSize() << std::endl;
-    // std::cout << "next_free_page_ = " << page_allocated_ << std::endl;
     page_offset = next_free_page_;
     uint32_t byte_offset = next_free_page_ / 8;
     uint8_t bit_offset = next_free_page_ % 8;
     bytes[byte_offset] |= (1 << bit_offset); // denote page allocated
     page_allocated_ += 1;
-    bool found = false;
-    for (int i = 0; i < GetMaxSupportedSize() && page_allocated_ < GetMaxSupportedSize(); i++) {
-        byte_offset = i / 8;
-        bit_offset = i % 8;
-        if (!((bytes[byte_offset] >> bit_offset) & 1)) {
-            next_free_page_ = i;
-            found = true;
-            break;
-        }
-    }
-    if (!found)
-        next_free_page_ = GetMaxSupportedSize();
+    // next_free_page_ was the lowest free page, so the next one can only come after it
+    next_free_page_ = page_allocated_ < GetMaxSupportedSize() ? FindFreePage(page_offset + 1) : GetMaxSupportedSize();
     return true;
 }
 
@@ -49,7 +36,8 @@ bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
     uint8_t bit_offset = page_offset % 8;
     bytes[byte_offset] &= ~(1 << bit_offset); // denote page free
     page_allocated_ -= 1;
-    next_free_page_ = page_offset; // need to reuse immediately
+    if (page_offset < next_free_page_)
+        next_free_page_ = page_offset; // need to reuse immediately
     return true;
 }
 
@@ -63,6 +51,39 @@ bool BitmapPage<PageSize>::IsPageFree(uint32_t page_offset) const {
     return !(bytes[byte_offset] >> bit_offset & 1); 
 }
 
+template <size_t PageSize>
+uint32_t BitmapPage<PageSize>::CountAllocatedPages() const {
+    uint32_t count = 0;
+    for (size_t i = 0; i < MAX_WORDS; i++)
+        count += __builtin_popcountll(LoadWord(i));
+    return count;
+}
+
+template <size_t PageSize>
+uint64_t BitmapPage<PageSize>::LoadWord(size_t word_index) const {
+    uint64_t word;
+    memcpy(&word, bytes + word_index * sizeof(uint64_t), sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+template <size_t PageSize>
+uint32_t BitmapPage<PageSize>::FindFreePage(uint32_t page_offset) const {
+    if (page_offset >= GetMaxSupportedSize())
+        return GetMaxSupportedSize();
+    size_t word_index = page_offset / 64;
+    // free pages are the zero bits, ignore the ones before page_offset in the first word
+    uint64_t free_bits = ~LoadWord(word_index) & (~0ULL << (page_offset % 64));
+    while (free_bits == 0) {
+        if (++word_index == MAX_WORDS)
+            return GetMaxSupportedSize();
+        free_bits = ~LoadWord(word_index);
+    }
+    return word_index * 64 + __builtin_ctzll(free_bits);
+}
+
 template <size_t PageSize>
 bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const {
     return !(bytes[byte_index] >> bit_index & 1); 
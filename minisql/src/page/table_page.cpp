@@ -6,7 +6,7 @@ void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr,
   memcpy(GetData(), &page_id, sizeof(page_id));
   SetPrevPageId(prev_id);
   SetNextPageId(INVALID_PAGE_ID);
-  SetFreeSpacePointer(PAGE_SIZE);
+  SetFreeSpacePointer(PAGE_SIZE - PAGE_CHECKSUM_SIZE);
   SetTupleCount(0);
 }
 
@@ -161,6 +161,20 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   return true;
 }
 
+bool TablePage::GetTupleView(uint32_t slot_num, RowView *view) {
+  if (slot_num >= GetTupleCount()) {
+    return false;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  if (IsDeleted(tuple_size)) {
+    return false;
+  }
+  uint32_t __attribute__((unused)) view_bytes =
+      view->Reset(GetData() + GetTupleOffsetAtSlot(slot_num), RowId(GetTablePageId(), slot_num));
+  ASSERT(tuple_size == view_bytes, "Unexpected behavior in tuple view.");
+  return true;
+}
+
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); i++) {
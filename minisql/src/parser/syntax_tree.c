@@ -99,6 +99,17 @@ void SyntaxNodeAddSibling(pSyntaxNode node, pSyntaxNode sib) {
   p->next_ = sib;
 }
 
+pSyntaxNode SyntaxNodeReverseSiblings(pSyntaxNode node) {
+  pSyntaxNode prev = NULL;
+  while (node != NULL) {
+    pSyntaxNode next = node->next_;
+    node->next_ = prev;
+    prev = node;
+    node = next;
+  }
+  return prev;
+}
+
 const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
   switch (type) {
     case kNodeUnknown:
@@ -171,6 +182,8 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeCopy:
+      return "kNodeCopy";
     default:
       return "error type";
   }
@@ -0,0 +1,87 @@
+#include "record/field_compare.h"
+
+template <TypeId kType>
+FieldCompare::Kernel FieldCompare::GetKernel(CompareOp op) {
+  switch (op) {
+    case CompareOp::kEquals:
+      return &Compare<kType, CompareOp::kEquals>;
+    case CompareOp::kNotEquals:
+      return &Compare<kType, CompareOp::kNotEquals>;
+    case CompareOp::kLessThan:
+      return &Compare<kType, CompareOp::kLessThan>;
+    case CompareOp::kLessThanEquals:
+      return &Compare<kType, CompareOp::kLessThanEquals>;
+    case CompareOp::kGreaterThan:
+      return &Compare<kType, CompareOp::kGreaterThan>;
+    default:
+      return &Compare<kType, CompareOp::kGreaterThanEquals>;
+  }
+}
+
+template <TypeId kType>
+FieldCompare::ColumnKernel FieldCompare::GetColumnKernel(CompareOp op) {
+  switch (op) {
+    case CompareOp::kEquals:
+      return &CompareColumn<kType, CompareOp::kEquals>;
+    case CompareOp::kNotEquals:
+      return &CompareColumn<kType, CompareOp::kNotEquals>;
+    case CompareOp::kLessThan:
+      return &CompareColumn<kType, CompareOp::kLessThan>;
+    case CompareOp::kLessThanEquals:
+      return &CompareColumn<kType, CompareOp::kLessThanEquals>;
+    case CompareOp::kGreaterThan:
+      return &CompareColumn<kType, CompareOp::kGreaterThan>;
+    default:
+      return &CompareColumn<kType, CompareOp::kGreaterThanEquals>;
+  }
+}
+
+FieldCompare::Kernel FieldCompare::GetKernel(TypeId type, CompareOp op) {
+  switch (type) {
+    case kTypeInt:
+      return GetKernel<kTypeInt>(op);
+    case kTypeFloat:
+      return GetKernel<kTypeFloat>(op);
+    case kTypeChar:
+      return GetKernel<kTypeChar>(op);
+    default:
+      return nullptr;
+  }
+}
+
+FieldCompare::ColumnKernel FieldCompare::GetColumnKernel(TypeId type, CompareOp op) {
+  switch (type) {
+    case kTypeInt:
+      return GetColumnKernel<kTypeInt>(op);
+    case kTypeFloat:
+      return GetColumnKernel<kTypeFloat>(op);
+    case kTypeChar:
+      return GetColumnKernel<kTypeChar>(op);
+    default:
+      return nullptr;
+  }
+}
+
+FieldCompare::OrderKernel FieldCompare::GetOrderKernel(TypeId type) {
+  switch (type) {
+    case kTypeInt:
+      return &Order<kTypeInt>;
+    case kTypeFloat:
+      return &Order<kTypeFloat>;
+    case kTypeChar:
+      return &Order<kTypeChar>;
+    default:
+      return nullptr;
+  }
+}
+
+bool FieldCompare::GetCompareOp(const std::string &comp_type, CompareOp *op) {
+  static const char *names[] = {"=", "<>", "<", "<=", ">", ">="};
+  for (int i = 0; i < 6; i++) {
+    if (comp_type == names[i]) {
+      *op = static_cast<CompareOp>(i);
+      return true;
+    }
+  }
+  return false;
+}
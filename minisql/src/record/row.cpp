@@ -1,5 +1,7 @@
 #include "record/row.h"
 
+#include "record/row_codec.h"
+
 /**
  * TODO: Student Implement
  */
@@ -7,34 +9,8 @@ uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
     ASSERT(schema != nullptr, "Invalid schema before serialize.");
     ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
 
-    char *buffer_pos = buf;
-
-    /**
-     * ------------------------------------------------------
-     * | Field Nums | Null Bitmap | Field-1 | ... | Field-N |
-     * ------------------------------------------------------
-     */
-
-    // Write Field Nums.
-    uint32_t field_nums = schema->GetColumnCount();
-    MACH_WRITE_UINT32(buffer_pos, field_nums);
-    buffer_pos += sizeof(field_nums);
-
-    // Write Null Bitmap and Fields.
-    uint32_t bitmap_len = (field_nums + 7) / 8; // Bytes to hold the Null Bitmap.
-    std::memset(buffer_pos, 0, bitmap_len); // Set 0 at the beginning.
-    char *nullBitMap_pos = buffer_pos;
-    buffer_pos += bitmap_len;
-    for (uint32_t i = 0; i < field_nums; i++) {
-        if (fields_[i]->IsNull()) { // Set 1 if is NULL.
-            nullBitMap_pos[i / 8] |= static_cast<char>(1 << (i % 8)); // i/8: byte-offset, i%8: bit-offset
-        }
-        else {
-            buffer_pos += fields_[i]->SerializeTo(buffer_pos);
-        }
-    }
-
-    return static_cast<uint32_t>(buffer_pos - buf);
+    // The layout is described in RowCodec, which writes the fields of the schema without a virtual call per field.
+    return schema->GetRowCodec().SerializeTo(fields_, buf);
 }
 
 /**
@@ -42,13 +18,22 @@ uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
  */
 uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
     ASSERT(schema != nullptr, "Invalid schema before serialize.");
-    destroy();
-    ASSERT(fields_.empty(), "Non empty field in row.");
 
     char *buffer_pos = buf;
 
     // Read Field Nums and check.
     uint32_t field_nums = MACH_READ_UINT32(buffer_pos);
+    const RowCodec &codec = schema->GetRowCodec();
+    if (field_nums == codec.GetFieldCount()) {
+        // The fields of the row read before are overwritten in place when they match the schema.
+        if (arena_ != nullptr || fields_.size() != field_nums) {
+            destroy();
+        }
+        return codec.DeserializeFrom(buf, &fields_);
+    }
+    // Rows with another number of fields than the schema are read field by field.
+    destroy();
+    ASSERT(fields_.empty(), "Non empty field in row.");
     // ASSERT(schema->GetColumnCount() == field_nums, "Fields size do not match schema's column size.");
     buffer_pos += sizeof(field_nums);
 
@@ -76,15 +61,7 @@ uint32_t Row::GetSerializedSize(Schema *schema) const {
     ASSERT(schema != nullptr, "Invalid schema before serialize.");
     ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
 
-    uint32_t size = 0;
-    size += sizeof(uint32_t); // Field nums
-    size += (fields_.size() + 7) / 8; // Null Bitmap
-    for (uint32_t i = 0; i < fields_.size(); i++) {
-        if (!fields_[i]->IsNull())
-            size += fields_[i]->GetSerializedSize();
-    }
-
-    return size;
+    return schema->GetRowCodec().GetSerializedSize(fields_);
 }
 
 void Row::GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row) {
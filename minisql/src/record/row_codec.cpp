@@ -0,0 +1,127 @@
+#include "record/row_codec.h"
+
+#include <cstring>
+
+RowCodec::RowCodec(const std::vector<Column *> &columns) {
+  uint32_t field_nums = static_cast<uint32_t>(columns.size());
+  bitmap_len_ = (field_nums + 7) / 8;
+  header_size_ = sizeof(uint32_t) + bitmap_len_;
+  types_.reserve(field_nums);
+  offsets_.reserve(field_nums);
+  uint32_t offset = header_size_;
+  for (auto column : columns) {
+    types_.push_back(column->GetType());
+    offsets_.push_back(offset);
+    offset += sizeof(uint32_t);
+    fixed_width_ = fixed_width_ && column->GetType() != kTypeChar;
+  }
+  if (fixed_width_) {
+    fixed_size_ = offset;
+    serialize_ = &RowCodec::SerializeRow<true>;
+    deserialize_ = &RowCodec::DeserializeRow<true>;
+  } else {
+    serialize_ = &RowCodec::SerializeRow<false>;
+    deserialize_ = &RowCodec::DeserializeRow<false>;
+  }
+}
+
+uint32_t RowCodec::GetSerializedSize(const std::vector<Field *> &fields) const {
+  ASSERT(fields.size() == types_.size(), "Fields size do not match schema's column size.");
+  uint32_t size = header_size_;
+  for (auto field : fields) {
+    if (!field->is_null_) {
+      size += fixed_width_ || field->type_id_ != kTypeChar ? sizeof(uint32_t) : sizeof(uint32_t) + field->len_;
+    }
+  }
+  return size;
+}
+
+template <bool kFixedWidth>
+uint32_t RowCodec::SerializeRow(const std::vector<Field *> &fields, char *buf) const {
+  ASSERT(fields.size() == types_.size(), "Fields size do not match schema's column size.");
+  uint32_t field_nums = GetFieldCount();
+  MACH_WRITE_UINT32(buf, field_nums);
+  char *bitmap = buf + sizeof(uint32_t);
+  memset(bitmap, 0, bitmap_len_);
+  char *pos = buf + header_size_;
+  for (uint32_t i = 0; i < field_nums; i++) {
+    const Field *field = fields[i];
+    if (field->is_null_) {
+      bitmap[i / 8] |= static_cast<char>(1 << (i % 8));
+      continue;
+    }
+    if (!kFixedWidth && types_[i] == kTypeChar) {
+      MACH_WRITE_UINT32(pos, field->len_);
+      memcpy(pos + sizeof(uint32_t), field->value_.chars_, field->len_);
+      pos += sizeof(uint32_t) + field->len_;
+    } else {
+      // int and float are both 4 bytes wide
+      memcpy(pos, &field->value_, sizeof(uint32_t));
+      pos += sizeof(uint32_t);
+    }
+  }
+  return static_cast<uint32_t>(pos - buf);
+}
+
+Field *RowCodec::ResetField(Field *field, TypeId type) {
+  if (field == nullptr) {
+    return new Field(type);
+  }
+  if (field->type_id_ == kTypeChar && field->manage_data_) {
+    delete[] field->value_.chars_;
+  }
+  field->type_id_ = type;
+  field->len_ = FIELD_NULL_LEN;
+  field->is_null_ = true;
+  field->manage_data_ = false;
+  return field;
+}
+
+template <bool kFixedWidth>
+uint32_t RowCodec::DeserializeRow(const char *buf, std::vector<Field *> *fields) const {
+  uint32_t field_nums = GetFieldCount();
+  ASSERT(MACH_READ_UINT32(buf) == field_nums, "Fields size do not match schema's column size.");
+  ASSERT(fields->empty() || fields->size() == field_nums, "Fields size do not match schema's column size.");
+  bool reuse = !fields->empty();
+  if (!reuse) {
+    fields->reserve(field_nums);
+  }
+  const char *bitmap = buf + sizeof(uint32_t);
+  // ints and floats are copied into the union of the field as they are, both are 4 bytes wide
+  if (kFixedWidth && NoneNull(bitmap)) {
+    for (uint32_t i = 0; i < field_nums; i++) {
+      Field *field = ResetField(reuse ? (*fields)[i] : nullptr, types_[i]);
+      memcpy(&field->value_, buf + offsets_[i], sizeof(uint32_t));
+      field->len_ = sizeof(uint32_t);
+      field->is_null_ = false;
+      if (!reuse) {
+        fields->push_back(field);
+      }
+    }
+    return fixed_size_;
+  }
+  const char *pos = buf + header_size_;
+  for (uint32_t i = 0; i < field_nums; i++) {
+    Field *field = ResetField(reuse ? (*fields)[i] : nullptr, types_[i]);
+    if (!reuse) {
+      fields->push_back(field);
+    }
+    if (bitmap[i / 8] & static_cast<char>(1 << (i % 8))) {
+      continue;
+    }
+    field->is_null_ = false;
+    if (!kFixedWidth && types_[i] == kTypeChar) {
+      uint32_t len = MACH_READ_UINT32(pos);
+      field->value_.chars_ = new char[len];
+      memcpy(field->value_.chars_, pos + sizeof(uint32_t), len);
+      field->len_ = len;
+      field->manage_data_ = true;
+      pos += sizeof(uint32_t) + len;
+    } else {
+      memcpy(&field->value_, pos, sizeof(uint32_t));
+      field->len_ = sizeof(uint32_t);
+      pos += sizeof(uint32_t);
+    }
+  }
+  return static_cast<uint32_t>(pos - buf);
+}
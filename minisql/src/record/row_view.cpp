@@ -0,0 +1,99 @@
+#include "record/row_view.h"
+
+#include <stdexcept>
+
+RowView::RowView(const Schema *schema) {
+  types_.reserve(schema->GetColumnCount());
+  for (auto column : schema->GetColumns()) {
+    types_.push_back(column->GetType());
+  }
+  offsets_.resize(types_.size());
+}
+
+uint32_t RowView::Reset(const char *data, RowId rid) {
+  uint32_t field_nums = GetFieldCount();
+  ASSERT(MACH_READ_UINT32(data) == field_nums, "Fields size do not match schema's column size.");
+  data_ = data;
+  bitmap_ = data + sizeof(uint32_t);
+  rid_ = rid;
+  uint32_t offset = sizeof(uint32_t) + (field_nums + 7) / 8;
+  for (uint32_t i = 0; i < field_nums; i++) {
+    offsets_[i] = offset;
+    if (IsNull(i)) {
+      continue;
+    }
+    // int and float take 4 bytes, char takes its length and the characters
+    offset += types_[i] == kTypeChar ? sizeof(uint32_t) + MACH_READ_UINT32(data + offset) : sizeof(uint32_t);
+  }
+  return offset;
+}
+
+Field RowView::GetField(uint32_t idx) const {
+  if (IsNull(idx)) {
+    return Field(types_[idx]);
+  }
+  switch (types_[idx]) {
+    case kTypeInt:
+      return Field(kTypeInt, GetInt(idx));
+    case kTypeFloat:
+      return Field(kTypeFloat, GetFloat(idx));
+    case kTypeChar:
+      return Field(kTypeChar, const_cast<char *>(GetChars(idx)), GetCharLength(idx), false);
+    default:
+      throw std::logic_error("Invalid type.");
+  }
+}
+
+void RowView::ToRow(Row *row, MemoryArena *arena) const {
+  row->UseArena(arena);
+  row->SetRowId(rid_);
+  auto &fields = row->GetFields();
+  fields.reserve(types_.size());
+  for (uint32_t i = 0; i < types_.size(); i++) {
+    fields.push_back(CopyField(i, arena));
+  }
+}
+
+void RowView::ToRow(const Schema *output_schema, Row *row, MemoryArena *arena) const {
+  row->UseArena(arena);
+  row->SetRowId(rid_);
+  auto &fields = row->GetFields();
+  fields.reserve(output_schema->GetColumnCount());
+  for (auto column : output_schema->GetColumns()) {
+    fields.push_back(CopyField(column->GetTableInd(), arena));
+  }
+}
+
+Field *RowView::CopyField(uint32_t idx, MemoryArena *arena) const {
+  if (arena != nullptr) {
+    if (IsNull(idx)) {
+      return arena->New<Field>(types_[idx]);
+    }
+    switch (types_[idx]) {
+      case kTypeInt:
+        return arena->New<Field>(kTypeInt, GetInt(idx));
+      case kTypeFloat:
+        return arena->New<Field>(kTypeFloat, GetFloat(idx));
+      case kTypeChar: {
+        // the characters go to the arena as well, the field does not own them
+        char *chars = arena->CopyBytes(GetChars(idx), GetCharLength(idx));
+        return arena->New<Field>(kTypeChar, chars, GetCharLength(idx), false);
+      }
+      default:
+        throw std::logic_error("Invalid type.");
+    }
+  }
+  if (IsNull(idx)) {
+    return new Field(types_[idx]);
+  }
+  switch (types_[idx]) {
+    case kTypeInt:
+      return new Field(kTypeInt, GetInt(idx));
+    case kTypeFloat:
+      return new Field(kTypeFloat, GetFloat(idx));
+    case kTypeChar:
+      return new Field(kTypeChar, const_cast<char *>(GetChars(idx)), GetCharLength(idx), true);
+    default:
+      throw std::logic_error("Invalid type.");
+  }
+}
@@ -1,5 +1,11 @@
 #include "record/schema.h"
 
+#include "record/row_codec.h"
+
+std::shared_ptr<const RowCodec> Schema::BuildRowCodec(const std::vector<Column *> &columns) {
+  return std::make_shared<const RowCodec>(columns);
+}
+
 /**
  * TODO: Student Implement
  */
@@ -0,0 +1,352 @@
+#include "storage/async_io.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MINISQL_HAVE_IO_URING 1
+#endif
+
+std::unique_ptr<AsyncIOContext> AsyncIOContext::Create(int fd, size_t queue_depth, bool use_io_uring) {
+  queue_depth = std::max<size_t>(queue_depth, 1);
+  if (use_io_uring) {
+    auto context = IOUringContext::Create(fd, queue_depth);
+    if (context != nullptr) {
+      return context;
+    }
+  }
+  return std::make_unique<ThreadPoolIOContext>(fd, queue_depth);
+}
+
+/*****************************************************************************
+ * io_uring
+ *****************************************************************************/
+
+std::unique_ptr<AsyncIOContext> IOUringContext::Create(int fd, size_t queue_depth) {
+  std::unique_ptr<IOUringContext> context(new IOUringContext(fd, queue_depth));
+  if (!context->Setup()) {
+    return nullptr;
+  }
+  return context;
+}
+
+#ifdef MINISQL_HAVE_IO_URING
+
+bool IOUringContext::Setup() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth_), &params));
+  if (ring_fd_ < 0) {
+    // kernel without io_uring, or forbidden by seccomp
+    return false;
+  }
+  if (!SupportsOpcodes()) {
+    return false;
+  }
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                  IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return false;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      return false;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    return false;
+  }
+  auto *sq = static_cast<char *>(sq_ring_);
+  auto *cq = static_cast<char *>(cq_ring_);
+  sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+  // the kernel may round the ring up, but never allow more in flight than asked for
+  queue_depth_ = std::min<size_t>(queue_depth_, params.sq_entries);
+  slots_.resize(queue_depth_);
+  free_slots_.reserve(queue_depth_);
+  for (size_t i = queue_depth_; i > 0; i--) {
+    free_slots_.push_back(i - 1);
+  }
+  return true;
+}
+
+bool IOUringContext::SupportsOpcodes() {
+#if defined(__NR_io_uring_register) && defined(IORING_REGISTER_PROBE)
+  // IORING_OP_READ and IORING_OP_WRITE came with the probe in Linux 5.6, an older kernel fails it
+  const unsigned num_ops = 256;
+  std::vector<char> buf(sizeof(io_uring_probe) + num_ops * sizeof(io_uring_probe_op), 0);
+  auto *probe = reinterpret_cast<io_uring_probe *>(buf.data());
+  if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe, num_ops) < 0) {
+    return false;
+  }
+  for (unsigned op : {IORING_OP_READV, IORING_OP_WRITEV, IORING_OP_READ, IORING_OP_WRITE}) {
+    if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return false;  // cannot tell, the thread pool is always safe
+#endif
+}
+
+IOUringContext::~IOUringContext() {
+  // requests still in flight write into buffers owned by the caller, wait for them
+  std::vector<AsyncIOResult> results;
+  while (ring_fd_ >= 0 && in_flight_ > 0) {
+    results.clear();
+    Complete(&results, in_flight_);
+  }
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ >= 0) close(ring_fd_);
+}
+
+bool IOUringContext::Queue(const AsyncIOResult &request) {
+  if (free_slots_.empty()) {
+    return false;
+  }
+  size_t slot = free_slots_.back();
+  free_slots_.pop_back();
+  slots_[slot] = request;
+  // only this thread produces submissions, so the tail can be read without synchronization
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & sq_mask_;
+  auto *sqe = static_cast<io_uring_sqe *>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->fd = fd_;
+  sqe->off = request.offset;
+  sqe->user_data = slot;
+  if (request.iov != nullptr) {
+    sqe->opcode = request.write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->addr = reinterpret_cast<uint64_t>(request.iov);
+    sqe->len = static_cast<uint32_t>(request.iovcnt);
+  } else {
+    sqe->opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->addr = reinterpret_cast<uint64_t>(request.buf);
+    sqe->len = static_cast<uint32_t>(request.len);
+  }
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  to_submit_++;
+  in_flight_++;
+  return true;
+}
+
+size_t IOUringContext::Complete(std::vector<AsyncIOResult> *results, size_t min_complete) {
+  min_complete = std::min(min_complete, in_flight_);
+  size_t reaped = TakePosted(results);
+  while (true) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      auto *cqe = static_cast<io_uring_cqe *>(cqes_) + (head & cq_mask_);
+      AsyncIOResult result = slots_[cqe->user_data];
+      result.result = cqe->res;
+      free_slots_.push_back(cqe->user_data);
+      results->push_back(result);
+      head++;
+      reaped++;
+      in_flight_--;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    if (reaped >= min_complete && to_submit_ == 0) {
+      return reaped;
+    }
+    unsigned wait = reaped >= min_complete ? 0 : static_cast<unsigned>(min_complete - reaped);
+    int ret = static_cast<int>(
+        syscall(__NR_io_uring_enter, ring_fd_, to_submit_, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+    if (ret < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        continue;
+      }
+      // should not happen with a well-formed ring, report the queued requests as failed rather than hang
+      int error = errno;
+      for (size_t slot = 0; slot < slots_.size(); slot++) {
+        if (std::find(free_slots_.begin(), free_slots_.end(), slot) == free_slots_.end()) {
+          AsyncIOResult result = slots_[slot];
+          result.result = -error;
+          free_slots_.push_back(slot);
+          results->push_back(result);
+          reaped++;
+          in_flight_--;
+        }
+      }
+      to_submit_ = 0;
+      return reaped;
+    }
+    to_submit_ -= std::min<unsigned>(to_submit_, static_cast<unsigned>(ret));
+  }
+}
+
+#else
+
+bool IOUringContext::Setup() { return false; }
+
+bool IOUringContext::SupportsOpcodes() { return false; }
+
+IOUringContext::~IOUringContext() = default;
+
+bool IOUringContext::Queue(const AsyncIOResult &) { return false; }
+
+size_t IOUringContext::Complete(std::vector<AsyncIOResult> *results, size_t) { return TakePosted(results); }
+
+#endif
+
+/** Total length of the buffers of a vectored request. */
+static size_t IOVecLength(const iovec *iov, int iovcnt) {
+  size_t len = 0;
+  for (int i = 0; i < iovcnt; i++) {
+    len += iov[i].iov_len;
+  }
+  return len;
+}
+
+bool IOUringContext::SubmitRead(char *buf, size_t len, size_t offset, uint64_t tag) {
+  return Queue({tag, buf, len, offset, false, 0});
+}
+
+bool IOUringContext::SubmitWrite(const char *buf, size_t len, size_t offset, uint64_t tag) {
+  // the kernel only reads from the buffer of a write
+  return Queue({tag, const_cast<char *>(buf), len, offset, true, 0});
+}
+
+bool IOUringContext::SubmitReadv(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) {
+  return Queue({tag, nullptr, IOVecLength(iov, iovcnt), offset, false, 0, iov, iovcnt});
+}
+
+bool IOUringContext::SubmitWritev(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) {
+  return Queue({tag, nullptr, IOVecLength(iov, iovcnt), offset, true, 0, iov, iovcnt});
+}
+
+/*****************************************************************************
+ * thread pool
+ *****************************************************************************/
+
+ThreadPoolIOContext::ThreadPoolIOContext(int fd, size_t queue_depth) : AsyncIOContext(fd, queue_depth) {
+  size_t num_workers = std::min<size_t>(queue_depth, 8);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&ThreadPoolIOContext::WorkerLoop, this);
+  }
+}
+
+ThreadPoolIOContext::~ThreadPoolIOContext() {
+  {
+    std::unique_lock<std::mutex> lock(latch_);
+    // let the workers drain what was submitted before they stop
+    completed_cv_.wait(lock, [this] { return completed_.size() + posted_.size() == in_flight_; });
+    stop_ = true;
+  }
+  submitted_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+bool ThreadPoolIOContext::Queue(const AsyncIOResult &request) {
+  if (in_flight_ >= queue_depth_) {
+    return false;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    submitted_.push_back(request);
+    in_flight_++;
+  }
+  submitted_cv_.notify_one();
+  return true;
+}
+
+bool ThreadPoolIOContext::SubmitRead(char *buf, size_t len, size_t offset, uint64_t tag) {
+  return Queue({tag, buf, len, offset, false, 0});
+}
+
+bool ThreadPoolIOContext::SubmitWrite(const char *buf, size_t len, size_t offset, uint64_t tag) {
+  return Queue({tag, const_cast<char *>(buf), len, offset, true, 0});
+}
+
+bool ThreadPoolIOContext::SubmitReadv(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) {
+  return Queue({tag, nullptr, IOVecLength(iov, iovcnt), offset, false, 0, iov, iovcnt});
+}
+
+bool ThreadPoolIOContext::SubmitWritev(const iovec *iov, int iovcnt, size_t offset, uint64_t tag) {
+  return Queue({tag, nullptr, IOVecLength(iov, iovcnt), offset, true, 0, iov, iovcnt});
+}
+
+size_t ThreadPoolIOContext::Complete(std::vector<AsyncIOResult> *results, size_t min_complete) {
+  std::unique_lock<std::mutex> lock(latch_);
+  min_complete = std::min(min_complete, in_flight_);
+  size_t posted = TakePosted(results);
+  min_complete -= std::min(min_complete, posted);
+  completed_cv_.wait(lock, [this, min_complete] { return completed_.size() >= min_complete; });
+  size_t reaped = completed_.size();
+  results->insert(results->end(), completed_.begin(), completed_.end());
+  completed_.clear();
+  in_flight_ -= reaped;
+  return posted + reaped;
+}
+
+void ThreadPoolIOContext::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (true) {
+    submitted_cv_.wait(lock, [this] { return stop_ || !submitted_.empty(); });
+    if (submitted_.empty()) {
+      return;
+    }
+    AsyncIOResult request = submitted_.front();
+    submitted_.pop_front();
+    lock.unlock();
+    // transfer everything the request asked for, a short count only means end of file for reads
+    size_t done = 0;
+    ssize_t ret = 0;
+    if (request.iov != nullptr) {
+      // vectored requests report a short transfer to the caller like io_uring does
+      do {
+        ret = request.write ? pwritev(fd_, request.iov, request.iovcnt, request.offset)
+                            : preadv(fd_, request.iov, request.iovcnt, request.offset);
+      } while (ret < 0 && errno == EINTR);
+      done = ret < 0 ? 0 : ret;
+    }
+    while (request.iov == nullptr && done < request.len) {
+      ret = request.write ? pwrite(fd_, request.buf + done, request.len - done, request.offset + done)
+                          : pread(fd_, request.buf + done, request.len - done, request.offset + done);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret <= 0) {
+        break;
+      }
+      done += ret;
+    }
+    request.result = ret < 0 ? -errno : static_cast<ssize_t>(done);
+    lock.lock();
+    completed_.push_back(request);
+    completed_cv_.notify_all();
+  }
+}
@@ -0,0 +1,262 @@
+#include "storage/compressed_page_store.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include "common/lz_codec.h"
+#include "glog/logging.h"
+
+namespace {
+
+constexpr uint32_t PAGE_MAP_MAGIC = 0x504D4150;  // "PMAP"
+
+/** pread/pwrite the whole buffer, retrying short transfers. @return bytes transferred */
+template <bool WRITE>
+size_t Transfer(int fd, char *buf, size_t len, size_t offset, std::atomic<size_t> *io_calls) {
+  size_t done = 0;
+  while (done < len) {
+    ssize_t ret = WRITE ? pwrite(fd, buf + done, len - done, offset + done)
+                        : pread(fd, buf + done, len - done, offset + done);
+    io_calls->fetch_add(1, std::memory_order_relaxed);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while " << (WRITE ? "writing: " : "reading: ") << strerror(errno);
+      break;
+    }
+    if (ret == 0) {
+      break;
+    }
+    done += ret;
+  }
+  return done;
+}
+
+}  // namespace
+
+bool CompressedPageStore::Exists(const std::string &map_file) { return access(map_file.c_str(), F_OK) == 0; }
+
+CompressedPageStore::CompressedPageStore(int fd, std::string map_file, bool read_only)
+    : fd_(fd), map_file_(std::move(map_file)), read_only_(read_only) {
+  // the map file is created right away, its existence tells that the file is compressed
+  int map_fd = open(map_file_.c_str(), read_only_ ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+  if (map_fd < 0) {
+    LOG(ERROR) << "Failed to open page map " << map_file_ << ": " << strerror(errno);
+    throw std::exception();
+  }
+  struct stat stat_buf;
+  if (fstat(map_fd, &stat_buf) != 0 || stat_buf.st_size == 0) {
+    close(map_fd);
+    return;  // a new store
+  }
+  uint32_t header[2];
+  if (Transfer<false>(map_fd, reinterpret_cast<char *>(header), sizeof(header), 0, &io_calls_) != sizeof(header) ||
+      header[0] != PAGE_MAP_MAGIC) {
+    LOG(ERROR) << "Invalid page map " << map_file_ << ".";
+    close(map_fd);
+    throw std::exception();
+  }
+  map_.resize(header[1]);
+  size_t len = map_.size() * sizeof(Slot);
+  if (Transfer<false>(map_fd, reinterpret_cast<char *>(map_.data()), len, sizeof(header), &io_calls_) != len) {
+    LOG(ERROR) << "Truncated page map " << map_file_ << ".";
+    close(map_fd);
+    throw std::exception();
+  }
+  close(map_fd);
+  synced_map_ = map_;
+  LoadFreeSlots();
+}
+
+CompressedPageStore::~CompressedPageStore() = default;
+
+void CompressedPageStore::LoadFreeSlots() {
+  std::vector<std::pair<uint32_t, uint16_t>> used;
+  for (const Slot &slot : map_) {
+    if (slot.length_ != 0) {
+      used.emplace_back(slot.unit_, slot.units_);
+    }
+  }
+  std::sort(used.begin(), used.end());
+  uint32_t end = 0;
+  for (auto &slot : used) {
+    for (uint32_t unit = end; unit < slot.first;) {
+      auto units = static_cast<uint16_t>(std::min<size_t>(slot.first - unit, MAX_SLOT_UNITS));
+      FreeSlot(unit, units);
+      unit += units;
+    }
+    end = slot.first + slot.second;
+  }
+  end_unit_.store(end, std::memory_order_relaxed);
+}
+
+bool CompressedPageStore::Read(page_id_t page_id, char *page_data) {
+  Slot slot{0, 0, 0};
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (static_cast<size_t>(page_id) < map_.size()) {
+      slot = map_[page_id];
+    }
+  }
+  if (slot.length_ == 0) {
+    memset(page_data, 0, PAGE_SIZE);
+    return true;
+  }
+  size_t offset = static_cast<size_t>(slot.unit_) * SLOT_SIZE;
+  if (slot.length_ == PAGE_SIZE) {
+    return Transfer<false>(fd_, page_data, PAGE_SIZE, offset, &io_calls_) == PAGE_SIZE;
+  }
+  char compressed[PAGE_SIZE];
+  if (Transfer<false>(fd_, compressed, slot.length_, offset, &io_calls_) != slot.length_ ||
+      !LzDecompress(compressed, slot.length_, page_data, PAGE_SIZE)) {
+    LOG(ERROR) << "Failed to decompress page " << page_id << ".";
+    return false;
+  }
+  return true;
+}
+
+bool CompressedPageStore::Write(page_id_t page_id, const char *page_data) {
+  if (read_only_) {
+    return false;
+  }
+  // Keep the page raw unless compressing it saves at least one unit.
+  char compressed[PAGE_SIZE];
+  size_t length = LzCompress(page_data, PAGE_SIZE, compressed, PAGE_SIZE - SLOT_SIZE);
+  const char *data = length == 0 ? page_data : compressed;
+  if (length == 0) {
+    length = PAGE_SIZE;
+  }
+  auto units = static_cast<uint16_t>((length + SLOT_SIZE - 1) / SLOT_SIZE);
+  uint32_t unit;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    unit = AllocateSlot(units);
+  }
+  // The map points at the new slot only once it is written, a failed write leaves the page as it was.
+  bool written = Transfer<true>(fd_, const_cast<char *>(data), length, static_cast<size_t>(unit) * SLOT_SIZE,
+                                &io_calls_) == length;
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (!written) {
+    FreeSlot(unit, units);
+    return false;
+  }
+  if (static_cast<size_t>(page_id) >= map_.size()) {
+    map_.resize(page_id + 1, Slot{0, 0, 0});
+  }
+  ReleaseSlot(page_id, map_[page_id]);
+  map_[page_id] = Slot{unit, static_cast<uint16_t>(length), units};
+  map_dirty_ = true;
+  map_synced_ = false;
+  return true;
+}
+
+void CompressedPageStore::Free(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(page_id) >= map_.size() || map_[page_id].length_ == 0) {
+    return;
+  }
+  ReleaseSlot(page_id, map_[page_id]);
+  map_[page_id] = Slot{0, 0, 0};
+  map_dirty_ = true;
+  map_synced_ = false;
+}
+
+bool CompressedPageStore::Flush(bool sync) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  std::vector<char> buf;
+  std::vector<std::pair<uint32_t, uint16_t>> released;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (read_only_ || !(map_dirty_ || (sync && !map_synced_))) {
+      return true;
+    }
+    uint32_t header[2] = {PAGE_MAP_MAGIC, static_cast<uint32_t>(map_.size())};
+    buf.resize(sizeof(header) + map_.size() * sizeof(Slot));
+    memcpy(buf.data(), header, sizeof(header));
+    memcpy(buf.data() + sizeof(header), map_.data(), map_.size() * sizeof(Slot));
+    map_dirty_ = false;
+    if (sync) {
+      // From now on the slots of this map are quarantined when released. The ones quarantined so far are not in it,
+      // they become free once it is on disk.
+      synced_map_ = map_;
+      released.swap(quarantined_);
+      map_synced_ = true;
+    }
+  }
+  std::string tmp_file = map_file_ + ".tmp";
+  bool written = WriteFile(tmp_file, buf.data(), buf.size(), sync) && rename(tmp_file.c_str(), map_file_.c_str()) == 0;
+  if (written && sync) {
+    std::filesystem::path dir = std::filesystem::path(map_file_).parent_path();
+    int dir_fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY);
+    written = dir_fd >= 0 && fsync(dir_fd) == 0;
+    if (dir_fd >= 0) {
+      close(dir_fd);
+    }
+  }
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (!written) {
+    LOG(ERROR) << "Failed to write page map " << map_file_ << ": " << strerror(errno);
+    map_dirty_ = true;
+    if (sync) {
+      // the old map may still be the one on disk, its slots stay quarantined
+      map_synced_ = false;
+      quarantined_.insert(quarantined_.end(), released.begin(), released.end());
+    }
+    return false;
+  }
+  for (auto &slot : released) {
+    FreeSlot(slot.first, slot.second);
+  }
+  return true;
+}
+
+bool CompressedPageStore::WriteFile(const std::string &file_name, const char *buf, size_t len, bool sync) {
+  int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  bool written = Transfer<true>(fd, const_cast<char *>(buf), len, 0, &io_calls_) == len;
+  if (written && sync && fdatasync(fd) != 0) {
+    written = false;
+  }
+  close(fd);
+  return written;
+}
+
+uint32_t CompressedPageStore::AllocateSlot(uint16_t units) {
+  for (size_t size = units; size <= MAX_SLOT_UNITS; size++) {
+    if (!free_slots_[size].empty()) {
+      uint32_t unit = free_slots_[size].back();
+      free_slots_[size].pop_back();
+      FreeSlot(unit + units, size - units);
+      return unit;
+    }
+  }
+  return end_unit_.fetch_add(units, std::memory_order_relaxed);
+}
+
+void CompressedPageStore::ReleaseSlot(page_id_t page_id, const Slot &slot) {
+  if (slot.length_ == 0) {
+    return;
+  }
+  if (static_cast<size_t>(page_id) < synced_map_.size() && synced_map_[page_id].length_ != 0 &&
+      synced_map_[page_id].unit_ == slot.unit_) {
+    quarantined_.emplace_back(slot.unit_, slot.units_);
+  } else {
+    FreeSlot(slot.unit_, slot.units_);
+  }
+}
+
+void CompressedPageStore::FreeSlot(uint32_t unit, uint16_t units) {
+  if (units > 0) {
+    free_slots_[units].push_back(unit);
+  }
+}
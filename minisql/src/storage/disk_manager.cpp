@@ -1,118 +1,275 @@
 #include "storage/disk_manager.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <filesystem>
 #include <stdexcept>
 
+#include "common/crc32c.h"
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
 
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
+namespace {
+
+/** The DiskManagers of this process that have a file open for writing, by absolute path. */
+struct OpenFiles {
+  std::mutex latch_;
+  std::unordered_multimap<std::string, DiskManager *> writers_;
+};
+
+OpenFiles &GetOpenFiles() {
+  static OpenFiles open_files;
+  return open_files;
+}
+
+}  // namespace
+
+DiskManager::DiskManager(const std::string &db_file, bool read_only, bool compressed)
+    : file_name_(db_file), read_only_(read_only) {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    std::filesystem::path p = db_file;
-    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
-    db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-    if (!db_io_.is_open()) {
+  std::string map_file = PageMapFile(db_file);
+  if (read_only_) {
+    db_fd_ = open(db_file.c_str(), O_RDONLY);
+    if (db_fd_ < 0) {
       throw std::exception();
     }
+    FlushOpenFile(db_file);  // before anything is read
+    file_size_ = GetFileSize();
+    if (CompressedPageStore::Exists(map_file)) {
+      store_ = std::make_unique<CompressedPageStore>(db_fd_, map_file, true);
+    } else if (file_size_ > 0) {
+      void *mapping = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, db_fd_, 0);
+      if (mapping == MAP_FAILED) {
+        LOG(ERROR) << "Failed to map " << db_file << ": " << strerror(errno);
+        close(db_fd_);
+        throw std::exception();
+      }
+      mapping_ = static_cast<char *>(mapping);
+      mapping_size_ = file_size_;
+    }
+    ReadPhysicalPage(META_PAGE_ID, meta_data_);
+    page_trailer_ = reinterpret_cast<DiskFileMetaPage *>(meta_data_)->HasPageTrailer();
+    had_checksums_ = reinterpret_cast<DiskFileMetaPage *>(meta_data_)->HadChecksums();
+    return;  // nothing is ever allocated, no need for the free extent index
+  }
+  // create the directory if it does not exist, the file itself is created by open()
+  std::filesystem::path p = db_file;
+  if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+  db_fd_ = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);
+  if (db_fd_ < 0) {
+    throw std::exception();
+  }
+  FlushOpenFile(db_file);  // before anything is read
+  file_size_ = GetFileSize();
+  if (compressed || CompressedPageStore::Exists(map_file)) {
+    if (!CompressedPageStore::Exists(map_file) && file_size_ > 0) {
+      LOG(ERROR) << db_file << " holds uncompressed pages, it cannot be opened compressed.";
+      close(db_fd_);
+      throw std::exception();
+    }
+    store_ = std::make_unique<CompressedPageStore>(db_fd_, map_file, false);
   }
   ReadPhysicalPage(META_PAGE_ID, meta_data_);
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  if (meta_page->GetExtentNums() == 0 && !meta_page->HasPageTrailer()) {
+    // a new file, or one that never held a page
+    meta_page->SetPageTrailer();
+    meta_dirty_ = true;
+  }
+  page_trailer_ = meta_page->HasPageTrailer();
+  had_checksums_ = meta_page->HadChecksums();
+  for (uint32_t i = 0; i < meta_page->GetExtentNums(); i++) {
+    SetExtentFree(i, meta_page->GetExtentUsedPage(i) < BITMAP_SIZE);
+  }
+  RegisterOpenFile();
 }
 
 void DiskManager::Close() {
+  StopSyncThread();
+  UnregisterOpenFile();
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  WritePhysicalPage(META_PAGE_ID, meta_data_);
+  if (!read_only_) {
+    meta_dirty_ = true;  // the meta page is written on every close, as it always was
+    FlushAllocation();
+    if (store_ != nullptr) {
+      store_->Flush(sync_policy_ != SyncPolicy::kNone);
+    }
+    if (sync_policy_ != SyncPolicy::kNone && !closed) {
+      Sync();
+    }
+  }
   if (!closed) {
-    db_io_.close();
+    if (mapping_ != nullptr) {
+      munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+    }
+    store_.reset();
+    close(db_fd_);
     closed = true;
   }
 }
 
-void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
+char *DiskManager::GetMappedPage(page_id_t logical_page_id) {
+  if (store_ != nullptr) {
+    std::scoped_lock<std::mutex> lock(decompressed_latch_);
+    auto &page = decompressed_[logical_page_id];
+    if (page == nullptr) {
+      page.reset(new char[PAGE_SIZE]);
+      if (!store_->Read(MapPageId(logical_page_id), page.get()) || !VerifyChecksum(logical_page_id, page.get())) {
+        page.reset();
+      }
+    }
+    return page.get();
+  }
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  if (mapping_ == nullptr || offset + PAGE_SIZE > mapping_size_) {
+    return nullptr;
+  }
+  return VerifyChecksum(logical_page_id, mapping_ + offset) ? mapping_ + offset : nullptr;
+}
+
+size_t DiskManager::GetLogicalPageCount() {
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  return static_cast<size_t>(meta_page->GetExtentNums()) * BITMAP_SIZE;
+}
+
+bool DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
-  ReadPhysicalPage(MapPageId(logical_page_id), page_data);
+  return ReadPhysicalPage(MapPageId(logical_page_id), page_data) && VerifyChecksum(logical_page_id, page_data);
 }
 
-void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
+bool DiskManager::WritePage(page_id_t logical_page_id, char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
-  WritePhysicalPage(MapPageId(logical_page_id), page_data);
+  StampChecksum(page_data);
+  return WritePhysicalPage(MapPageId(logical_page_id), page_data);
+}
+
+namespace {
+/** Checksum stored in the trailer of a page, never 0 which marks a page without one. */
+uint32_t PageChecksum(const char *page_data) {
+  uint32_t crc = Crc32c(page_data, PAGE_SIZE - PAGE_CHECKSUM_SIZE);
+  return crc == 0 ? 1 : crc;
+}
+}  // namespace
+
+bool DiskManager::EnableChecksums(bool enabled) {
+  if (enabled && !page_trailer_) {
+    LOG(ERROR) << file_name_ << " was created before pages had a checksum trailer, checksums stay off.";
+    return false;
+  }
+  if (enabled && !had_checksums_ && !read_only_) {
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+    reinterpret_cast<DiskFileMetaPage *>(meta_data_)->SetHadChecksums();
+    meta_dirty_ = true;
+    had_checksums_ = true;
+  }
+  checksums_.store(enabled, std::memory_order_relaxed);
+  return true;
+}
+
+void DiskManager::StampChecksum(char *page_data) {
+  if (!checksums_.load(std::memory_order_relaxed)) {
+    if (had_checksums_.load(std::memory_order_relaxed)) {
+      // a stale checksum would fail verification once the page changed without checksums
+      memset(page_data + PAGE_SIZE - PAGE_CHECKSUM_SIZE, 0, PAGE_CHECKSUM_SIZE);
+    }
+    return;
+  }
+  uint32_t checksum = PageChecksum(page_data);
+  memcpy(page_data + PAGE_SIZE - PAGE_CHECKSUM_SIZE, &checksum, sizeof(checksum));
+}
+
+bool DiskManager::VerifyChecksum(page_id_t logical_page_id, const char *page_data) {
+  if (!checksums_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  uint32_t stored;
+  memcpy(&stored, page_data + PAGE_SIZE - PAGE_CHECKSUM_SIZE, sizeof(stored));
+  if (stored == 0 || stored == PageChecksum(page_data)) {
+    return true;
+  }
+  checksum_failures_.fetch_add(1, std::memory_order_relaxed);
+  LOG(ERROR) << "Checksum mismatch in page " << logical_page_id << " of " << file_name_ << ".";
+  return false;
 }
 
 /**
  * Finished
  */
 page_id_t DiskManager::AllocatePage() { // return logical page id
+    if (read_only_)
+        return INVALID_PAGE_ID;
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
     DiskFileMetaPage *metaPage = reinterpret_cast<DiskFileMetaPage *>(meta_data_); // read as `DiskFileMetaPage`
     uint32_t allocatePages = metaPage->GetAllocatedPages();
     uint32_t extentNums = metaPage->GetExtentNums();
     if (allocatePages >= MAX_VALID_PAGE_ID) // no space left
         return INVALID_PAGE_ID;
-    
-    // find availabel extent
-    uint32_t extentID;
-    for (extentID = 0; extentID < extentNums; extentID++) {
-        if (metaPage->GetExtentUsedPage(extentID) < BITMAP_SIZE) {
-            break;
-        }
-    }
 
-    // get physical page id of the extent meta page
-    page_id_t physicalPageId = 1 // disk meta page
-                               + (1 + BITMAP_SIZE) // extent = extent meta page + extent pages
-                               * extentID;
+    // find availabel extent, a new one if all are full
+    uint32_t extentID = FindFreeExtent();
+    if (extentID >= MAX_EXTENTS)
+        return INVALID_PAGE_ID;
 
-    // modify extent meta page
-    char *buffer = new char[PAGE_SIZE];
-    ReadPhysicalPage(physicalPageId, buffer);
-    BitmapPage<PAGE_SIZE> *extentMetaPage = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(buffer);
+    // modify extent meta page, it reaches the disk with FlushAllocation()
+    BitmapPage<PAGE_SIZE> *extentMetaPage = GetExtentBitmap(extentID);
     uint32_t page_offset = 0;
-    extentMetaPage->AllocatePage(page_offset);
-    WritePhysicalPage(physicalPageId, buffer);
-    delete[] buffer;
-    // std::cout << "num_allocated_pages_ = " << metaPage->num_allocated_pages_ << std::endl;
+    if (!extentMetaPage->AllocatePage(page_offset)) {
+        LOG(ERROR) << "Extent " << extentID << " is full but its used page count says otherwise.";
+        return INVALID_PAGE_ID;
+    }
+    bitmap_dirty_[extentID] = true;
+    meta_dirty_ = true;
+    writes_.fetch_add(1, std::memory_order_release); // a pending write, so that the next Sync() flushes it
     metaPage->num_allocated_pages_++;
-    metaPage->extent_used_page_[extentID]++;
-    if (extentID >= extentNums) // extent not enough, add a new one
+    if (extentID >= extentNums) { // extent not enough, add a new one
         metaPage->num_extents_++;
+        metaPage->extent_used_page_[extentID] = 0;
+    }
+    metaPage->extent_used_page_[extentID]++;
+    SetExtentFree(extentID, metaPage->extent_used_page_[extentID] < BITMAP_SIZE);
 
-    // std::cout << "extentID = " << extentID << std::endl;
-    // std::cout << "BITMAP_SIZE = " << BITMAP_SIZE << std::endl;
-    // std::cout << "page_offset = " << page_offset << std::endl;
-    
     return extentID * BITMAP_SIZE + page_offset;
-
 }
 
 /**
  * Finished
  */
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
+    if (read_only_) {
+        LOG(ERROR) << "Cannot deallocate page " << logical_page_id << " of a read-only database.";
+        return;
+    }
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
     DiskFileMetaPage *metaPage = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
 
-    // get physical page id of the extent meta page
-    uint32_t physicalPageId = 1 + logical_page_id + logical_page_id / BITMAP_SIZE - logical_page_id % BITMAP_SIZE;
     uint32_t extentID = logical_page_id / BITMAP_SIZE;
+    if (logical_page_id < 0 || extentID >= metaPage->GetExtentNums())
+        return;
 
     // modify extent meta page
-    char *buffer = new char[PAGE_SIZE];
-    ReadPhysicalPage(physicalPageId, buffer);
-    BitmapPage<PAGE_SIZE> *extentMetaPage = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(buffer);
+    BitmapPage<PAGE_SIZE> *extentMetaPage = GetExtentBitmap(extentID);
     uint32_t page_offset = logical_page_id % BITMAP_SIZE;
-    extentMetaPage->DeAllocatePage(page_offset);
-    WritePhysicalPage(physicalPageId, buffer);
-    delete[] buffer;
+    if (!extentMetaPage->DeAllocatePage(page_offset)) // already free
+        return;
+    bitmap_dirty_[extentID] = true;
+    meta_dirty_ = true;
+    writes_.fetch_add(1, std::memory_order_release); // a pending write, so that the next Sync() flushes it
     metaPage->num_allocated_pages_--;
     metaPage->extent_used_page_[extentID]--;
     // metaPage->num_extent needs no modification
+    SetExtentFree(extentID, true);
+    // a compressed file can reuse the space right away
+    if (store_ != nullptr)
+        store_->Free(MapPageId(logical_page_id));
 }
 
 /**
@@ -121,18 +278,86 @@ void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
     if (logical_page_id > MAX_VALID_PAGE_ID)
         return false;
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
 
     DiskFileMetaPage *metaPage = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
-    // get physical page id of the extent meta page
-    uint32_t physicalPageId = 1 + logical_page_id + logical_page_id / BITMAP_SIZE - logical_page_id % BITMAP_SIZE;
-    
-    char *buffer = new char[PAGE_SIZE];
-    ReadPhysicalPage(physicalPageId, buffer);
-    BitmapPage<PAGE_SIZE> *extentMetaPage = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(buffer);
+    uint32_t extentID = logical_page_id / BITMAP_SIZE;
+    if (extentID >= metaPage->GetExtentNums()) // the extent does not exist yet
+        return true;
     uint32_t page_offset = logical_page_id % BITMAP_SIZE;
-    bool result = extentMetaPage->IsPageFree(page_offset);
-    delete[] buffer;
-    return result;
+    return GetExtentBitmap(extentID)->IsPageFree(page_offset);
+}
+
+void DiskManager::FlushAllocation() {
+    if (read_only_ || !meta_dirty_)
+        return;
+    for (size_t i = 0; i < MAX_EXTENTS; i++) {
+        if (bitmap_dirty_[i]) {
+            WritePhysicalPage(1 + (1 + BITMAP_SIZE) * i, bitmaps_[i].get());
+            bitmap_dirty_[i] = false;
+        }
+    }
+    WritePhysicalPage(META_PAGE_ID, meta_data_);
+    meta_dirty_ = false;
+}
+
+void DiskManager::FlushOpenFile(const std::string &file_name) {
+    std::error_code error;
+    open_file_key_ = std::filesystem::weakly_canonical(file_name, error).string();
+    if (error)
+        open_file_key_ = std::filesystem::absolute(file_name).lexically_normal().string();
+    auto &open_files = GetOpenFiles();
+    std::scoped_lock<std::mutex> open_files_lock(open_files.latch_);
+    auto range = open_files.writers_.equal_range(open_file_key_);
+    for (auto it = range.first; it != range.second; ++it) {
+        DiskManager *writer = it->second;
+        std::scoped_lock<std::recursive_mutex> lock(writer->db_io_latch_);
+        writer->FlushAllocation();
+        if (writer->store_ != nullptr)
+            writer->store_->Flush(false);
+    }
+}
+
+void DiskManager::RegisterOpenFile() {
+    auto &open_files = GetOpenFiles();
+    std::scoped_lock<std::mutex> open_files_lock(open_files.latch_);
+    open_files.writers_.emplace(open_file_key_, this);
+    registered_ = true;
+}
+
+void DiskManager::UnregisterOpenFile() {
+    if (!registered_)
+        return;
+    auto &open_files = GetOpenFiles();
+    std::scoped_lock<std::mutex> open_files_lock(open_files.latch_);
+    auto range = open_files.writers_.equal_range(open_file_key_);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == this) {
+            open_files.writers_.erase(it);
+            break;
+        }
+    }
+    registered_ = false;
+}
+
+BitmapPage<PAGE_SIZE> *DiskManager::GetExtentBitmap(uint32_t extent_id) {
+    if (bitmaps_[extent_id] == nullptr) {
+        bitmaps_[extent_id].reset(new char[PAGE_SIZE]());
+        DiskFileMetaPage *metaPage = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+        // a brand new extent starts empty, there is nothing to read
+        if (extent_id < metaPage->GetExtentNums())
+            ReadPhysicalPage(1 + (1 + BITMAP_SIZE) * extent_id, bitmaps_[extent_id].get());
+    }
+    return reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmaps_[extent_id].get());
+}
+
+uint32_t DiskManager::FindFreeExtent() {
+    DiskFileMetaPage *metaPage = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+    for (size_t i = 0; i < sizeof(free_extents_) / sizeof(free_extents_[0]); i++) {
+        if (free_extents_[i] != 0)
+            return i * 64 + __builtin_ctzll(free_extents_[i]);
+    }
+    return metaPage->GetExtentNums();
 }
 
 /**
@@ -143,45 +368,379 @@ page_id_t DiskManager::MapPageId(page_id_t logical_page_id) { // logical page id
     return logical_page_id + (logical_page_id / BITMAP_SIZE) + 2;
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
+size_t DiskManager::GetFileSize() {
   struct stat stat_buf;
-  int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? stat_buf.st_size : -1;
+  int rc = fstat(db_fd_, &stat_buf);
+  return rc == 0 ? stat_buf.st_size : 0;
 }
 
-void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
-  int offset = physical_page_id * PAGE_SIZE;
+bool DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
+  if (store_ != nullptr) {
+    return store_->Read(physical_page_id, page_data);
+  }
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
   // check if read beyond file length
-  if (offset >= GetFileSize(file_name_)) {
+  if (offset >= file_size_.load(std::memory_order_acquire)) {
 #ifdef ENABLE_BPM_DEBUG
     LOG(INFO) << "Read less than a page" << std::endl;
 #endif
     memset(page_data, 0, PAGE_SIZE);
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, PAGE_SIZE);
-    // if file ends before reading PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < PAGE_SIZE) {
-#ifdef ENABLE_BPM_DEBUG
-      LOG(INFO) << "Read less than a page" << std::endl;
-#endif
+    return true;
+  }
+  size_t read_count = 0;
+  while (read_count < PAGE_SIZE) {
+    ssize_t ret = pread(db_fd_, page_data + read_count, PAGE_SIZE - read_count, offset + read_count);
+    io_calls_.fetch_add(1, std::memory_order_relaxed);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      // unlike the end of the file, a failed read must not pass for a page that was never written
+      LOG(ERROR) << "I/O error while reading: " << strerror(errno);
       memset(page_data + read_count, 0, PAGE_SIZE - read_count);
+      return false;
     }
+    if (ret == 0) {
+      break;
+    }
+    read_count += ret;
+  }
+  // if file ends before reading PAGE_SIZE
+  if (read_count < PAGE_SIZE) {
+#ifdef ENABLE_BPM_DEBUG
+    LOG(INFO) << "Read less than a page" << std::endl;
+#endif
+    memset(page_data + read_count, 0, PAGE_SIZE - read_count);
   }
+  return true;
 }
 
-void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
+bool DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
+  if (read_only_) {
+    LOG(ERROR) << "Cannot write page " << physical_page_id << " of a read-only database.";
+    return false;
+  }
   size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
-  // set write cursor to offset
-  db_io_.seekp(offset);
-  db_io_.write(page_data, PAGE_SIZE);
-  // check for I/O error
-  if (db_io_.bad()) {
-    LOG(ERROR) << "I/O error while writing";
+  if (store_ != nullptr) {
+    if (!store_->Write(physical_page_id, page_data)) {
+      return false;
+    }
+    RecordWrite(offset + PAGE_SIZE);
+    return true;
+  }
+  size_t write_count = 0;
+  while (write_count < PAGE_SIZE) {
+    ssize_t ret = pwrite(db_fd_, page_data + write_count, PAGE_SIZE - write_count, offset + write_count);
+    io_calls_.fetch_add(1, std::memory_order_relaxed);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    // check for I/O error
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while writing: " << strerror(errno);
+      return false;
+    }
+    write_count += ret;
+  }
+  // the write goes straight to the OS, only the cached file size has to follow it
+  RecordWrite(offset + PAGE_SIZE);
+  return true;
+}
+
+bool DiskManager::ReadPages(page_id_t first_page_id, size_t count, char *const *page_data) {
+  bool intact = true;
+  ASSERT(first_page_id >= 0, "Invalid page id.");
+  std::vector<iovec> iov(count);
+  for (size_t i = 0; i < count; i++) {
+    iov[i] = {page_data[i], PAGE_SIZE};
+  }
+  // split at extent boundaries, the bitmap page sits in between
+  for (size_t begin = 0, end; begin < count; begin = end) {
+    end = std::min(count, begin + BITMAP_SIZE - (first_page_id + begin) % BITMAP_SIZE);
+    intact &= TransferPhysicalPages(false, MapPageId(first_page_id + begin), iov.data() + begin, end - begin);
+  }
+  for (size_t i = 0; i < count; i++) {
+    intact &= VerifyChecksum(first_page_id + i, page_data[i]);
+  }
+  return intact;
+}
+
+bool DiskManager::WritePages(page_id_t first_page_id, size_t count, char *const *page_data) {
+  bool written = true;
+  ASSERT(first_page_id >= 0, "Invalid page id.");
+  std::vector<iovec> iov(count);
+  for (size_t i = 0; i < count; i++) {
+    StampChecksum(page_data[i]);
+    iov[i] = {page_data[i], PAGE_SIZE};
+  }
+  for (size_t begin = 0, end; begin < count; begin = end) {
+    end = std::min(count, begin + BITMAP_SIZE - (first_page_id + begin) % BITMAP_SIZE);
+    written &= TransferPhysicalPages(true, MapPageId(first_page_id + begin), iov.data() + begin, end - begin);
+  }
+  return written;
+}
+
+bool DiskManager::TransferPhysicalPages(bool write, page_id_t first_physical_page_id, iovec *iov, int iovcnt) {
+  if (write && read_only_) {
+    LOG(ERROR) << "Cannot write page " << first_physical_page_id << " of a read-only database.";
+    return false;
+  }
+  if (store_ != nullptr) {
+    return TransferCompressedPages(write, first_physical_page_id, iov, iovcnt);
+  }
+  size_t offset = static_cast<size_t>(first_physical_page_id) * PAGE_SIZE;
+  size_t total = static_cast<size_t>(iovcnt) * PAGE_SIZE;
+  size_t done = 0;
+  // every iovec is a whole page, a short transfer leaves the current one partially done
+  int index = 0;
+  size_t page_done = 0;
+  bool failed = false;
+  while (done < total) {
+    iovec saved = iov[index];
+    iov[index].iov_base = static_cast<char *>(saved.iov_base) + page_done;
+    iov[index].iov_len = saved.iov_len - page_done;
+    int batch = std::min(iovcnt - index, IOV_MAX);
+    ssize_t ret = write ? pwritev(db_fd_, iov + index, batch, offset + done)
+                        : preadv(db_fd_, iov + index, batch, offset + done);
+    io_calls_.fetch_add(1, std::memory_order_relaxed);
+    iov[index] = saved;
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while " << (write ? "writing: " : "reading: ") << strerror(errno);
+      if (write) {
+        return false;
+      }
+      failed = true;  // the pages not read yet are zero filled, but do not pass for pages past the end of the file
+      break;
+    }
+    if (ret == 0) {
+      break;  // end of file, only possible for reads
+    }
+    done += ret;
+    index = done / PAGE_SIZE;
+    page_done = done % PAGE_SIZE;
+  }
+  if (write) {
+    RecordWrite(offset + total);
+    return true;
+  }
+  // the file ends before the last pages, same as ReadPhysicalPage
+  for (; done < total; done += PAGE_SIZE - done % PAGE_SIZE) {
+    memset(static_cast<char *>(iov[done / PAGE_SIZE].iov_base) + done % PAGE_SIZE, 0, PAGE_SIZE - done % PAGE_SIZE);
+  }
+  return !failed;
+}
+
+bool DiskManager::TransferCompressedPages(bool write, page_id_t first_physical_page_id, const iovec *iov,
+                                          int iovcnt) {
+  bool intact = true;
+  for (int i = 0; i < iovcnt; i++) {
+    if (write) {
+      intact &= WritePhysicalPage(first_physical_page_id + i, static_cast<const char *>(iov[i].iov_base));
+    } else {
+      intact &= ReadPhysicalPage(first_physical_page_id + i, static_cast<char *>(iov[i].iov_base));
+    }
+  }
+  return intact;
+}
+
+void DiskManager::RecordWrite(size_t end) {
+  size_t file_size = file_size_.load(std::memory_order_relaxed);
+  // the physical layout of a compressed file is virtual, its size does not follow the page offsets
+  while (store_ == nullptr && file_size < end &&
+         !file_size_.compare_exchange_weak(file_size, end, std::memory_order_release)) {
+  }
+  writes_.fetch_add(1, std::memory_order_release);
+}
+
+void DiskManager::Sync() {
+  if (read_only_) {
+    return;
+  }
+  uint64_t target = writes_.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lock(sync_latch_);
+  // A sync that started after our writes covers them. One that is already running may not, wait for it and lead the
+  // next one, together with everybody else who arrived in the meantime.
+  while (synced_writes_ < target && syncing_) {
+    sync_cv_.wait(lock);
+  }
+  if (synced_writes_ >= target) {
+    return;
+  }
+  syncing_ = true;
+  lock.unlock();
+  uint64_t covered;
+  {
+    // The allocation goes into the same fdatasync as the pages, a committed page is never left unallocated on disk.
+    std::scoped_lock<std::recursive_mutex> io_lock(db_io_latch_);
+    FlushAllocation();
+    covered = writes_.load(std::memory_order_acquire);
+  }
+  if (fdatasync(db_fd_) != 0) {
+    LOG(ERROR) << "fdatasync failed: " << strerror(errno);
+  }
+  if (store_ != nullptr) {
+    store_->Flush(true);  // after the pages, so that the map never points at slots that are not on disk yet
+  }
+  syncs_.fetch_add(1, std::memory_order_relaxed);
+  lock.lock();
+  syncing_ = false;
+  synced_writes_ = std::max(synced_writes_, covered);
+  sync_cv_.notify_all();
+}
+
+void DiskManager::Commit() {
+  if (sync_policy_ == SyncPolicy::kPerCommit) {
+    Sync();
+  }
+}
+
+void DiskManager::SetSyncPolicy(SyncPolicy policy, std::chrono::milliseconds interval) {
+  StopSyncThread();
+  sync_policy_ = policy;
+  if (policy == SyncPolicy::kInterval && !read_only_) {
+    sync_thread_stop_ = false;
+    sync_thread_ = std::thread(&DiskManager::SyncLoop, this, interval);
+  }
+}
+
+void DiskManager::StopSyncThread() {
+  if (!sync_thread_.joinable()) {
     return;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
+  {
+    std::scoped_lock<std::mutex> lock(sync_latch_);
+    sync_thread_stop_ = true;
+  }
+  sync_cv_.notify_all();
+  sync_thread_.join();
+}
+
+void DiskManager::SyncLoop(std::chrono::milliseconds interval) {
+  std::unique_lock<std::mutex> lock(sync_latch_);
+  while (!sync_thread_stop_) {
+    sync_cv_.wait_for(lock, interval, [this] { return sync_thread_stop_; });
+    if (sync_thread_stop_) {
+      break;
+    }
+    if (writes_.load(std::memory_order_acquire) > synced_writes_) {
+      lock.unlock();
+      Sync();
+      lock.lock();
+    }
+  }
+}
+
+std::unique_ptr<AsyncIOContext> DiskManager::CreateAsyncIOContext(size_t queue_depth) {
+  return AsyncIOContext::Create(db_fd_, queue_depth);
+}
+
+bool DiskManager::SubmitReadPage(AsyncIOContext *io, page_id_t logical_page_id, char *page_data, uint64_t tag) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  if (store_ != nullptr) {
+    // compressed pages are transferred right away, the request is handed in done
+    if (io->GetInFlight() >= io->GetQueueDepth()) {
+      return false;
+    }
+    bool intact = ReadPhysicalPage(MapPageId(logical_page_id), page_data);
+    return io->Post({tag, page_data, PAGE_SIZE, offset, false, intact ? PAGE_SIZE : -EIO});
+  }
+  return io->SubmitRead(page_data, PAGE_SIZE, offset, tag);
+}
+
+bool DiskManager::SubmitWritePage(AsyncIOContext *io, page_id_t logical_page_id, char *page_data, uint64_t tag) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  StampChecksum(page_data);
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  if (store_ != nullptr) {
+    if (io->GetInFlight() >= io->GetQueueDepth() || read_only_) {
+      return false;
+    }
+    bool written = store_->Write(MapPageId(logical_page_id), page_data);
+    return io->Post({tag, page_data, PAGE_SIZE, offset, true, written ? PAGE_SIZE : -EIO});
+  }
+  return io->SubmitWrite(page_data, PAGE_SIZE, offset, tag);
+}
+
+bool DiskManager::SubmitReadPages(AsyncIOContext *io, page_id_t first_page_id, const iovec *iov, int iovcnt,
+                                  uint64_t tag) {
+  ASSERT(first_page_id >= 0 && (first_page_id % BITMAP_SIZE) + iovcnt <= BITMAP_SIZE, "Pages are not adjacent.");
+  size_t offset = static_cast<size_t>(MapPageId(first_page_id)) * PAGE_SIZE;
+  if (store_ != nullptr) {
+    if (io->GetInFlight() >= io->GetQueueDepth()) {
+      return false;
+    }
+    ssize_t len = static_cast<ssize_t>(iovcnt) * PAGE_SIZE;
+    bool intact = TransferCompressedPages(false, MapPageId(first_page_id), iov, iovcnt);
+    return io->Post({tag, nullptr, static_cast<size_t>(len), offset, false, intact ? len : -EIO, iov, iovcnt});
+  }
+  return io->SubmitReadv(iov, iovcnt, offset, tag);
+}
+
+bool DiskManager::SubmitWritePages(AsyncIOContext *io, page_id_t first_page_id, const iovec *iov, int iovcnt,
+                                   uint64_t tag) {
+  ASSERT(first_page_id >= 0 && (first_page_id % BITMAP_SIZE) + iovcnt <= BITMAP_SIZE, "Pages are not adjacent.");
+  for (int i = 0; i < iovcnt; i++) {
+    StampChecksum(static_cast<char *>(iov[i].iov_base));
+  }
+  size_t offset = static_cast<size_t>(MapPageId(first_page_id)) * PAGE_SIZE;
+  if (store_ != nullptr) {
+    if (io->GetInFlight() >= io->GetQueueDepth() || read_only_) {
+      return false;
+    }
+    bool written = true;
+    for (int i = 0; i < iovcnt; i++) {
+      written &= store_->Write(MapPageId(first_page_id) + i, static_cast<const char *>(iov[i].iov_base));
+    }
+    size_t len = static_cast<size_t>(iovcnt) * PAGE_SIZE;
+    return io->Post({tag, nullptr, len, offset, true, written ? static_cast<ssize_t>(len) : -EIO, iov, iovcnt});
+  }
+  return io->SubmitWritev(iov, iovcnt, offset, tag);
+}
+
+size_t DiskManager::CompletePages(AsyncIOContext *io, std::vector<AsyncIOResult> *results, size_t min_complete) {
+  size_t first = results->size();
+  size_t reaped = io->Complete(results, min_complete);
+  for (size_t i = first; i < results->size(); i++) {
+    AsyncIOResult &result = (*results)[i];
+    if (result.result < 0) {
+      LOG(ERROR) << "I/O error while " << (result.write ? "writing: " : "reading: ") << strerror(-result.result);
+    }
+    if (result.write) {
+      if (result.result == static_cast<ssize_t>(result.len)) {
+        RecordWrite(result.offset + result.len);
+      }
+      continue;
+    }
+    if (result.result < static_cast<ssize_t>(result.len)) {
+      // the file ends before the page, same as ReadPhysicalPage
+      size_t read_count = result.result < 0 ? 0 : result.result;
+      if (result.iov == nullptr) {
+        memset(result.buf + read_count, 0, result.len - read_count);
+      }
+      for (int j = 0; j < result.iovcnt; j++) {
+        size_t len = result.iov[j].iov_len;
+        size_t skip = std::min(read_count, len);
+        memset(static_cast<char *>(result.iov[j].iov_base) + skip, 0, len - skip);
+        read_count -= skip;
+      }
+    }
+    // physical page p holds logical page p - 2 - (p - 1) / (BITMAP_SIZE + 1), see MapPageId()
+    page_id_t physical_page_id = result.offset / PAGE_SIZE;
+    page_id_t logical_page_id = physical_page_id - 2 - (physical_page_id - 1) / (BITMAP_SIZE + 1);
+    bool verified = true;
+    if (result.iov == nullptr) {
+      verified = VerifyChecksum(logical_page_id, result.buf);
+    }
+    for (int j = 0; j < result.iovcnt; j++) {
+      verified &= VerifyChecksum(logical_page_id + j, static_cast<const char *>(result.iov[j].iov_base));
+    }
+    if (!verified) {
+      result.result = -EIO;
+    }
+  }
+  return reaped;
 }
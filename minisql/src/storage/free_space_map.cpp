@@ -0,0 +1,147 @@
+#include "storage/free_space_map.h"
+
+#include "glog/logging.h"
+
+page_id_t FreeSpaceMap::NewMap(BufferPoolManager *buffer_pool_manager) {
+  page_id_t page_id;
+  auto page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager->NewPage(page_id));
+  if (page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  page->Init();
+  buffer_pool_manager->UnpinPage(page_id, true);
+  return page_id;
+}
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id)
+    : buffer_pool_manager_(buffer_pool_manager),
+      first_page_id_(first_page_id),
+      buckets_(UINT8_MAX + 1),
+      persistent_(first_page_id != INVALID_PAGE_ID) {
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      LOG(ERROR) << "Failed to read page " << page_id << " of a free space map, the rest of the map is lost.";
+      persistent_ = false;
+      break;
+    }
+    map_pages_.push_back(page_id);
+    for (uint32_t i = 0; i < page->GetEntryCount(); i++) {
+      auto index = static_cast<uint32_t>(entries_.size());
+      entries_.push_back({page->GetHeapPageId(i), page->GetCategory(i), 0});
+      indexes_[page->GetHeapPageId(i)] = index;
+      LinkEntry(index);
+    }
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+page_id_t FreeSpaceMap::FindPage(uint32_t size) {
+  // round up, so that any page of the category found is large enough
+  uint32_t category = (size + CATEGORY_SIZE - 1) / CATEGORY_SIZE;
+  std::lock_guard<std::mutex> guard(latch_);
+  for (; category <= UINT8_MAX; category++) {
+    if (!buckets_[category].empty()) {
+      return entries_[buckets_[category].back()].page_id_;
+    }
+  }
+  return INVALID_PAGE_ID;
+}
+
+void FreeSpaceMap::Update(page_id_t heap_page_id, uint32_t free_space) {
+  uint8_t category = ToCategory(free_space);
+  std::lock_guard<std::mutex> guard(latch_);
+  auto iter = indexes_.find(heap_page_id);
+  if (iter == indexes_.end()) {
+    auto index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({heap_page_id, category, 0});
+    indexes_.emplace(heap_page_id, index);
+    LinkEntry(index);
+    Persist(index, true);
+    return;
+  }
+  uint32_t index = iter->second;
+  if (entries_[index].category_ == category) {
+    return;
+  }
+  UnlinkEntry(index);
+  entries_[index].category_ = category;
+  LinkEntry(index);
+  Persist(index, false);
+}
+
+page_id_t FreeSpaceMap::GetLastPageId() {
+  std::lock_guard<std::mutex> guard(latch_);
+  return entries_.empty() ? INVALID_PAGE_ID : entries_.back().page_id_;
+}
+
+size_t FreeSpaceMap::GetPageCount() {
+  std::lock_guard<std::mutex> guard(latch_);
+  return entries_.size();
+}
+
+void FreeSpaceMap::Free() {
+  std::lock_guard<std::mutex> guard(latch_);
+  for (auto page_id : map_pages_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  map_pages_.clear();
+  entries_.clear();
+  indexes_.clear();
+  for (auto &bucket : buckets_) {
+    bucket.clear();
+  }
+  first_page_id_ = INVALID_PAGE_ID;
+  persistent_ = false;
+}
+
+void FreeSpaceMap::LinkEntry(uint32_t index) {
+  auto &bucket = buckets_[entries_[index].category_];
+  entries_[index].bucket_pos_ = static_cast<uint32_t>(bucket.size());
+  bucket.push_back(index);
+}
+
+void FreeSpaceMap::UnlinkEntry(uint32_t index) {
+  auto &bucket = buckets_[entries_[index].category_];
+  uint32_t pos = entries_[index].bucket_pos_;
+  bucket[pos] = bucket.back();
+  entries_[bucket[pos]].bucket_pos_ = pos;
+  bucket.pop_back();
+}
+
+void FreeSpaceMap::Persist(uint32_t index, bool append) {
+  if (!persistent_) {
+    return;
+  }
+  uint32_t map_index = index / FreeSpaceMapPage::MAX_ENTRIES;
+  if (map_index == map_pages_.size()) {
+    // the last map page is full, chain a new one
+    auto last = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_pages_.back()));
+    page_id_t page_id = last == nullptr ? INVALID_PAGE_ID : NewMap(buffer_pool_manager_);
+    if (page_id == INVALID_PAGE_ID) {
+      LOG(WARNING) << "Failed to grow the free space map, it is no longer persisted.";
+      if (last != nullptr) {
+        buffer_pool_manager_->UnpinPage(map_pages_.back(), false);
+      }
+      persistent_ = false;
+      return;
+    }
+    last->SetNextPageId(page_id);
+    buffer_pool_manager_->UnpinPage(map_pages_.back(), true);
+    map_pages_.push_back(page_id);
+  }
+  auto page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_pages_[map_index]));
+  if (page == nullptr) {
+    LOG(WARNING) << "Failed to read a page of the free space map, it is no longer persisted.";
+    persistent_ = false;
+    return;
+  }
+  if (append) {
+    page->AppendEntry(entries_[index].page_id_, entries_[index].category_);
+  } else {
+    page->SetCategory(index % FreeSpaceMapPage::MAX_ENTRIES, entries_[index].category_);
+  }
+  buffer_pool_manager_->UnpinPage(map_pages_[map_index], true);
+}
@@ -5,63 +5,184 @@
  */
 bool TableHeap::InsertTuple(Row &row, Txn *txn) {
     /**
-     * Use First Fit strategy, try to find the first TablePage that is able to hold the record.
+     * Ask the free space map for a page that is able to hold the record, append a new page if there is none.
      * `RowId` should be returned through `row.rid_`. (Done by TablePage::InsertTuple) 
      */
     
     // Make sure the tuple is not too large.
     uint32_t tuple_size = row.GetSerializedSize(schema_);
     ASSERT(tuple_size < PAGE_SIZE, "Tuple size is larger than PAGE_SIZE!");
+    uint32_t space_needed = tuple_size + TablePage::SIZE_TUPLE;
 
-    // Insert the tuple using First Fit.
-    page_id_t curPageId = first_page_id_;
-    bool isInserted = false;
-    while (!isInserted) {
-        Page *cur_Page = buffer_pool_manager_->FetchPage(curPageId);
-        if (cur_Page == nullptr) {
-            // throw std::runtime_error("Page ID invalid!");
-            return false;
+    // Go straight to a page with enough room. An entry of the map can be stale, the free space of the page is then
+    // corrected and the map asked again.
+    FreeSpaceMap *free_space_map = GetFreeSpaceMap();
+    page_id_t curPageId;
+    while ((curPageId = free_space_map->FindPage(space_needed)) != INVALID_PAGE_ID) {
+        auto curPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(curPageId));
+        if (curPage == nullptr) {
+            free_space_map->Update(curPageId, 0); // Don't try this page again.
+            continue;
         }
-        auto curPage = reinterpret_cast<TablePage *>(cur_Page);
         
         curPage->WLatch();
-        isInserted = curPage->InsertTuple(row, schema_, txn, lock_manager_, log_manager_); // Try to insert the tuple to an old page.
+        bool isInserted = curPage->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+        uint32_t free_space = curPage->GetFreeSpaceRemaining();
         curPage->WUnlatch();
-        buffer_pool_manager_->UnpinPage(curPage->GetPageId(), isInserted);
+        buffer_pool_manager_->UnpinPage(curPageId, isInserted);
+        free_space_map->Update(curPageId, free_space);
+        if (isInserted) { return true; }
+    }
 
+    // No place for the tuple in old pages.
+    return AppendTuple(row, txn);
+}
+
+TablePage *TableHeap::FetchTail(page_id_t *tail_page_id) {
+    // The tail is normally the last page of the map, unless the map lags behind the page chain.
+    FreeSpaceMap *free_space_map = GetFreeSpaceMap();
+    page_id_t curPageId = free_space_map->GetLastPageId();
+    if (curPageId == INVALID_PAGE_ID) { curPageId = first_page_id_; }
+    auto curPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(curPageId));
+    if (curPage == nullptr) { return nullptr; }
+    curPage->WLatch();
+    while (curPage->GetNextPageId() != INVALID_PAGE_ID) {
         page_id_t nextPageId = curPage->GetNextPageId();
-        if (isInserted) { break; }
-        else if (nextPageId != INVALID_PAGE_ID) { curPageId = nextPageId; }
-        else {
-            // No place for the tuple in old pages. Need to attach a new page.
-            page_id_t newPageId;
-            Page *new_page = buffer_pool_manager_->NewPage(newPageId);
-            if (new_page == nullptr) {
-                // throw std::runtime_error("Can't get a new page!");
-                return false;
-            }
-            auto newPage = reinterpret_cast<TablePage *>(new_page);
-            
-            // Initialize the new page and attach it to the last page.
-            newPage->WLatch();
-            newPage->Init(newPageId, curPageId, log_manager_, txn);
-            newPage->WUnlatch();
-            curPage->WLatch();
-            curPage->SetNextPageId(newPageId);
+        uint32_t free_space = curPage->GetFreeSpaceRemaining();
+        curPage->WUnlatch();
+        buffer_pool_manager_->UnpinPage(curPageId, false);
+        free_space_map->Update(curPageId, free_space);
+        curPageId = nextPageId;
+        curPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(curPageId));
+        if (curPage == nullptr) { return nullptr; }
+        curPage->WLatch();
+    }
+    *tail_page_id = curPageId;
+    return curPage;
+}
+
+bool TableHeap::AppendTuple(Row &row, Txn *txn) {
+    std::lock_guard<std::mutex> guard(append_latch_);
+    FreeSpaceMap *free_space_map = GetFreeSpaceMap();
+    page_id_t curPageId;
+    auto curPage = FetchTail(&curPageId);
+    if (curPage == nullptr) { return false; }
+
+    // The tail may still hold the tuple, the map rounds free space down.
+    bool isInserted = curPage->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+    if (!isInserted) {
+        // Need to attach a new page.
+        page_id_t newPageId;
+        auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(newPageId));
+        if (newPage == nullptr) {
+            // throw std::runtime_error("Can't get a new page!");
             curPage->WUnlatch();
-            buffer_pool_manager_->UnpinPage(curPageId, true);
+            buffer_pool_manager_->UnpinPage(curPageId, false);
+            return false;
+        }
+
+        // Initialize the new page, insert the tuple and attach it to the last page.
+        newPage->WLatch();
+        newPage->Init(newPageId, curPageId, log_manager_, txn);
+        isInserted = newPage->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+        uint32_t new_free_space = newPage->GetFreeSpaceRemaining();
+        newPage->WUnlatch();
+        buffer_pool_manager_->UnpinPage(newPageId, true);
+        curPage->SetNextPageId(newPageId);
+        uint32_t free_space = curPage->GetFreeSpaceRemaining();
+        curPage->WUnlatch();
+        buffer_pool_manager_->UnpinPage(curPageId, true);
+        free_space_map->Update(curPageId, free_space);
+        free_space_map->Update(newPageId, new_free_space);
+        return isInserted;
+    }
+    uint32_t free_space = curPage->GetFreeSpaceRemaining();
+    curPage->WUnlatch();
+    buffer_pool_manager_->UnpinPage(curPageId, true);
+    free_space_map->Update(curPageId, free_space);
+    return true;
+}
 
-            // Insert the tuple.
-            newPage->WLatch();
-            isInserted = newPage->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
-            newPage->WUnlatch();
-            buffer_pool_manager_->UnpinPage(newPageId, true);
-            
-            break;
+size_t TableHeap::BulkInsert(std::vector<Row> &rows, Txn *txn) {
+    /**
+     * Fill the tail, then pack the remaining rows into fresh pages. The fresh pages are chained to each other while
+     * they are filled and attached to the tail only once, at the end.
+     */
+    if (rows.empty()) { return 0; }
+    std::lock_guard<std::mutex> guard(append_latch_);
+    FreeSpaceMap *free_space_map = GetFreeSpaceMap();
+    page_id_t tailPageId;
+    auto tailPage = FetchTail(&tailPageId);
+    if (tailPage == nullptr) { return 0; }
+    size_t inserted = 0;
+    while (inserted < rows.size() &&
+           tailPage->InsertTuple(rows[inserted], schema_, txn, lock_manager_, log_manager_)) {
+        inserted++;
+    }
+
+    std::vector<std::pair<page_id_t, uint32_t>> newPages; // Fresh pages and their free space, in chain order.
+    TablePage *curPage = nullptr;
+    page_id_t curPageId = INVALID_PAGE_ID;
+    while (inserted < rows.size()) {
+        page_id_t newPageId;
+        auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(newPageId));
+        if (newPage == nullptr) { break; }
+        // Nobody can reach the fresh pages yet, they need no latch.
+        newPage->Init(newPageId, curPage == nullptr ? tailPageId : curPageId, log_manager_, txn);
+        if (curPage != nullptr) {
+            curPage->SetNextPageId(newPageId);
+            newPages.emplace_back(curPageId, curPage->GetFreeSpaceRemaining());
+            buffer_pool_manager_->UnpinPage(curPageId, true);
         }
+        curPage = newPage;
+        curPageId = newPageId;
+        size_t page_begin = inserted;
+        while (inserted < rows.size() &&
+               curPage->InsertTuple(rows[inserted], schema_, txn, lock_manager_, log_manager_)) {
+            inserted++;
+        }
+        if (inserted == page_begin) { break; } // The row does not even fit into an empty page.
+    }
+    if (curPage != nullptr) {
+        newPages.emplace_back(curPageId, curPage->GetFreeSpaceRemaining());
+        buffer_pool_manager_->UnpinPage(curPageId, true);
+    }
+
+    // Link the fresh pages into the chain.
+    if (!newPages.empty()) { tailPage->SetNextPageId(newPages.front().first); }
+    uint32_t free_space = tailPage->GetFreeSpaceRemaining();
+    tailPage->WUnlatch();
+    buffer_pool_manager_->UnpinPage(tailPageId, true);
+    free_space_map->Update(tailPageId, free_space);
+    for (auto &newPage : newPages) {
+        free_space_map->Update(newPage.first, newPage.second);
     }
+    return inserted;
+}
 
-    return isInserted;
+FreeSpaceMap *TableHeap::GetFreeSpaceMap() {
+    std::call_once(free_space_map_built_, [this] {
+        if (free_space_map_ != nullptr) { return; }
+        // Opened without a persistent map, record the free space of every page of the chain in memory.
+        auto free_space_map = std::make_unique<FreeSpaceMap>(buffer_pool_manager_, INVALID_PAGE_ID);
+        page_id_t curPageId = first_page_id_;
+        while (curPageId != INVALID_PAGE_ID) {
+            auto curPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(curPageId));
+            if (curPage == nullptr) {
+                LOG(ERROR) << "TableHeap: Failed to fetch page " << curPageId << " while building the free space map.";
+                break;
+            }
+            curPage->RLatch();
+            uint32_t free_space = curPage->GetFreeSpaceRemaining();
+            page_id_t nextPageId = curPage->GetNextPageId();
+            curPage->RUnlatch();
+            buffer_pool_manager_->UnpinPage(curPageId, false);
+            free_space_map->Update(curPageId, free_space);
+            curPageId = nextPageId;
+        }
+        free_space_map_ = std::move(free_space_map);
+    });
+    return free_space_map_.get();
 }
 
 bool TableHeap::MarkDelete(const RowId &rid, Txn *txn) {
@@ -106,6 +227,7 @@ bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
     }
     // Update the tuple.
     bool isUpdated = oldPage->UpdateTuple(row, &old_row, schema_, txn, lock_manager_, log_manager_);
+    uint32_t free_space = oldPage->GetFreeSpaceRemaining();
     oldPage->WUnlatch();
     if (!isUpdated) { // New row is too large to be updated. Remove the old row and insert the new row again.
         MarkDelete(rid, txn);
@@ -115,6 +237,7 @@ bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
         return isInserted;
     }
     buffer_pool_manager_->UnpinPage(oldPage->GetPageId(), isUpdated);  
+    GetFreeSpaceMap()->Update(rid.GetPageId(), free_space);
     row.SetRowId(rid);  
     return isUpdated;
 }
@@ -137,8 +260,10 @@ void TableHeap::ApplyDelete(const RowId &rid, Txn *txn) {
     // Apply delete.
     page->WLatch();
     page->ApplyDelete(rid, txn, log_manager_);
+    uint32_t free_space = page->GetFreeSpaceRemaining();
     page->WUnlatch();
     buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+    GetFreeSpaceMap()->Update(rid.GetPageId(), free_space); // The space of the tuple can be reused.
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
@@ -179,6 +304,9 @@ void TableHeap::DeleteTable(page_id_t page_id) {
     buffer_pool_manager_->DeletePage(page_id);
   } else {
     DeleteTable(first_page_id_);
+    if (free_space_map_ != nullptr) {
+      free_space_map_->Free();
+    }
   }
 }
 
@@ -190,6 +318,8 @@ TableIterator TableHeap::Begin(Txn *txn) { // Need to match up with end()!
     page_id_t current_page_id = first_page_id_;
     RowId first_valid_rid;
     bool found_first_tuple = false;
+    if (current_page_id != INVALID_PAGE_ID)
+        buffer_pool_manager_->Prefetch(current_page_id + 1, READ_AHEAD_PAGES); // Start reading ahead for the scan.
 
     // Try to find the first valid tuple
     while (current_page_id != INVALID_PAGE_ID) {
@@ -199,7 +329,7 @@ TableIterator TableHeap::Begin(Txn *txn) { // Need to match up with end()!
             return End(); 
         }
         
-        auto table_page = reinterpret_cast<TablePage*>(page->GetData());
+        auto table_page = reinterpret_cast<TablePage*>(page);
         table_page->RLatch();
         found_first_tuple = table_page->GetFirstTupleRid(&first_valid_rid);
         table_page->RUnlatch();
@@ -148,7 +148,7 @@ TableIterator &TableIterator::operator++() {
 
     bool found_next_tuple_rid = false;
     if (current_page) {
-        auto current_table = reinterpret_cast<TablePage *>(current_page->GetData());
+        auto current_table = reinterpret_cast<TablePage *>(current_page);
         current_table->RLatch();
         found_next_tuple_rid = current_table->GetNextTupleRid(rid_, &next_rid);
         current_table->RUnlatch();
@@ -159,9 +159,12 @@ TableIterator &TableIterator::operator++() {
         if (!found_next_tuple_rid) {
             // If not found on the current page, start scan from the beginning of the next page
             page_id_t cur_page_id = next_page_id;
+            // Heap pages are mostly allocated in order, read the following ones in while this one is processed.
+            if (cur_page_id != INVALID_PAGE_ID)
+                table_heap_->buffer_pool_manager_->Prefetch(cur_page_id + 1, READ_AHEAD_PAGES);
             while (cur_page_id != INVALID_PAGE_ID) {
                 Page* cur_page = table_heap_->buffer_pool_manager_->FetchPage(cur_page_id);
-                auto cur_table = reinterpret_cast<TablePage *>(cur_page->GetData());
+                auto cur_table = reinterpret_cast<TablePage *>(cur_page);
                 
                 RowId first_rid;
                 cur_table->RLatch();
@@ -201,7 +204,7 @@ TableIterator &TableIterator::operator++() {
 
     Page* new_data_page = table_heap_->buffer_pool_manager_->FetchPage(rid_.GetPageId());
     if (new_data_page) {
-        auto new_data_table = reinterpret_cast<TablePage *>(new_data_page->GetData());
+        auto new_data_table = reinterpret_cast<TablePage *>(new_data_page);
         new_data_table->RLatch();
         bool get_tuple = new_data_table->GetTuple(&row_, table_heap_->schema_, txn_, table_heap_->lock_manager_);
         new_data_table->RUnlatch();
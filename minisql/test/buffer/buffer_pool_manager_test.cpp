@@ -1,8 +1,12 @@
 #include "buffer/buffer_pool_manager.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -72,4 +76,462 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   delete bpm;
   delete disk_manager;
-}
\ No newline at end of file
+}
+TEST(BufferPoolManagerTest, ShardedPoolTest) {
+  const std::string db_name = "bpm_sharded_test.db";
+  const size_t buffer_pool_size = 16;
+  const size_t num_shards = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_shards);
+  ASSERT_EQ(num_shards, bpm->GetShardCount());
+
+  // Scenario: consecutive page ids are spread over all shards, so the whole pool can be filled.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(i, page_id_temp);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id_temp);
+  }
+  // Scenario: the shard of the next page id is full, the page id must be given back.
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_TRUE(bpm->IsPageFree(buffer_pool_size));
+
+  // Scenario: a pinned page can not be deleted, an unpinned one can.
+  EXPECT_FALSE(bpm->DeletePage(3));
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, true));
+  }
+  EXPECT_TRUE(bpm->DeletePage(3));
+  EXPECT_TRUE(bpm->IsPageFree(3));
+
+  // Scenario: evicted pages are written back and read again through their own shard.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+  }
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    if (i == 3) continue;
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page-" + std::to_string(i), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  disk_manager->Close();
+  remove(db_name.c_str());
+
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BufferPoolManagerTest, DISABLED_ShardedConcurrentFetchBenchmark) {
+  const std::string db_name = "bpm_bench_test.db";
+  const size_t buffer_pool_size = 1024;
+  const size_t num_pages = 512;
+  const size_t ops_per_thread = 50000;
+
+  for (size_t num_shards : {1, 16}) {
+    remove(db_name.c_str());
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_shards);
+    page_id_t page_id_temp;
+    for (size_t i = 0; i < num_pages; ++i) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+      bpm->UnpinPage(page_id_temp, true);
+    }
+
+    for (size_t num_threads : {1, 2, 4, 8}) {
+      std::vector<std::thread> threads;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([bpm, t] {
+          std::default_random_engine rng(t);
+          std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+          for (size_t i = 0; i < ops_per_thread; ++i) {
+            page_id_t page_id = dist(rng);
+            if (bpm->FetchPage(page_id) != nullptr) {
+              bpm->UnpinPage(page_id, false);
+            }
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "[BPM] shards=" << num_shards << " threads=" << num_threads << " fetch+unpin/s="
+                << static_cast<size_t>(num_threads * ops_per_thread / elapsed.count()) << std::endl;
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+    delete bpm;
+    delete disk_manager;
+    remove(db_name.c_str());
+  }
+}
+
+TEST(BufferPoolManagerTest, ConcurrentFetchEvictTest) {
+  const std::string db_name = "bpm_evict_test.db";
+  const size_t buffer_pool_size = 16;
+  const size_t num_pages = 64;
+  const size_t num_threads = 8;
+  const size_t ops_per_thread = 5000;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, 2);
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < num_pages; ++i) {
+    Page *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    memcpy(page->GetData() + 64, &page_id_temp, sizeof(page_id_t));
+    bpm->UnpinPage(page_id_temp, true);
+  }
+
+  // Hits race with evictions of the same frames, every pinned page must hold its own contents.
+  std::atomic<size_t> mismatches{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([bpm, t, &mismatches] {
+      std::default_random_engine rng(t);
+      std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+      for (size_t i = 0; i < ops_per_thread; ++i) {
+        page_id_t page_id = dist(rng);
+        Page *page = bpm->FetchPage(page_id);
+        if (page == nullptr) {
+          continue;
+        }
+        page_id_t stored;
+        memcpy(&stored, page->GetData() + 64, sizeof(page_id_t));
+        if (page->GetPageId() != page_id || stored != page_id) {
+          mismatches++;
+        }
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, mismatches.load());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, DISABLED_HitLatencyBenchmark) {
+  const std::string db_name = "bpm_hit_test.db";
+  const size_t buffer_pool_size = 1024;
+  const size_t num_pages = 256;
+  const size_t total_ops = 400000;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < num_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    bpm->UnpinPage(page_id_temp, true);
+  }
+
+  // Every page is resident, so each fetch is served by the latch-free hit path.
+  for (size_t num_threads : {1, 4, 16, 64}) {
+    const size_t ops_per_thread = total_ops / num_threads;
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([bpm, t, ops_per_thread] {
+        std::default_random_engine rng(t);
+        std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+        for (size_t i = 0; i < ops_per_thread; ++i) {
+          page_id_t page_id = dist(rng);
+          if (bpm->FetchPage(page_id) != nullptr) {
+            bpm->UnpinPage(page_id, false);
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[BPM] hit path threads=" << num_threads
+              << " ns/fetch+unpin=" << elapsed.count() / (num_threads * ops_per_thread) << std::endl;
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, DISABLED_ReplacementPolicyHitRatioBenchmark) {
+  const std::string db_name = "bpm_policy_test.db";
+  const size_t buffer_pool_size = 256;
+  const page_id_t num_hot_pages = 160;
+  const page_id_t num_scan_pages = 2048;
+  const size_t rows_per_page = 4;
+  const size_t scan_pages_per_lookup = 2;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  {
+    // Pages [0, num_hot_pages) play the index working set, the rest is a table that gets scanned.
+    BufferPoolManager bpm(buffer_pool_size, disk_manager);
+    page_id_t page_id_temp;
+    for (page_id_t i = 0; i < num_hot_pages + num_scan_pages; ++i) {
+      ASSERT_NE(nullptr, bpm.NewPage(page_id_temp));
+      bpm.UnpinPage(page_id_temp, true);
+    }
+  }
+
+  const std::vector<std::pair<ReplacerType, std::string>> policies = {
+      {ReplacerType::kLRU, "LRU"}, {ReplacerType::kClock, "CLOCK"}, {ReplacerType::kLRUK, "LRU-2"}, {ReplacerType::k2Q, "2Q"}};
+  for (auto &policy : policies) {
+    BufferPoolManager bpm(buffer_pool_size, disk_manager, 1, policy.first);
+    std::default_random_engine rng(0);
+    std::uniform_int_distribution<page_id_t> hot_dist(0, num_hot_pages - 1);
+    auto fetch = [&bpm](page_id_t page_id) {
+      ASSERT_NE(nullptr, bpm.FetchPage(page_id));
+      bpm.UnpinPage(page_id, false);
+    };
+    // Warm the working set up before the scan starts.
+    for (size_t i = 0; i < 4 * num_hot_pages; ++i) {
+      fetch(hot_dist(rng));
+    }
+
+    // Point lookups interleaved with a full scan that reads every table page row by row.
+    size_t hot_hits = 0;
+    size_t hot_lookups = 0;
+    size_t hits_before = bpm.GetHitCount();
+    size_t misses_before = bpm.GetMissCount();
+    for (size_t pass = 0; pass < 2; ++pass) {
+      for (page_id_t scan_page = num_hot_pages; scan_page < num_hot_pages + num_scan_pages; ++scan_page) {
+        for (size_t row = 0; row < rows_per_page; ++row) {
+          fetch(scan_page);
+        }
+        if (scan_page % scan_pages_per_lookup == 0) {
+          size_t misses = bpm.GetMissCount();
+          fetch(hot_dist(rng));
+          hot_hits += bpm.GetMissCount() == misses ? 1 : 0;
+          hot_lookups++;
+        }
+      }
+    }
+    size_t hits = bpm.GetHitCount() - hits_before;
+    size_t misses = bpm.GetMissCount() - misses_before;
+    std::cout << "[BPM] policy=" << policy.second << " hot set hit ratio=" << static_cast<double>(hot_hits) / hot_lookups
+              << " overall hit ratio=" << static_cast<double>(hits) / (hits + misses) << std::endl;
+    EXPECT_TRUE(bpm.CheckAllUnpinned());
+  }
+
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+static void BackgroundFlusher(page_id_t num_pages, size_t num_ops) {
+  const std::string db_name = "bpm_flusher_test.db";
+  const size_t buffer_pool_size = 64;
+
+  for (bool background : {false, true}) {
+    remove(db_name.c_str());
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+    page_id_t page_id_temp;
+    for (page_id_t i = 0; i < num_pages; ++i) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+      bpm->UnpinPage(page_id_temp, true);
+    }
+    size_t foreground_before = bpm->GetForegroundWriteCount();
+    if (background) {
+      bpm->StartFlusher(0.5, std::chrono::milliseconds(1));
+    }
+
+    // Updates with a hot spot: most of them hit a small range, the rest keep evicting.
+    std::default_random_engine rng(0);
+    std::uniform_int_distribution<page_id_t> page_dist(0, num_pages - 1);
+    std::uniform_int_distribution<page_id_t> hot_dist(0, buffer_pool_size / 2 - 1);
+    std::vector<uint32_t> versions(num_pages, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_ops; ++i) {
+      page_id_t page_id = i % 4 == 0 ? page_dist(rng) : hot_dist(rng);
+      Page *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page);
+      uint32_t version;
+      memcpy(&version, page->GetData() + 64, sizeof(version));
+      ASSERT_EQ(versions[page_id], version);
+      versions[page_id] = version + 1;
+      memcpy(page->GetData() + 64, &versions[page_id], sizeof(version));
+      bpm->UnpinPage(page_id, true);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    bpm->StopFlusher();
+    std::cout << "[BPM] flusher=" << (background ? "on" : "off")
+              << " foreground writes=" << bpm->GetForegroundWriteCount() - foreground_before
+              << " background writes=" << bpm->GetBackgroundWriteCount() << " elapsed ms=" << elapsed.count()
+              << std::endl;
+    if (!background) {
+      EXPECT_EQ(0, bpm->GetBackgroundWriteCount());
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+    delete bpm;
+    delete disk_manager;
+    remove(db_name.c_str());
+  }
+}
+
+TEST(BufferPoolManagerTest, BackgroundFlusherTest) { BackgroundFlusher(256, 2000); }
+
+TEST(BufferPoolManagerTest, DISABLED_BackgroundFlusherBenchmark) { BackgroundFlusher(1024, 20000); }
+
+static void EvictionCoalescing(page_id_t num_pages) {
+  const std::string db_name = "bpm_coalesce_test.db";
+  const size_t buffer_pool_size = 256;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+
+  // Fill pages in order, every eviction finds a run of dirty neighbours behind the victim.
+  size_t calls = disk_manager->GetIOCallCount();
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    ASSERT_EQ(i, page_id);
+    memcpy(page->GetData(), &page_id, sizeof(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  size_t written = bpm->GetForegroundWriteCount();
+  double mb = static_cast<double>(written) * PAGE_SIZE / (1 << 20);
+  std::cout << "[BPM] eviction pages written=" << written
+            << " syscalls/MB=" << (disk_manager->GetIOCallCount() - calls) / mb << std::endl;
+  EXPECT_GE(written, static_cast<size_t>(num_pages) - buffer_pool_size);
+
+  // Every page made it to disk in one piece.
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, memcmp(page->GetData(), &i, sizeof(i)));
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, EvictionCoalescingTest) { EvictionCoalescing(512); }
+
+TEST(BufferPoolManagerTest, DISABLED_EvictionCoalescingBenchmark) { EvictionCoalescing(4096); }
+
+static void GroupCommit(size_t commits_per_thread) {
+  const std::string db_name = "bpm_group_commit_test.db";
+  const size_t buffer_pool_size = 64;
+  const std::pair<SyncPolicy, const char *> policies[] = {
+      {SyncPolicy::kNone, "none"}, {SyncPolicy::kPerCommit, "commit"}, {SyncPolicy::kInterval, "interval"}};
+  for (auto &policy : policies) {
+    for (size_t committers : {1, 2, 4, 8}) {
+      remove(db_name.c_str());
+      auto *disk_manager = new DiskManager(db_name);
+      auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+      disk_manager->SetSyncPolicy(policy.first, std::chrono::milliseconds(10));
+      page_id_t page_id;
+      for (size_t i = 0; i < committers; i++) {
+        ASSERT_NE(nullptr, bpm->NewPage(page_id));
+        bpm->UnpinPage(page_id, true);
+      }
+      bpm->Commit();
+      size_t syncs = disk_manager->GetSyncCount();
+
+      // Every committer updates its own page and commits it.
+      auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> threads;
+      for (size_t t = 0; t < committers; t++) {
+        threads.emplace_back([bpm, t, commits_per_thread]() {
+          for (size_t i = 0; i < commits_per_thread; i++) {
+            Page *page = bpm->FetchPage(static_cast<page_id_t>(t));
+            ASSERT_NE(nullptr, page);
+            page->WLatch();
+            memcpy(page->GetData(), &i, sizeof(i));
+            page->WUnlatch();
+            bpm->UnpinPage(static_cast<page_id_t>(t), true);
+            bpm->Commit();
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      size_t commits = committers * commits_per_thread;
+      syncs = disk_manager->GetSyncCount() - syncs;
+      std::cout << "[BPM] sync=" << policy.second << " committers=" << committers
+                << " commits/s=" << static_cast<size_t>(commits / seconds)
+                << " fdatasync/commit=" << static_cast<double>(syncs) / commits << std::endl;
+      if (policy.first == SyncPolicy::kNone) {
+        EXPECT_EQ(0, syncs);
+      } else if (policy.first == SyncPolicy::kPerCommit) {
+        EXPECT_GE(syncs, 1);
+        EXPECT_LE(syncs, commits);
+        // Every committed page was written before its commit returned.
+        for (size_t t = 0; t < committers; t++) {
+          char data[PAGE_SIZE];
+          disk_manager->ReadPage(static_cast<page_id_t>(t), data);
+          size_t last = commits_per_thread - 1;
+          EXPECT_EQ(0, memcmp(data, &last, sizeof(last)));
+        }
+      }
+      EXPECT_TRUE(bpm->CheckAllUnpinned());
+      delete bpm;
+      delete disk_manager;
+    }
+  }
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, GroupCommitTest) { GroupCommit(10); }
+
+TEST(BufferPoolManagerTest, DISABLED_GroupCommitBenchmark) { GroupCommit(100); }
+
+TEST(BufferPoolManagerTest, CommitDuringFlushTest) {
+  const std::string db_name = "bpm_commit_flush_test.db";
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 16;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  disk_manager->SetSyncPolicy(SyncPolicy::kPerCommit);
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  // The flusher keeps cleaning the pages, a commit finds some of them on their way to disk.
+  bpm->StartFlusher(1.0, std::chrono::milliseconds(0));
+  for (size_t i = 0; i < 5000; ++i) {
+    page_id = static_cast<page_id_t>(i % num_pages);
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    page->WLatch();
+    memcpy(page->GetData(), &i, sizeof(i));
+    page->WUnlatch();
+    bpm->UnpinPage(page_id, true);
+    bpm->Commit();
+    // The commit waited for the write of the flusher as well as for its own.
+    char data[PAGE_SIZE];
+    disk_manager->ReadPage(page_id, data);
+    ASSERT_EQ(0, memcmp(data, &i, sizeof(i))) << i;
+  }
+  bpm->StopFlusher();
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,36 @@
+#include "buffer/clock_replacer.h"
+
+#include "gtest/gtest.h"
+
+TEST(CLOCKReplacerTest, SampleTest) {
+  CLOCKReplacer clock_replacer(7);
+
+  // Scenario: unpin six elements, i.e. add them to the replacer.
+  for (frame_id_t frame_id = 1; frame_id <= 6; frame_id++) {
+    clock_replacer.Unpin(frame_id);
+  }
+  clock_replacer.Unpin(1);
+  EXPECT_EQ(6, clock_replacer.Size());
+
+  // Scenario: every reference bit is set, the hand clears them all and comes back to 1.
+  int value;
+  ASSERT_TRUE(clock_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+
+  // Scenario: 2 and 3 were referenced again, the hand passes them once more.
+  clock_replacer.RecordAccess(2);
+  clock_replacer.RecordAccess(3);
+  ASSERT_TRUE(clock_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+
+  // Scenario: pinned frames leave the clock, the filter skips frames without removing them.
+  clock_replacer.Pin(5);
+  clock_replacer.SetEvictionFilter([](frame_id_t frame_id) { return frame_id != 6; });
+  ASSERT_TRUE(clock_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  ASSERT_TRUE(clock_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  EXPECT_EQ(1, clock_replacer.Size());
+  EXPECT_FALSE(clock_replacer.Victim(&value));
+  EXPECT_EQ(1, clock_replacer.Size());
+}
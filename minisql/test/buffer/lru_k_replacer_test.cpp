@@ -0,0 +1,52 @@
+#include "buffer/lru_k_replacer.h"
+
+#include "gtest/gtest.h"
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2, 1);
+
+  // Scenario: admit six frames, 1 and 2 are referenced again once later frames were admitted.
+  for (frame_id_t frame_id = 1; frame_id <= 6; frame_id++) {
+    lru_k_replacer.Unpin(frame_id);
+  }
+  lru_k_replacer.RecordAccess(2);
+  lru_k_replacer.RecordAccess(1);
+  EXPECT_EQ(6, lru_k_replacer.Size());
+
+  // Scenario: frames referenced only once go first, in admission order.
+  int value;
+  for (frame_id_t expected = 3; expected <= 6; expected++) {
+    ASSERT_TRUE(lru_k_replacer.Victim(&value));
+    EXPECT_EQ(expected, value);
+  }
+
+  // Scenario: among frames with two references the older second-to-last reference loses.
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  lru_k_replacer.Pin(2);
+  EXPECT_EQ(0, lru_k_replacer.Size());
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+}
+
+TEST(LRUKReplacerTest, CorrelatedReferenceTest) {
+  LRUKReplacer lru_k_replacer(5, 2, 2);
+
+  // Scenario: 1 is re-read right after its admission (a scan row by row), which does not count as a second reference.
+  lru_k_replacer.Unpin(1);
+  lru_k_replacer.RecordAccess(1);
+  lru_k_replacer.Unpin(2);
+  lru_k_replacer.Unpin(3);
+  lru_k_replacer.RecordAccess(2);
+  lru_k_replacer.Unpin(4);
+  lru_k_replacer.RecordAccess(2);
+
+  int value;
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+}
@@ -1,5 +1,9 @@
 #include "buffer/lru_replacer.h"
 
+#include <chrono>
+#include <random>
+
+#include "buffer/clock_replacer.h"
 #include "gtest/gtest.h"
 
 TEST(LRUReplacerTest, SampleTest) {
@@ -40,4 +44,44 @@ TEST(LRUReplacerTest, SampleTest) {
   EXPECT_EQ(6, value);
   lru_replacer.Victim(&value);
   EXPECT_EQ(4, value);
-}
\ No newline at end of file
+}
+TEST(LRUReplacerTest, DISABLED_ReplacerOperationBenchmark) {
+  const size_t num_frames = 1024;
+  const size_t num_ops = 200000;
+
+  // Pin/Unpin/RecordAccess/Victim mix as issued by a buffer pool whose frames are all resident.
+  auto run = [&](Replacer *replacer, const char *name) {
+    std::default_random_engine rng(0);
+    std::uniform_int_distribution<frame_id_t> frame_dist(0, num_frames - 1);
+    for (frame_id_t frame_id = 0; frame_id < static_cast<frame_id_t>(num_frames); frame_id++) {
+      replacer->Unpin(frame_id);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_ops; i++) {
+      frame_id_t frame_id = frame_dist(rng);
+      switch (i % 4) {
+        case 0:
+        case 1:
+          replacer->RecordAccess(frame_id);
+          break;
+        case 2:
+          replacer->Pin(frame_id);
+          replacer->Unpin(frame_id);
+          break;
+        default:
+          if (replacer->Victim(&frame_id)) {
+            replacer->Unpin(frame_id);
+          }
+      }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(num_frames, replacer->Size());
+    std::cout << "[Replacer] " << name << " frames=" << num_frames << " ns/op=" << elapsed.count() / num_ops
+              << std::endl;
+  };
+
+  LRUReplacer lru_replacer(num_frames);
+  run(&lru_replacer, "LRU");
+  CLOCKReplacer clock_replacer(num_frames);
+  run(&clock_replacer, "CLOCK");
+}
@@ -0,0 +1,50 @@
+#include "buffer/page_table.h"
+
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+TEST(PageTableTest, SampleTest) {
+  PageTable page_table(4);
+
+  EXPECT_EQ(INVALID_FRAME_ID, page_table.Find(0));
+  page_table.Insert(0, 3);
+  page_table.Insert(8, 1);
+  page_table.Insert(16, 2);
+  EXPECT_EQ(3u, page_table.Size());
+  EXPECT_EQ(3, page_table.Find(0));
+  EXPECT_EQ(1, page_table.Find(8));
+  EXPECT_EQ(2, page_table.Find(16));
+
+  // Re-mapping a page replaces its frame.
+  page_table.Insert(8, 0);
+  EXPECT_EQ(0, page_table.Find(8));
+  EXPECT_EQ(3u, page_table.Size());
+
+  EXPECT_TRUE(page_table.Erase(0));
+  EXPECT_FALSE(page_table.Erase(0));
+  EXPECT_EQ(INVALID_FRAME_ID, page_table.Find(0));
+  EXPECT_EQ(0, page_table.Find(8));
+  EXPECT_EQ(2u, page_table.Size());
+}
+
+TEST(PageTableTest, ChurnTest) {
+  // Keep replacing the resident set so that tombstones pile up and the table has to rebuild itself.
+  const size_t num_frames = 32;
+  PageTable page_table(num_frames);
+  std::unordered_map<page_id_t, frame_id_t> expected;
+  for (page_id_t page_id = 0; page_id < 10000; page_id++) {
+    frame_id_t frame_id = page_id % num_frames;
+    if (page_id >= static_cast<page_id_t>(num_frames)) {
+      ASSERT_TRUE(page_table.Erase(page_id - num_frames));
+      expected.erase(page_id - num_frames);
+    }
+    page_table.Insert(page_id, frame_id);
+    expected[page_id] = frame_id;
+    ASSERT_EQ(expected.size(), page_table.Size());
+  }
+  for (auto &entry : expected) {
+    EXPECT_EQ(entry.second, page_table.Find(entry.first));
+  }
+  EXPECT_EQ(INVALID_FRAME_ID, page_table.Find(0));
+}
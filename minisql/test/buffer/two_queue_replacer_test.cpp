@@ -0,0 +1,35 @@
+#include "buffer/two_queue_replacer.h"
+
+#include "gtest/gtest.h"
+
+TEST(TwoQueueReplacerTest, SampleTest) {
+  // A1 may keep 2 of the 8 frames, a reference promotes a frame once one more frame was admitted after it.
+  TwoQueueReplacer two_queue_replacer(8, 0.25, 1);
+
+  for (frame_id_t frame_id = 0; frame_id < 6; frame_id++) {
+    two_queue_replacer.Unpin(frame_id);
+  }
+  two_queue_replacer.RecordAccess(1);
+  two_queue_replacer.RecordAccess(0);
+  two_queue_replacer.RecordAccess(5);  // Correlated with its own admission, 5 stays in A1.
+  EXPECT_EQ(6, two_queue_replacer.Size());
+
+  // Scenario: A1 holds 2, 3, 4 and 5, more than its share, so it is drained in FIFO order first.
+  int value;
+  ASSERT_TRUE(two_queue_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  ASSERT_TRUE(two_queue_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+
+  // Scenario: A1 is back within its share, the least recently used frame of Am goes next.
+  ASSERT_TRUE(two_queue_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+
+  // Scenario: filtered frames are skipped but stay tracked.
+  two_queue_replacer.SetEvictionFilter([](frame_id_t frame_id) { return frame_id != 0; });
+  ASSERT_TRUE(two_queue_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+  two_queue_replacer.Pin(5);
+  EXPECT_FALSE(two_queue_replacer.Victim(&value));
+  EXPECT_EQ(1, two_queue_replacer.Size());
+}
@@ -39,6 +39,32 @@ TEST(CatalogTest, CatalogMetaTest) {
   delete other;
 }
 
+TEST(CatalogTest, TableMetadataLayoutTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema schema(columns);
+  TableMetadata *meta = TableMetadata::Create(3, "table-1", 5, Schema::DeepCopySchema(&schema), 7);
+  char buf[PAGE_SIZE];
+  uint32_t size = meta->SerializeTo(buf);
+  TableMetadata *other = nullptr;
+  ASSERT_EQ(size, TableMetadata::DeserializeFrom(buf, other));
+  EXPECT_EQ(5, other->GetFirstPageId());
+  EXPECT_EQ(7, other->GetFreeSpaceMapPageId());
+  delete other;
+  other = nullptr;
+  // tables written before the free space map had no page id for it, their map is rebuilt
+  const uint32_t fsm_offset = 4 + 4 + 4 + 7 + 4;
+  memmove(buf + fsm_offset, buf + fsm_offset + 4, size - fsm_offset - 4);
+  MACH_WRITE_UINT32(buf, 344528);
+  ASSERT_EQ(size - 4, TableMetadata::DeserializeFrom(buf, other));
+  EXPECT_EQ(3, other->GetTableId());
+  EXPECT_EQ("table-1", other->GetTableName());
+  EXPECT_EQ(5, other->GetFirstPageId());
+  EXPECT_EQ(INVALID_PAGE_ID, other->GetFreeSpaceMapPageId());
+  EXPECT_EQ(1, other->GetSchema()->GetColumnCount());
+  delete other;
+  delete meta;
+}
+
 TEST(CatalogTest, CatalogTableTest) {
   /** Stage 2: Testing simple operation */
   auto db_01 = new DBStorageEngine(db_file_name, true);
@@ -126,4 +152,53 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, CatalogIndexKeyFormatTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", schema.get(), &txn, table_info));
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+  // an old root for loading to forget
+  for (int i = 0; i < 10; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(Row(fields), RowId(1000, i), &txn));
+  }
+  // pretend the index was written before keys had a format version: its pages are not to be trusted
+  CatalogMeta *catalog_meta = CatalogMeta::DeserializeFrom(db_01->bpm_->FetchPage(CATALOG_META_PAGE_ID)->GetData());
+  db_01->bpm_->UnpinPage(CATALOG_META_PAGE_ID, false);
+  page_id_t index_meta_page_id = catalog_meta->GetIndexMetaPages()->begin()->second;
+  delete catalog_meta;
+  MACH_WRITE_UINT32(db_01->bpm_->FetchPage(index_meta_page_id)->GetData(), 344528);
+  db_01->bpm_->UnpinPage(index_meta_page_id, true);
+  delete db_01;
+
+  // a read-only database cannot rebuild it and loads without it
+  auto db_ro = new DBStorageEngine(db_file_name, false, DEFAULT_BUFFER_POOL_SIZE, true);
+  std::vector<IndexInfo *> loaded_indexes;
+  ASSERT_EQ(DB_SUCCESS, db_ro->catalog_mgr_->GetTableIndexes("table-1", loaded_indexes));
+  ASSERT_TRUE(loaded_indexes.empty());
+  delete db_ro;
+
+  // loading rebuilds it from the table, once
+  for (int round = 0; round < 2; round++) {
+    auto db_02 = new DBStorageEngine(db_file_name, false);
+    IndexInfo *loaded = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_02->catalog_mgr_->GetIndex("table-1", "index-1", loaded));
+    for (int i = 0; i < 100; i++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+      std::vector<RowId> result;
+      ASSERT_EQ(DB_SUCCESS, loaded->GetIndex()->ScanKey(Row(fields), result, &txn)) << i;
+      ASSERT_EQ(1, result.size());
+    }
+    delete db_02;
+  }
+}
@@ -2,6 +2,7 @@
 #define MINISQL_UTILS_H
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <random>
 #include <vector>
@@ -9,6 +10,9 @@
 #include "buffer/buffer_pool_manager.h"
 #include "storage/disk_manager.h"
 
+/** Number of calls to operator new in the test binary, benchmarks use it to count the allocations of the code they run. */
+extern std::atomic<size_t> allocation_count;
+
 template <typename T>
 void ShuffleArray(std::vector<T> &array) {
   std::random_device rd;
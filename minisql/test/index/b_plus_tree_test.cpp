@@ -3,10 +3,18 @@
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "index/comparator.h"
+#include "index/external_sorter.h"
+#include "index/key_search.h"
 #include "utils/tree_file_mgr.h"
 #include "utils/utils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <random>
+#include <thread>
 
 static const std::string db_name = "bp_tree_insert_test.db";
 
@@ -102,4 +110,476 @@ TEST(BPlusTreeTests, SampleTest) {
     ASSERT_TRUE(tree.GetValue(delete_seq[i], ans));
     ASSERT_EQ(kv_map[delete_seq[i]], ans[ans.size() - 1]);
   }
-}
\ No newline at end of file
+}
+
+// Remove most keys in random order from a tree of small nodes, so that internal pages merge and redistribute on every
+// level, then destroy what is left of it
+TEST(BPlusTreeTests, RemoveMergeTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  BPlusTree tree(0, engine.bpm_, KP, 4, 4);
+  const int n = 1000;
+  vector<GenericKey *> keys;
+  vector<int> remove_seq;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key, Row(fields), table_schema);
+    keys.push_back(key);
+    remove_seq.push_back(i);
+    ASSERT_TRUE(tree.Insert(key, RowId(i)));
+  }
+  ShuffleArray(remove_seq);
+  vector<bool> removed(n, false);
+  for (int quarter = 0; quarter < 3; quarter++) {
+    for (int i = quarter * n / 4; i < (quarter + 1) * n / 4; i++) {
+      tree.Remove(keys[remove_seq[i]]);
+      removed[remove_seq[i]] = true;
+    }
+    // every key still there is found, and the leaves hold them in order
+    int remaining = 0;
+    for (int i = 0; i < n; i++) {
+      vector<RowId> ans;
+      ASSERT_EQ(!removed[i], tree.GetValue(keys[i], ans)) << i;
+      remaining += !removed[i];
+    }
+    int64_t last = -1;
+    for (auto it = tree.Begin(); it != tree.End(); ++it) {
+      ASSERT_LT(last, (*it).second.Get());
+      last = (*it).second.Get();
+      remaining--;
+    }
+    ASSERT_EQ(0, remaining);
+  }
+  tree.Destroy();
+  ASSERT_TRUE(tree.IsEmpty());
+  for (auto key : keys) {
+    free(key);
+  }
+  delete table_schema;
+}
+
+TEST(BPlusTreeTests, RemoveReclaimsPagesTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  auto *meta = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData());
+  const uint32_t allocated = meta->GetAllocatedPages();
+  // small nodes, so that removing every key merges pages on every level and collapses the root
+  BPlusTree tree(0, engine.bpm_, KP, 8, 8);
+  const int n = 2000;
+  vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key, Row(fields), table_schema);
+    keys.push_back(key);
+    ASSERT_TRUE(tree.Insert(key, RowId(i)));
+  }
+  ASSERT_LT(allocated + n / 8, meta->GetAllocatedPages());
+
+  // scans run alongside the removals and always see increasing values
+  std::atomic<bool> removing{true};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([&, t] {
+      for (int k = t; k < n; k += 2) {
+        tree.Remove(keys[k]);
+      }
+    });
+    threads.emplace_back([&] {
+      while (removing) {
+        int64_t last = -1;
+        for (auto it = tree.Begin(); it != tree.End(); ++it) {
+          errors += (*it).second.Get() <= last;
+          last = (*it).second.Get();
+        }
+      }
+    });
+  }
+  threads[0].join();
+  threads[2].join();
+  removing = false;
+  threads[1].join();
+  threads[3].join();
+  EXPECT_EQ(0, errors);
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_TRUE(tree.Check());
+  // frees the pages a remover still had pinned when the other one merged them away
+  tree.Destroy();
+  EXPECT_EQ(allocated, meta->GetAllocatedPages());
+  for (auto key : keys) {
+    free(key);
+  }
+  delete table_schema;
+}
+
+// Insert n shuffled keys, look every one of them up, and compare neighbouring keys, for an int key and a char key
+static void KeyThroughput(int n) {
+  const std::string bench_db_name = "bp_tree_benchmark_test.db";
+  for (int use_char = 0; use_char < 2; use_char++) {
+    remove(bench_db_name.c_str());
+    DBStorageEngine engine(bench_db_name);
+    std::vector<Column *> columns = {use_char ? new Column("name", TypeId::kTypeChar, 32, 0, false, false)
+                                              : new Column("id", TypeId::kTypeInt, 0, false, false)};
+    Schema *key_schema = new Schema(columns);
+    KeyManager KP(key_schema, use_char ? 64 : 16);
+    BPlusTree tree(0, engine.bpm_, KP);
+    vector<GenericKey *> keys;
+    for (int i = 0; i < n; i++) {
+      GenericKey *key = KP.InitKey();
+      std::string name = "customer-" + std::to_string(i);
+      std::vector<Field> fields{use_char ? Field(TypeId::kTypeChar, &name[0], name.size(), true)
+                                         : Field(TypeId::kTypeInt, i - n / 2)};
+      KP.SerializeFromKey(key, Row(fields), key_schema);
+      keys.push_back(key);
+    }
+    ShuffleArray(keys);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+      ASSERT_TRUE(tree.Insert(keys[i], RowId(i)));
+    }
+    std::chrono::duration<double> insert_time = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    vector<RowId> result;
+    for (int i = 0; i < n; i++) {
+      result.clear();
+      ASSERT_TRUE(tree.GetValue(keys[i], result));
+      ASSERT_EQ(RowId(i), result[0]);
+    }
+    std::chrono::duration<double> lookup_time = std::chrono::steady_clock::now() - start;
+    const int compares = 1000000;
+    int order = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < compares; i++) {
+      order += KP.CompareKeys(keys[i % n], keys[(i + 1) % n]);
+    }
+    std::chrono::duration<double, std::nano> compare_time = std::chrono::steady_clock::now() - start;
+    std::cout << "[BPlusTree] " << (use_char ? "char(32)" : "int") << " keys=" << n
+              << " insert=" << static_cast<int>(n / insert_time.count()) << " ops/s"
+              << " lookup=" << static_cast<int>(n / lookup_time.count()) << " ops/s"
+              << " compare=" << compare_time.count() / compares << " ns (" << order << ")" << std::endl;
+    ASSERT_TRUE(tree.Check());
+    for (auto key : keys) {
+      free(key);
+    }
+    delete key_schema;
+  }
+  remove(bench_db_name.c_str());
+}
+
+TEST(BPlusTreeTests, KeyThroughputTest) { KeyThroughput(2000); }
+
+TEST(BPlusTreeTests, DISABLED_KeyThroughputBenchmark) { KeyThroughput(100000); }
+
+static void NodeSearch(int searches) {
+  // One node of packed int keys, as many as a leaf of the default size holds
+  const int n = BPlusTreePage::GetCapacity(LEAF_PAGE_HEADER_SIZE, 16 + sizeof(RowId), true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema *key_schema = new Schema(columns);
+  KeyManager KP(key_schema, 16);
+  ASSERT_TRUE(KP.IsPackable());
+  vector<GenericKey *> keys;
+  std::vector<int64_t> packed_keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, 2 * i - n)};
+    KP.SerializeFromKey(key, Row(fields), key_schema);
+    keys.push_back(key);
+    packed_keys.push_back(KeyManager::PackKey(key, KP.GetKeySize()));
+  }
+  // the keys laid out as in a leaf, next to their values
+  const int pair_size = KP.GetKeySize() + sizeof(RowId);
+  std::vector<char> pairs(n * pair_size);
+  for (int i = 0; i < n; i++) {
+    memcpy(&pairs[i * pair_size], keys[i], KP.GetKeySize());
+  }
+  // searched keys fall on and between the keys of the node
+  std::vector<GenericKey *> probes;
+  std::vector<int64_t> packed_probes;
+  for (int i = -2; i < 2 * n + 2; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i - n)};
+    KP.SerializeFromKey(key, Row(fields), key_schema);
+    probes.push_back(key);
+    packed_probes.push_back(KeyManager::PackKey(key, KP.GetKeySize()));
+  }
+  for (size_t i = 0; i < probes.size(); i++) {
+    int expected = KeySearch::LowerBoundScalar(packed_keys.data(), n, packed_probes[i]);
+    ASSERT_EQ(expected, KeySearch::LowerBound(packed_keys.data(), n, packed_probes[i]));
+    ASSERT_EQ(expected, std::lower_bound(keys.begin(), keys.end(), probes[i], [&](GenericKey *lhs, GenericKey *rhs) {
+                          return KP.CompareKeys(lhs, rhs) < 0;
+                        }) - keys.begin());
+  }
+
+  auto run = [&](const char *name, const std::function<int(size_t)> &search) {
+    int64_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+      total += search((i * 7919u) % probes.size());
+    }
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    std::cout << "[BPlusTree] node search " << name << " keys=" << n << " " << time.count() / searches << " ns ("
+              << total << ")" << std::endl;
+  };
+  run("memcmp binary", [&](size_t i) {
+    int left = 0;
+    int right = n;
+    while (left < right) {
+      int mid = (left + right) / 2;
+      if (KP.CompareKeys(reinterpret_cast<GenericKey *>(&pairs[mid * pair_size]), probes[i]) < 0) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    return left;
+  });
+  run("packed binary", [&](size_t i) { return KeySearch::LowerBoundScalar(packed_keys.data(), n, packed_probes[i]); });
+  run(KeySearch::GetInstructionSet(),
+      [&](size_t i) { return KeySearch::LowerBound(packed_keys.data(), n, packed_probes[i]); });
+  for (auto key : keys) {
+    free(key);
+  }
+  for (auto key : probes) {
+    free(key);
+  }
+  delete key_schema;
+}
+
+TEST(BPlusTreeTests, NodeSearchTest) { NodeSearch(1000); }
+
+TEST(BPlusTreeTests, DISABLED_NodeSearchBenchmark) { NodeSearch(2000000); }
+
+static void ConcurrentStress(int n, int ops_per_thread) {
+  const std::string bench_db_name = "bp_tree_concurrent_test.db";
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema *key_schema = new Schema(columns);
+  KeyManager KP(key_schema, 16);
+  vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key, Row(fields), key_schema);
+    keys.push_back(key);
+  }
+
+  for (int num_threads : {1, 2, 4, 8}) {
+    remove(bench_db_name.c_str());
+    DBStorageEngine engine(bench_db_name);
+    // small nodes, so that many operations split or merge them
+    for (int small_nodes = 0; small_nodes < 2; small_nodes++) {
+      BPlusTree tree(small_nodes, engine.bpm_, KP, small_nodes ? 8 : UNDEFINED_SIZE, small_nodes ? 8 : UNDEFINED_SIZE);
+      // the even keys are there from the start, the threads insert the odd ones and look up the even ones
+      for (int i = 0; i < n; i += 2) {
+        ASSERT_TRUE(tree.Insert(keys[i], RowId(i)));
+      }
+      std::atomic<int> errors{0};
+      auto run = [&](const std::function<void(int, std::default_random_engine &)> &work) {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < num_threads; t++) {
+          threads.emplace_back([&, t] {
+            std::default_random_engine rng(t);
+            work(t, rng);
+          });
+        }
+        for (auto &thread : threads) {
+          thread.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+      };
+      // thread t owns the odd keys 2 * (k * num_threads + t) + 1
+      double mixed_time = run([&](int t, std::default_random_engine &rng) {
+        std::uniform_int_distribution<int> dist(0, n / 2 - 1);
+        int next = t;
+        vector<RowId> result;
+        for (int i = 0; i < ops_per_thread; i++) {
+          if (i % 2 == 0 && 2 * next + 1 < n) {
+            errors += !tree.Insert(keys[2 * next + 1], RowId(2 * next + 1));
+            next += num_threads;
+          } else {
+            int k = 2 * dist(rng);
+            result.clear();
+            errors += !tree.GetValue(keys[k], result) || !(result[0] == RowId(k));
+          }
+        }
+      });
+      double remove_time = run([&](int t, std::default_random_engine &) {
+        for (int k = t; 2 * k + 1 < n; k += num_threads) {
+          tree.Remove(keys[2 * k + 1]);
+        }
+      });
+      // scans run while the others insert and remove their odd keys, a scan sees the even keys in order
+      double scan_time = run([&](int t, std::default_random_engine &rng) {
+        std::uniform_int_distribution<int> dist(0, n / 2 - 1);
+        std::deque<int> owned;
+        int next = t;
+        for (int i = 0; i < ops_per_thread; i++) {
+          if (i % 3 == 0 && 2 * next + 1 < n) {
+            errors += !tree.Insert(keys[2 * next + 1], RowId(2 * next + 1));
+            owned.push_back(2 * next + 1);
+            next += num_threads;
+          } else if (i % 3 == 1 && !owned.empty()) {
+            tree.Remove(keys[owned.front()]);
+            owned.pop_front();
+          } else {
+            int k = 2 * dist(rng);
+            int64_t last = k - 1;
+            int steps = 0;
+            for (auto it = tree.Begin(keys[k]); it != tree.End() && steps < 32; ++it, steps++) {
+              int64_t value = (*it).second.Get();
+              errors += value <= last || (value % 2 == 0 && value != last + 1 && value != last + 2);
+              last = value;
+            }
+          }
+        }
+        for (int key : owned) {
+          tree.Remove(keys[key]);
+        }
+      });
+      ASSERT_EQ(0, errors);
+      vector<RowId> result;
+      for (int i = 0; i < n; i++) {
+        result.clear();
+        ASSERT_EQ(i % 2 == 0, tree.GetValue(keys[i], result)) << i;
+      }
+      int count = 0;
+      for (auto it = tree.Begin(); it != tree.End(); ++it) {
+        ASSERT_EQ(2 * count, (*it).second.Get());
+        count++;
+      }
+      ASSERT_EQ(n / 2, count);
+      std::cout << "[BPlusTree] concurrent " << (small_nodes ? "max_size=8" : "default size") << " threads=" << num_threads
+                << " insert+lookup/s=" << static_cast<int>(num_threads * ops_per_thread / mixed_time)
+                << " remove/s=" << static_cast<int>(n / 2 / remove_time)
+                << " insert+remove+scan/s=" << static_cast<int>(num_threads * ops_per_thread / scan_time) << std::endl;
+    }
+  }
+  for (auto key : keys) {
+    free(key);
+  }
+  delete key_schema;
+  remove(bench_db_name.c_str());
+}
+
+TEST(BPlusTreeTests, ConcurrentStressTest) { ConcurrentStress(4000, 2000); }
+
+TEST(BPlusTreeTests, DISABLED_ConcurrentStressBenchmark) { ConcurrentStress(200000, 100000); }
+
+// Sort shuffled keys with little enough memory to spill runs, bulk load them at several fill factors, then keep using
+// the tree
+TEST(BPlusTreeTests, BulkLoadTest) {
+  const int n = 20000;
+  const std::string bulk_db_name = "bp_tree_bulk_load_test.db";
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema *key_schema = new Schema(columns);
+  KeyManager KP(key_schema, 16);
+  const uint32_t key_size = KP.GetKeySize();
+  vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i - n / 2)};
+    KP.SerializeFromKey(key, Row(fields), key_schema);
+    keys.push_back(key);
+  }
+  vector<int> order(n);
+  for (int i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  ShuffleArray(order);
+
+  remove(bulk_db_name.c_str());
+  DBStorageEngine engine(bulk_db_name);
+  int index_id = 0;
+  for (double fill_factor : {0.5, 0.7, INDEX_FILL_FACTOR, 1.0}) {
+    for (int small_nodes = 0; small_nodes < 2; small_nodes++) {
+      ExternalSorter sorter(key_size + sizeof(RowId), key_size, 64 * 1024);
+      vector<char> record(key_size + sizeof(RowId));
+      for (int i : order) {
+        memcpy(record.data(), keys[i], key_size);
+        RowId value(i);
+        memcpy(record.data() + key_size, &value, sizeof(RowId));
+        ASSERT_TRUE(sorter.Add(record.data()));
+      }
+      ASSERT_TRUE(sorter.Sort());
+      ASSERT_GT(sorter.GetRunCount(), 1);
+      BPlusTree tree(index_id++, engine.bpm_, KP, small_nodes ? 8 : UNDEFINED_SIZE, small_nodes ? 8 : UNDEFINED_SIZE);
+      ASSERT_TRUE(tree.BulkLoad(
+          sorter.GetCount(),
+          [&](GenericKey *key, RowId *value) {
+            const char *sorted = sorter.Next();
+            if (sorted == nullptr) {
+              return false;
+            }
+            memcpy(key, sorted, key_size);
+            memcpy(value, sorted + key_size, sizeof(RowId));
+            return true;
+          },
+          fill_factor));
+      ASSERT_EQ(nullptr, sorter.Next());
+      ASSERT_TRUE(tree.Check());
+      int count = 0;
+      for (auto it = tree.Begin(); it != tree.End(); ++it) {
+        ASSERT_EQ(count, (*it).second.Get());
+        count++;
+      }
+      ASSERT_EQ(n, count);
+      vector<RowId> result;
+      for (int i = 0; i < n; i++) {
+        result.clear();
+        ASSERT_TRUE(tree.GetValue(keys[i], result));
+        ASSERT_EQ(RowId(i), result[0]);
+      }
+      // A bulk loaded tree splits and merges like any other
+      ASSERT_FALSE(tree.Insert(keys[0], RowId(0)));
+      for (int i = 0; i < n; i += 2) {
+        tree.Remove(keys[i]);
+      }
+      for (int i = 0; i < n; i += 4) {
+        ASSERT_TRUE(tree.Insert(keys[i], RowId(i)));
+      }
+      ASSERT_TRUE(tree.Check());
+      for (int i = 0; i < n; i++) {
+        result.clear();
+        ASSERT_EQ(i % 2 == 1 || i % 4 == 0, tree.GetValue(keys[i], result)) << i;
+      }
+      // Only an empty tree can be bulk loaded
+      ASSERT_FALSE(tree.BulkLoad(0, [](GenericKey *, RowId *) { return false; }));
+      tree.Destroy();
+    }
+  }
+
+  // Out of order or duplicate keys, and running short of them, leave the tree empty
+  for (int fault = 0; fault < 3; fault++) {
+    BPlusTree tree(index_id++, engine.bpm_, KP, 8, 8);
+    int next = 0;
+    ASSERT_FALSE(tree.BulkLoad(fault == 2 ? n : n - 1, [&](GenericKey *key, RowId *value) {
+      if (next == n - 1) {
+        return false;
+      }
+      int i = next++;
+      if (i == n / 2) {
+        i = fault == 0 ? i - 2 : i - 1;
+      }
+      memcpy(key, keys[i], key_size);
+      *value = RowId(i);
+      return true;
+    }));
+    ASSERT_TRUE(tree.IsEmpty());
+    ASSERT_TRUE(tree.Insert(keys[0], RowId(0)));
+    ASSERT_TRUE(tree.Check());
+    tree.Destroy();
+  }
+  for (auto key : keys) {
+    free(key);
+  }
+  delete key_schema;
+  remove(bulk_db_name.c_str());
+}
@@ -1,6 +1,24 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include "glog/logging.h"
 #include "gtest/gtest.h"
 
+std::atomic<size_t> allocation_count{0};
+
+void *operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   // testing::GTEST_FLAG(filter) = "BPlusTreeTests*";
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cstring>
 
 #include "common/instance.h"
@@ -5,6 +6,7 @@
 #include "page/table_page.h"
 #include "record/field.h"
 #include "record/row.h"
+#include "record/row_codec.h"
 #include "record/schema.h"
 
 char *chars[] = {const_cast<char *>(""), const_cast<char *>("hello"), const_cast<char *>("world!"),
@@ -100,4 +102,239 @@ TEST(TupleTest, RowTest) {
   }
   ASSERT_TRUE(table_page.MarkDelete(row.GetRowId(), nullptr, nullptr, nullptr));
   table_page.ApplyDelete(row.GetRowId(), nullptr, nullptr);
-}
\ No newline at end of file
+}
+TEST(TupleTest, RowViewTest) {
+  TablePage table_page;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::vector<std::vector<Field>> rows_fields = {
+      {Field(TypeId::kTypeInt, 188), Field(TypeId::kTypeChar, chars[1], strlen(chars[1]), false),
+       Field(TypeId::kTypeFloat, 19.99f)},
+      {Field(TypeId::kTypeInt, -65537), Field(TypeId::kTypeChar), Field(TypeId::kTypeFloat, -2.33f)},
+      {Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeChar, chars[0], 0, false), Field(TypeId::kTypeFloat)}};
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  std::vector<Row> rows;
+  for (auto &fields : rows_fields) {
+    rows.emplace_back(fields);
+    ASSERT_TRUE(table_page.InsertTuple(rows.back(), schema.get(), nullptr, nullptr, nullptr));
+  }
+  ASSERT_TRUE(table_page.MarkDelete(rows[0].GetRowId(), nullptr, nullptr, nullptr));
+
+  // fields are decoded from the page, deleted tuples are not visible
+  RowView view(schema.get());
+  ASSERT_FALSE(table_page.GetTupleView(0, &view));
+  ASSERT_FALSE(table_page.GetTupleView(3, &view));
+  for (uint32_t slot = 1; slot < rows.size(); slot++) {
+    ASSERT_TRUE(table_page.GetTupleView(slot, &view));
+    ASSERT_EQ(rows[slot].GetRowId(), view.GetRowId());
+    for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+      Field field = view.GetField(i);
+      ASSERT_EQ(rows_fields[slot][i].IsNull(), field.IsNull());
+      ASSERT_EQ(rows_fields[slot][i].IsNull(), view.IsNull(i));
+      if (!field.IsNull()) {
+        ASSERT_EQ(CmpBool::kTrue, field.CompareEquals(rows_fields[slot][i]));
+      }
+    }
+  }
+  ASSERT_TRUE(table_page.GetTupleView(1, &view));
+  ASSERT_EQ(-65537, view.GetInt(0));
+  ASSERT_FLOAT_EQ(-2.33f, view.GetFloat(2));
+
+  // a row copied out of the view owns its fields, a projection keeps the columns asked for
+  ASSERT_TRUE(table_page.GetTupleView(2, &view));
+  Row copy;
+  view.ToRow(&copy);
+  ASSERT_EQ(3, copy.GetFieldCount());
+  ASSERT_EQ(rows[2].GetRowId(), copy.GetRowId());
+  ASSERT_EQ(0, copy.GetField(1)->GetLength());
+  ASSERT_TRUE(copy.GetField(2)->IsNull());
+  std::vector<Column *> output_columns = {new Column("account", TypeId::kTypeFloat, 2, true, false),
+                                          new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto output_schema = std::make_shared<Schema>(output_columns);
+  ASSERT_TRUE(table_page.GetTupleView(1, &view));
+  view.ToRow(output_schema.get(), &copy);
+  ASSERT_EQ(2, copy.GetFieldCount());
+  ASSERT_EQ(CmpBool::kTrue, copy.GetField(0)->CompareEquals(Field(TypeId::kTypeFloat, -2.33f)));
+  ASSERT_EQ(CmpBool::kTrue, copy.GetField(1)->CompareEquals(Field(TypeId::kTypeInt, -65537)));
+}
+
+TEST(TupleTest, RowArenaTest) {
+  TablePage table_page;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeFloat)};
+  Row row(fields);
+  ASSERT_TRUE(table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr));
+  RowView view(schema.get());
+  ASSERT_TRUE(table_page.GetTupleView(0, &view));
+
+  Row copy;
+  {
+    MemoryArena arena;
+    Row arena_row;
+    view.ToRow(&arena_row, &arena);
+    ASSERT_EQ(&arena, arena_row.GetArena());
+    ASSERT_GT(arena.GetAllocatedBytes(), 0);
+    // moving keeps the fields where they are, copying makes an ordinary row that owns its characters
+    Row moved(std::move(arena_row));
+    ASSERT_EQ(0, arena_row.GetFieldCount());
+    ASSERT_EQ(&arena, moved.GetArena());
+    copy = moved;
+    ASSERT_EQ(nullptr, copy.GetArena());
+    for (size_t i = 0; i < fields.size(); i++) {
+      ASSERT_EQ(fields[i].IsNull(), moved.GetField(i)->IsNull());
+      ASSERT_EQ(fields[i].IsNull(), copy.GetField(i)->IsNull());
+      if (!fields[i].IsNull()) {
+        ASSERT_EQ(CmpBool::kTrue, moved.GetField(i)->CompareEquals(fields[i]));
+      }
+    }
+    moved.destroy();
+    arena.Reset();
+    ASSERT_EQ(0, arena.GetAllocatedBytes());
+    ASSERT_EQ(1, arena.GetBlockCount());
+    // a large request gets a block of its own
+    ASSERT_NE(nullptr, arena.Allocate(MemoryArena::BLOCK_SIZE));
+    ASSERT_EQ(2, arena.GetBlockCount());
+  }
+  ASSERT_EQ("minisql", copy.GetField(1)->toString());
+
+  // a moved field gives up its characters
+  Field owner(TypeId::kTypeChar, const_cast<char *>("hello"), 5, true);
+  Field taker(std::move(owner));
+  ASSERT_EQ("hello", taker.toString());
+  Row moved_row(std::move(row));
+  ASSERT_EQ(3, moved_row.GetFieldCount());
+  ASSERT_EQ(0, row.GetFieldCount());
+}
+
+// Row serialization as it was done before RowCodec: one call through Type::GetInstance per field.
+static uint32_t SerializeFieldByField(Row &row, char *buf) {
+  uint32_t field_nums = row.GetFieldCount();
+  MACH_WRITE_UINT32(buf, field_nums);
+  char *bitmap = buf + sizeof(uint32_t);
+  memset(bitmap, 0, (field_nums + 7) / 8);
+  char *pos = bitmap + (field_nums + 7) / 8;
+  for (uint32_t i = 0; i < field_nums; i++) {
+    if (row.GetField(i)->IsNull()) {
+      bitmap[i / 8] |= static_cast<char>(1 << (i % 8));
+    } else {
+      pos += row.GetField(i)->SerializeTo(pos);
+    }
+  }
+  return static_cast<uint32_t>(pos - buf);
+}
+
+static uint32_t SizeFieldByField(Row &row) {
+  uint32_t size = sizeof(uint32_t) + (row.GetFieldCount() + 7) / 8;
+  for (auto field : row.GetFields()) {
+    size += field->GetSerializedSize();
+  }
+  return size;
+}
+
+static uint32_t DeserializeFieldByField(char *buf, Schema *schema, Row *row) {
+  row->destroy();
+  uint32_t field_nums = MACH_READ_UINT32(buf);
+  char *bitmap = buf + sizeof(uint32_t);
+  char *pos = bitmap + (field_nums + 7) / 8;
+  for (uint32_t i = 0; i < field_nums; i++) {
+    Field *field = nullptr;
+    pos += Field::DeserializeFrom(pos, schema->GetColumn(i)->GetType(), &field, bitmap[i / 8] & (1 << (i % 8)));
+    row->GetFields().push_back(field);
+  }
+  return static_cast<uint32_t>(pos - buf);
+}
+
+static void RowCodec(int row_nums) {
+  std::vector<Column *> fixed_columns, mixed_columns;
+  for (uint32_t i = 0; i < 8; i++) {
+    fixed_columns.push_back(new Column("c" + std::to_string(i), i % 2 ? kTypeFloat : kTypeInt, i, true, false));
+  }
+  mixed_columns = {new Column("id", kTypeInt, 0, false, false), new Column("name", kTypeChar, 32, 1, true, false),
+                   new Column("account", kTypeFloat, 2, true, false), new Column("tag", kTypeChar, 16, 3, true, false)};
+  Schema fixed_schema(fixed_columns), mixed_schema(mixed_columns);
+  ASSERT_TRUE(fixed_schema.GetRowCodec().IsFixedWidth());
+  ASSERT_FALSE(mixed_schema.GetRowCodec().IsFixedWidth());
+
+  for (Schema *schema : {&fixed_schema, &mixed_schema}) {
+    std::vector<Row> rows;
+    rows.reserve(row_nums);
+    for (int i = 0; i < row_nums; i++) {
+      std::vector<Field> fields;
+      for (uint32_t j = 0; j < schema->GetColumnCount(); j++) {
+        TypeId type = schema->GetColumn(j)->GetType();
+        if (j > 0 && (i + j) % 16 == 0) {
+          fields.emplace_back(type);
+        } else if (type == kTypeInt) {
+          fields.emplace_back(kTypeInt, static_cast<int32_t>(i * 8 + j));
+        } else if (type == kTypeFloat) {
+          fields.emplace_back(kTypeFloat, i * 0.5f + j);
+        } else {
+          std::string value = "value-" + std::to_string(i);
+          fields.emplace_back(kTypeChar, &value[0], value.size(), true);
+        }
+      }
+      rows.emplace_back(fields);
+    }
+    // the codec writes the same bytes as the field by field path, and reads them back
+    std::vector<char> expected(PAGE_SIZE), actual(PAGE_SIZE);
+    for (int i = 0; i < 1000; i++) {
+      uint32_t size = SerializeFieldByField(rows[i], expected.data());
+      ASSERT_EQ(size, rows[i].GetSerializedSize(schema));
+      ASSERT_EQ(size, rows[i].SerializeTo(actual.data(), schema));
+      ASSERT_EQ(0, memcmp(expected.data(), actual.data(), size));
+      Row row;
+      ASSERT_EQ(size, row.DeserializeFrom(actual.data(), schema));
+      ASSERT_EQ(rows[i].GetFieldCount(), row.GetFieldCount());
+      for (uint32_t j = 0; j < row.GetFieldCount(); j++) {
+        ASSERT_EQ(rows[i].GetField(j)->IsNull(), row.GetField(j)->IsNull());
+        if (!row.GetField(j)->IsNull()) {
+          ASSERT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(*rows[i].GetField(j)));
+        }
+      }
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(row_nums) * SizeFieldByField(rows[0]) * 2);
+    std::vector<uint32_t> offsets(row_nums);
+    double times[2][2];
+    for (int codec = 0; codec < 2; codec++) {
+      auto start = std::chrono::steady_clock::now();
+      uint32_t offset = 0;
+      for (int i = 0; i < row_nums; i++) {
+        offsets[i] = offset;
+        if (codec) {
+          ASSERT_LE(offset + rows[i].GetSerializedSize(schema), buffer.size());
+          offset += rows[i].SerializeTo(buffer.data() + offset, schema);
+        } else {
+          ASSERT_LE(offset + SizeFieldByField(rows[i]), buffer.size());
+          offset += SerializeFieldByField(rows[i], buffer.data() + offset);
+        }
+      }
+      times[codec][0] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      start = std::chrono::steady_clock::now();
+      Row row;
+      for (int i = 0; i < row_nums; i++) {
+        if (codec) {
+          row.DeserializeFrom(buffer.data() + offsets[i], schema);
+        } else {
+          DeserializeFieldByField(buffer.data() + offsets[i], schema, &row);
+        }
+      }
+      times[codec][1] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout << "[Tuple] " << (schema == &fixed_schema ? "8 int/float columns" : "int, char, float, char") << " rows="
+              << row_nums << " serialize field by field=" << times[0][0] << " ms codec=" << times[1][0]
+              << " ms, deserialize field by field=" << times[0][1] << " ms codec=" << times[1][1] << " ms" << std::endl;
+  }
+}
+
+TEST(TupleTest, RowCodecTest) { RowCodec(1000); }
+
+TEST(TupleTest, DISABLED_RowCodecBenchmark) { RowCodec(200000); }
@@ -1,8 +1,22 @@
 #include "storage/disk_manager.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
+#include "common/crc32c.h"
+#include "common/lz_codec.h"
 #include "gtest/gtest.h"
+#include "page/page.h"
+#include "storage/compressed_page_store.h"
 
 TEST(DiskManagerTest, BitMapPageTest) {
   const size_t size = 512;
@@ -20,6 +34,7 @@ TEST(DiskManagerTest, BitMapPageTest) {
     ASSERT_TRUE(page_set.find(ofs) == page_set.end());
     page_set.insert(ofs);
   }
+  ASSERT_EQ(num_pages, bitmap->CountAllocatedPages());
   ASSERT_FALSE(bitmap->AllocatePage(ofs));
   ASSERT_TRUE(bitmap->DeAllocatePage(233));
   ASSERT_TRUE(bitmap->AllocatePage(ofs));
@@ -56,4 +71,560 @@ TEST(DiskManagerTest, FreePageAllocationTest) {
   EXPECT_EQ(extent_nums * DiskManager::BITMAP_SIZE - 5, meta_page->GetAllocatedPages());
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 2, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 3, meta_page->GetExtentUsedPage(1));
-}
\ No newline at end of file
+}
+
+TEST(DiskManagerTest, SyncAllocationTest) {
+  std::string db_name = "disk_sync_test.db";
+  remove(db_name.c_str());
+  DiskManager disk_mgr(db_name);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(i, disk_mgr.AllocatePage());
+  }
+  disk_mgr.DeAllocatePage(3);
+  // Nothing but the allocation changed, Sync() must still write the meta page and the bitmap.
+  disk_mgr.Sync();
+  char meta[PAGE_SIZE];
+  char bitmap[PAGE_SIZE];
+  int fd = open(db_name.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(PAGE_SIZE, pread(fd, meta, PAGE_SIZE, 0));
+  ASSERT_EQ(PAGE_SIZE, pread(fd, bitmap, PAGE_SIZE, PAGE_SIZE));
+  close(fd);
+  EXPECT_EQ(9, reinterpret_cast<DiskFileMetaPage *>(meta)->GetAllocatedPages());
+  auto *extent = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap);
+  EXPECT_FALSE(extent->IsPageFree(0));
+  EXPECT_TRUE(extent->IsPageFree(3));
+  EXPECT_FALSE(extent->IsPageFree(9));
+  disk_mgr.Close();
+  remove(db_name.c_str());
+}
+
+/** Descriptor this process has open on a file, -1 if there is none. */
+static int FindOpenFile(const std::string &file_name) {
+  auto path = std::filesystem::canonical(file_name);
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/fd")) {
+    std::error_code ec;
+    if (std::filesystem::read_symlink(entry.path(), ec) == path) {
+      return std::stoi(entry.path().filename().string());
+    }
+  }
+  return -1;
+}
+
+TEST(DiskManagerTest, ReadErrorTest) {
+  std::string db_name = "disk_read_error_test.db";
+  remove(db_name.c_str());
+  DiskManager disk_mgr(db_name);
+  disk_mgr.EnableChecksums(true);
+  char data[PAGE_SIZE];
+  memset(data, 'a', PAGE_SIZE);
+  ASSERT_EQ(0, disk_mgr.AllocatePage());
+  ASSERT_TRUE(disk_mgr.WritePage(0, data));
+  // reads of the file fail while its descriptor points to a directory
+  int fd = FindOpenFile(db_name);
+  ASSERT_GE(fd, 0);
+  int saved = dup(fd);
+  int dir = open(".", O_RDONLY | O_DIRECTORY);
+  ASSERT_GE(dup2(dir, fd), 0);
+  char buf[PAGE_SIZE];
+  EXPECT_FALSE(disk_mgr.ReadPage(0, buf));
+  char *bufs[] = {buf};
+  EXPECT_FALSE(disk_mgr.ReadPages(0, 1, bufs));
+  ASSERT_GE(dup2(saved, fd), 0);
+  close(saved);
+  close(dir);
+  ASSERT_TRUE(disk_mgr.ReadPage(0, buf));
+  EXPECT_EQ(0, memcmp(data, buf, PAGE_SIZE - PAGE_CHECKSUM_SIZE));
+  // past the end of the file a page reads as zeros
+  ASSERT_TRUE(disk_mgr.ReadPage(DiskManager::BITMAP_SIZE * 2, buf));
+  EXPECT_EQ(0, buf[0]);
+  disk_mgr.Close();
+  remove(db_name.c_str());
+}
+
+static void Allocation(uint32_t num_extents) {
+  std::string db_name = "disk_alloc_test.db";
+  remove(db_name.c_str());
+  const uint32_t num_pages = DiskManager::BITMAP_SIZE * num_extents;
+  auto *disk_mgr = new DiskManager(db_name);
+  struct stat before;
+  ASSERT_EQ(0, stat(db_name.c_str(), &before));
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  // the bitmaps stay in memory until the file is closed
+  struct stat after;
+  ASSERT_EQ(0, stat(db_name.c_str(), &after));
+  EXPECT_EQ(before.st_size, after.st_size);
+  std::cout << "[DiskManager] allocate pages=" << num_pages << " ns/page=" << elapsed.count() / num_pages
+            << " bytes written=" << after.st_size - before.st_size << std::endl;
+
+  // freed pages are reused lowest first, across extents
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE * 2 + 7);
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 5);
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 3);
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 3));
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 3, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 5, disk_mgr->AllocatePage());
+  disk_mgr->DeAllocatePage(11);
+  delete disk_mgr;
+
+  // everything was written back by Close()
+  disk_mgr = new DiskManager(db_name);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(num_pages - 2, meta_page->GetAllocatedPages());
+  EXPECT_TRUE(disk_mgr->IsPageFree(11));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE * 2 + 7));
+  EXPECT_FALSE(disk_mgr->IsPageFree(12));
+  EXPECT_TRUE(disk_mgr->IsPageFree(num_pages));
+  EXPECT_EQ(11, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE * 2 + 7, disk_mgr->AllocatePage());
+  EXPECT_EQ(num_pages, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, AllocationTest) { Allocation(3); }
+
+TEST(DiskManagerTest, DISABLED_AllocationBenchmark) { Allocation(16); }
+
+TEST(DiskManagerTest, DISABLED_RandomIOBenchmark) {
+  std::string db_name = "disk_bench_test.db";
+  remove(db_name.c_str());
+  const page_id_t num_pages = 2048;
+  const size_t ops_per_thread = 20000;
+  auto *disk_mgr = new DiskManager(db_name);
+  char data[PAGE_SIZE];
+  memset(data, 0, PAGE_SIZE);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    memcpy(data, &i, sizeof(i));
+    disk_mgr->WritePage(i, data);
+  }
+
+  for (bool write : {false, true}) {
+    for (size_t num_threads : {1, 4}) {
+      std::atomic<size_t> mismatches{0};
+      std::vector<std::thread> threads;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([disk_mgr, t, num_threads, write, &mismatches] {
+          std::default_random_engine rng(t);
+          std::uniform_int_distribution<page_id_t> page_dist(0, num_pages - 1);
+          char buf[PAGE_SIZE];
+          for (size_t i = 0; i < ops_per_thread / num_threads; i++) {
+            page_id_t page_id = page_dist(rng);
+            if (write) {
+              memset(buf, 0, PAGE_SIZE);
+              memcpy(buf, &page_id, sizeof(page_id));
+              disk_mgr->WritePage(page_id, buf);
+            } else {
+              disk_mgr->ReadPage(page_id, buf);
+              page_id_t stored;
+              memcpy(&stored, buf, sizeof(stored));
+              mismatches += stored != page_id ? 1 : 0;
+            }
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      EXPECT_EQ(0, mismatches.load());
+      std::cout << "[DiskManager] random " << (write ? "write" : "read") << " threads=" << num_threads
+                << " IOPS=" << static_cast<size_t>(ops_per_thread / elapsed.count()) << std::endl;
+    }
+  }
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+static void AsyncQueueDepth(page_id_t num_pages, size_t num_ops) {
+  std::string db_name = "disk_async_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  char data[PAGE_SIZE];
+  memset(data, 0, PAGE_SIZE);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    memcpy(data, &i, sizeof(i));
+    disk_mgr->WritePage(i, data);
+  }
+
+  for (size_t queue_depth : {1, 8, 32}) {
+    auto io = disk_mgr->CreateAsyncIOContext(queue_depth);
+    std::vector<char> buffers(queue_depth * PAGE_SIZE);
+    std::vector<page_id_t> wanted(queue_depth);
+    std::vector<size_t> free_slots;
+    for (size_t i = 0; i < queue_depth; i++) {
+      free_slots.push_back(i);
+    }
+    std::default_random_engine rng(0);
+    std::uniform_int_distribution<page_id_t> page_dist(0, num_pages - 1);
+    std::vector<AsyncIOResult> results;
+    size_t submitted = 0;
+    size_t mismatches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t completed = 0; completed < num_ops;) {
+      // keep the queue full, then reap whatever finished
+      while (submitted < num_ops && !free_slots.empty()) {
+        size_t slot = free_slots.back();
+        free_slots.pop_back();
+        wanted[slot] = page_dist(rng);
+        ASSERT_TRUE(disk_mgr->SubmitReadPage(io.get(), wanted[slot], buffers.data() + slot * PAGE_SIZE, slot));
+        submitted++;
+      }
+      results.clear();
+      completed += disk_mgr->CompletePages(io.get(), &results, 1);
+      for (auto &result : results) {
+        page_id_t stored;
+        memcpy(&stored, result.buf, sizeof(stored));
+        mismatches += stored != wanted[result.tag] ? 1 : 0;
+        free_slots.push_back(result.tag);
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(0, mismatches);
+    std::cout << "[DiskManager] async random read (" << io->GetName() << ") queue depth=" << queue_depth
+              << " IOPS=" << static_cast<size_t>(num_ops / elapsed.count()) << std::endl;
+  }
+
+  // writes through the fallback backend land on disk too
+  int fd = open(db_name.c_str(), O_RDWR);
+  auto io = AsyncIOContext::Create(fd, 8, false);
+  EXPECT_STREQ("thread pool", io->GetName());
+  std::vector<AsyncIOResult> results;
+  memset(data, 0, PAGE_SIZE);
+  page_id_t page_id = num_pages;
+  memcpy(data, &page_id, sizeof(page_id));
+  ASSERT_EQ(num_pages, disk_mgr->AllocatePage());
+  ASSERT_TRUE(disk_mgr->SubmitWritePage(io.get(), page_id, data, 0));
+  ASSERT_EQ(1, disk_mgr->CompletePages(io.get(), &results, 1));
+  EXPECT_EQ(PAGE_SIZE, results[0].result);
+  char buf[PAGE_SIZE];
+  disk_mgr->ReadPage(page_id, buf);
+  EXPECT_EQ(0, memcmp(data, buf, PAGE_SIZE));
+  io.reset();
+  close(fd);
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, AsyncQueueDepthTest) { AsyncQueueDepth(64, 500); }
+
+TEST(DiskManagerTest, DISABLED_AsyncQueueDepthBenchmark) { AsyncQueueDepth(2048, 20000); }
+
+static void VectoredIO(size_t num_pages) {
+  std::string db_name = "disk_vectored_test.db";
+  remove(db_name.c_str());
+  const size_t run_length = 32;
+  auto *disk_mgr = new DiskManager(db_name);
+  std::vector<char> data(num_pages * PAGE_SIZE);
+  std::vector<char *> pages(num_pages);
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    pages[i] = data.data() + i * PAGE_SIZE;
+    memset(pages[i], static_cast<char>(i), PAGE_SIZE);
+  }
+  const double mb = static_cast<double>(num_pages) * PAGE_SIZE / (1 << 20);
+
+  for (bool vectored : {false, true}) {
+    for (bool write : {true, false}) {
+      size_t calls = disk_mgr->GetIOCallCount();
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < num_pages; i += vectored ? run_length : 1) {
+        if (vectored && write) {
+          disk_mgr->WritePages(i, run_length, pages.data() + i);
+        } else if (vectored) {
+          disk_mgr->ReadPages(i, run_length, pages.data() + i);
+        } else if (write) {
+          disk_mgr->WritePage(i, pages[i]);
+        } else {
+          disk_mgr->ReadPage(i, pages[i]);
+        }
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "[DiskManager] sequential " << (write ? "write" : "read") << " vectored=" << vectored
+                << " syscalls/MB=" << (disk_mgr->GetIOCallCount() - calls) / mb
+                << " MB/s=" << static_cast<size_t>(mb / elapsed.count()) << std::endl;
+    }
+    for (size_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(static_cast<char>(i), pages[i][PAGE_SIZE - 1]);
+    }
+  }
+
+  // a run across an extent boundary skips the bitmap page, and reads past the end of the file come back zeroed
+  page_id_t first = DiskManager::BITMAP_SIZE - 2;
+  while (disk_mgr->AllocatePage() < first + 3) {
+  }
+  EXPECT_FALSE(DiskManager::IsNextPhysicalPage(first + 1, first + 2));
+  disk_mgr->WritePages(first, 3, pages.data());
+  char buf[PAGE_SIZE];
+  for (page_id_t i = 0; i < 3; i++) {
+    disk_mgr->ReadPage(first + i, buf);
+    EXPECT_EQ(0, memcmp(buf, pages[i], PAGE_SIZE));
+  }
+  disk_mgr->ReadPages(first + 3, 3, pages.data());
+  EXPECT_EQ(0, pages[0][0]);
+  EXPECT_EQ(0, pages[1][PAGE_SIZE - 1]);
+  EXPECT_EQ(0, pages[2][0]);
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, VectoredIOTest) { VectoredIO(256); }
+
+TEST(DiskManagerTest, DISABLED_VectoredIOBenchmark) { VectoredIO(4096); }
+
+TEST(DiskManagerTest, ChecksumTest) {
+  // known answer, and the hardware and software paths agree on every length and alignment
+  const char *digits = "123456789";
+  EXPECT_EQ(0xE3069283, Crc32c(digits, 9));
+  EXPECT_EQ(0xE3069283, Crc32cSoftware(digits, 9));
+  EXPECT_EQ(Crc32c(digits + 4, 5, Crc32c(digits, 4)), Crc32c(digits, 9));
+  std::mt19937 rng(5);
+  char random[PAGE_SIZE + 8];
+  for (auto &c : random) {
+    c = static_cast<char>(rng());
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t len : {0, 1, 7, 8, 9, 63, 4079, 4080, 4092}) {
+      EXPECT_EQ(Crc32cSoftware(random + offset, len), Crc32c(random + offset, len));
+    }
+  }
+
+  std::string db_name = "disk_checksum_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  page_id_t plain = disk_mgr->AllocatePage();
+  page_id_t checked = disk_mgr->AllocatePage();
+  page_id_t torn = disk_mgr->AllocatePage();
+  char data[PAGE_SIZE];
+  memcpy(data, random, PAGE_SIZE);
+  memset(data + PAGE_SIZE - PAGE_CHECKSUM_SIZE, 0, PAGE_CHECKSUM_SIZE);  // pages leave their trailer alone
+  disk_mgr->WritePage(plain, data);
+  disk_mgr->EnableChecksums(true);
+  for (page_id_t page_id : {checked, torn}) {
+    memcpy(data, random, PAGE_SIZE);
+    disk_mgr->WritePage(page_id, data);
+    EXPECT_NE(0, Page(data).GetChecksum());
+  }
+
+  // half of a page reaches the disk, the other half keeps an older version
+  int fd = open(db_name.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  char old_half[PAGE_SIZE / 2];
+  memset(old_half, 0x5A, sizeof(old_half));
+  ASSERT_EQ(sizeof(old_half), pwrite(fd, old_half, sizeof(old_half), (torn + 2) * PAGE_SIZE));
+  close(fd);
+
+  char buf[PAGE_SIZE];
+  EXPECT_TRUE(disk_mgr->ReadPage(plain, buf));    // written without a checksum, not verified
+  EXPECT_TRUE(disk_mgr->ReadPage(checked, buf));
+  EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+  EXPECT_TRUE(disk_mgr->ReadPage(checked + 10, buf));  // never written
+  EXPECT_FALSE(disk_mgr->ReadPage(torn, buf));
+  char *pages[] = {buf, data};
+  EXPECT_FALSE(disk_mgr->ReadPages(checked, 2, pages));
+  auto io = disk_mgr->CreateAsyncIOContext(2);
+  std::vector<AsyncIOResult> results;
+  ASSERT_TRUE(disk_mgr->SubmitReadPage(io.get(), checked, buf, 0));
+  ASSERT_TRUE(disk_mgr->SubmitReadPage(io.get(), torn, data, 1));
+  ASSERT_EQ(2, disk_mgr->CompletePages(io.get(), &results, 2));
+  for (auto &result : results) {
+    EXPECT_EQ(result.tag == 0 ? PAGE_SIZE : -EIO, result.result);
+  }
+  EXPECT_EQ(3, disk_mgr->GetChecksumFailureCount());
+  io.reset();
+
+  // with checksums off again, a rewritten page drops its stale checksum instead of failing verification later
+  disk_mgr->EnableChecksums(false);
+  memcpy(data, random, PAGE_SIZE);
+  disk_mgr->WritePage(checked, data);
+  EXPECT_EQ(0, Page(data).GetChecksum());
+  EXPECT_TRUE(disk_mgr->EnableChecksums(true));
+  EXPECT_TRUE(disk_mgr->ReadPage(checked, buf));
+  delete disk_mgr;
+
+  // a file from before the trailer keeps page data in it and refuses checksums
+  fd = open(db_name.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  uint32_t old_format = 0;
+  ASSERT_EQ(sizeof(old_format), pwrite(fd, &old_format, sizeof(old_format), DiskFileMetaPage::OFFSET_FORMAT));
+  close(fd);
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_FALSE(disk_mgr->EnableChecksums(true));
+  EXPECT_FALSE(disk_mgr->IsChecksumEnabled());
+  memcpy(data, random, PAGE_SIZE);
+  disk_mgr->WritePage(plain, data);
+  ASSERT_TRUE(disk_mgr->ReadPage(plain, buf));
+  EXPECT_EQ(0, memcmp(buf, random, PAGE_SIZE));
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, DISABLED_ChecksumBenchmark) {
+  std::string db_name = "disk_checksum_bench.db";
+  remove(db_name.c_str());
+  const size_t num_pages = 16384;
+  const size_t run_length = 32;
+  auto *disk_mgr = new DiskManager(db_name);
+  disk_mgr->EnableChecksums(true);
+  std::vector<char> data(run_length * PAGE_SIZE);
+  std::vector<char *> pages(run_length);
+  std::mt19937 rng(7);
+  for (size_t i = 0; i < run_length; i++) {
+    pages[i] = data.data() + i * PAGE_SIZE;
+  }
+  for (auto &c : data) {
+    c = static_cast<char>(rng());
+  }
+  for (size_t i = 0; i < num_pages; i += run_length) {
+    for (size_t j = 0; j < run_length; j++) {
+      ASSERT_EQ(i + j, disk_mgr->AllocatePage());
+    }
+    disk_mgr->WritePages(i, run_length, pages.data());
+  }
+  const double gb = static_cast<double>(num_pages) * PAGE_SIZE / (1 << 30);
+
+  // cached sequential reads of the whole file, the first round warms the page cache
+  double seconds[2];
+  for (int round = 0; round < 3; round++) {
+    bool verify = round == 2;
+    disk_mgr->EnableChecksums(verify);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_pages; i += run_length) {
+      ASSERT_TRUE(disk_mgr->ReadPages(i, run_length, pages.data()));
+    }
+    seconds[verify] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  auto start = std::chrono::steady_clock::now();
+  uint32_t crc = 0;
+  for (size_t i = 0; i < num_pages; i++) {
+    crc ^= Crc32cSoftware(pages[i % run_length], PAGE_SIZE - PAGE_CHECKSUM_SIZE);
+  }
+  double software = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "[DiskManager] checksums hardware=" << Crc32cIsHardware()
+            << " read ms/GB plain=" << static_cast<size_t>(seconds[0] / gb * 1000)
+            << " verified=" << static_cast<size_t>(seconds[1] / gb * 1000)
+            << " software crc ms/GB=" << static_cast<size_t>(software / gb * 1000) << " (" << crc % 2 << ")"
+            << std::endl;
+  EXPECT_EQ(0, disk_mgr->GetChecksumFailureCount());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, CompressionTest) {
+  // the codec round trips repetitive, random and tiny inputs, and rejects what it cannot decode
+  std::mt19937 rng(11);
+  char page[PAGE_SIZE], compressed[2 * PAGE_SIZE], out[PAGE_SIZE];
+  for (int kind = 0; kind < 4; kind++) {
+    for (size_t i = 0; i < PAGE_SIZE; i++) {
+      char values[] = {0, static_cast<char>('a' + i % 7), static_cast<char>(rng()), static_cast<char>(rng() % 4)};
+      page[i] = values[kind];
+    }
+    if (kind == 2) {
+      EXPECT_EQ(0, LzCompress(page, PAGE_SIZE, compressed, PAGE_SIZE));  // random data does not compress
+    }
+    size_t len = LzCompress(page, PAGE_SIZE, compressed, sizeof(compressed));
+    ASSERT_NE(0, len);
+    ASSERT_TRUE(LzDecompress(compressed, len, out, PAGE_SIZE));
+    EXPECT_EQ(0, memcmp(page, out, PAGE_SIZE));
+    EXPECT_FALSE(LzDecompress(compressed, len - 1, out, PAGE_SIZE));
+    EXPECT_FALSE(LzDecompress(compressed, len, out, PAGE_SIZE - 1));
+  }
+  for (size_t len = 0; len < 20; len++) {
+    size_t n = LzCompress(page, len, compressed, PAGE_SIZE);
+    ASSERT_TRUE(LzDecompress(compressed, n, out, len));
+    EXPECT_EQ(0, memcmp(page, out, len));
+  }
+
+  // pages of a compressed file survive rewrites that grow and shrink them, deallocation and reopening
+  std::string db_name = "disk_compressed_test.db";
+  remove(db_name.c_str());
+  remove(DiskManager::PageMapFile(db_name).c_str());
+  const size_t num_pages = 64;
+  std::vector<std::vector<char>> contents(num_pages, std::vector<char>(PAGE_SIZE));
+  auto fill = [&rng, &contents](size_t i, int entropy) {
+    for (auto &c : contents[i]) {
+      c = static_cast<char>(rng() % entropy);
+    }
+  };
+  auto *disk_mgr = new DiskManager(db_name, false, true);
+  ASSERT_TRUE(disk_mgr->IsCompressed());
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    fill(i, 1 + i % 3);
+    disk_mgr->WritePage(i, contents[i].data());
+  }
+  for (size_t i = 0; i < num_pages; i += 2) {
+    fill(i, i % 4 == 0 ? 256 : 1);
+    disk_mgr->WritePage(i, contents[i].data());
+  }
+  disk_mgr->DeAllocatePage(num_pages - 1);
+  std::fill(contents[num_pages - 1].begin(), contents[num_pages - 1].end(), 0);
+  delete disk_mgr;
+  struct stat st;
+  ASSERT_EQ(0, stat(db_name.c_str(), &st));
+  EXPECT_LT(st.st_size, static_cast<off_t>(num_pages * PAGE_SIZE));  // a quarter of the pages are incompressible
+
+  disk_mgr = new DiskManager(db_name);
+  ASSERT_TRUE(disk_mgr->IsCompressed());
+  EXPECT_TRUE(disk_mgr->IsPageFree(num_pages - 1));
+  char buf[PAGE_SIZE];
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_TRUE(disk_mgr->ReadPage(i, buf));
+    EXPECT_EQ(0, memcmp(buf, contents[i].data(), PAGE_SIZE)) << "page " << i;
+  }
+  std::vector<char *> pages;
+  for (size_t i = 0; i < 4; i++) {
+    pages.push_back(contents[i].data());
+  }
+  auto io = disk_mgr->CreateAsyncIOContext(4);
+  std::vector<iovec> iov{{buf, PAGE_SIZE}};
+  std::vector<AsyncIOResult> results;
+  ASSERT_TRUE(disk_mgr->SubmitReadPages(io.get(), 1, iov.data(), 1, 7));
+  ASSERT_EQ(1, disk_mgr->CompletePages(io.get(), &results, 1));
+  EXPECT_EQ(PAGE_SIZE, results[0].result);
+  EXPECT_EQ(0, memcmp(buf, contents[1].data(), PAGE_SIZE));
+  io.reset();
+  delete disk_mgr;
+
+  // a rewrite goes to a fresh slot, after a crash the synced map still reads the page as it was
+  std::string store_name = "disk_compressed_store.db";
+  std::string map_name = DiskManager::PageMapFile(store_name);
+  remove(map_name.c_str());
+  int fd = open(store_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  {
+    CompressedPageStore store(fd, map_name, false);
+    ASSERT_TRUE(store.Write(0, contents[0].data()));
+    ASSERT_TRUE(store.Write(1, contents[1].data()));
+    ASSERT_TRUE(store.Flush(true));
+    ASSERT_TRUE(store.Write(0, contents[2].data()));
+    store.Free(1);
+    ASSERT_TRUE(store.Write(2, contents[3].data()));  // must not take the slot of page 0 or 1
+    CompressedPageStore crashed(fd, map_name, true);  // reads the map on disk, as after a crash
+    ASSERT_TRUE(crashed.Read(0, buf));
+    EXPECT_EQ(0, memcmp(buf, contents[0].data(), PAGE_SIZE));
+    ASSERT_TRUE(crashed.Read(1, buf));
+    EXPECT_EQ(0, memcmp(buf, contents[1].data(), PAGE_SIZE));
+    ASSERT_TRUE(store.Flush(true));
+    CompressedPageStore synced(fd, map_name, true);
+    ASSERT_TRUE(synced.Read(0, buf));
+    EXPECT_EQ(0, memcmp(buf, contents[2].data(), PAGE_SIZE));
+    EXPECT_NE(0, access((map_name + ".tmp").c_str(), F_OK));  // renamed over the map file
+  }
+  close(fd);
+  remove(map_name.c_str());
+  remove(store_name.c_str());
+
+  // a plain file cannot be opened compressed
+  remove(DiskManager::PageMapFile(db_name).c_str());
+  EXPECT_THROW(DiskManager(db_name, false, true), std::exception);
+  remove(DiskManager::PageMapFile(db_name).c_str());
+  remove(db_name.c_str());
+}
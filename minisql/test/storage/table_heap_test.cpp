@@ -1,5 +1,10 @@
 #include "storage/table_heap.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
 #include <unordered_map>
 #include <vector>
 
@@ -61,3 +66,356 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   }
   ASSERT_EQ(size, 0);
 }
+
+static void ColdSequentialScan(int row_nums) {
+  remove(db_file_name.c_str());
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  page_id_t first_page_id;
+  {
+    auto disk_mgr = new DiskManager(db_file_name);
+    auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+    TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+    char characters[64];
+    memset(characters, 'a', sizeof(characters));
+    for (int i = 0; i < row_nums; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+      Row row(fields);
+      ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    }
+    first_page_id = table_heap->GetFirstPageId();
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+
+  for (bool read_ahead : {false, true}) {
+    // Evict the file from the OS page cache as well, so that every buffer pool miss goes to the device.
+    int fd = open(db_file_name.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+
+    auto disk_mgr = new DiskManager(db_file_name);
+    auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+    bpm->SetReadAhead(read_ahead);
+    TableHeap *table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    int count = 0;
+    for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+      count++;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(row_nums, count);
+    std::cout << "[TableHeap] cold scan read-ahead=" << (read_ahead ? "on" : "off") << " rows=" << count
+              << " misses=" << bpm->GetMissCount() << " ms=" << elapsed.count() << std::endl;
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, ColdSequentialScanTest) { ColdSequentialScan(2000); }
+
+TEST(TableHeapTest, DISABLED_ColdSequentialScanBenchmark) { ColdSequentialScan(20000); }
+
+static void MappedScan(int row_nums) {
+  remove(db_file_name.c_str());
+  const size_t pool_size = 256;  // smaller than the table, buffered scans have to evict
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  page_id_t first_page_id;
+  {
+    auto disk_mgr = new DiskManager(db_file_name);
+    auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+    TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+    char characters[64];
+    memset(characters, 'a', sizeof(characters));
+    for (int i = 0; i < row_nums; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+      Row row(fields);
+      ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    }
+    first_page_id = table_heap->GetFirstPageId();
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+
+  for (bool read_only : {false, true}) {
+    auto disk_mgr = new DiskManager(db_file_name, read_only);
+    auto bpm = new BufferPoolManager(pool_size, disk_mgr);
+    ASSERT_EQ(read_only, bpm->IsReadOnly());
+    bpm->SetReadAhead(false);
+    TableHeap *table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    const int scans = 3;
+    int64_t sum = 0;
+    for (int i = 0; i < scans; i++) {
+      for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+        sum += iter->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, 0)) == CmpBool::kTrue ? 1 : 0;
+      }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(scans, sum);
+    ASSERT_TRUE(bpm->CheckAllUnpinned());
+    std::cout << "[TableHeap] warm scan mode=" << (read_only ? "mmap" : "buffered") << " rows=" << row_nums
+              << " ms/scan=" << elapsed.count() / scans << std::endl;
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+  // a mapped database cannot grow
+  auto disk_mgr = new DiskManager(db_file_name, true);
+  auto bpm = new BufferPoolManager(pool_size, disk_mgr);
+  page_id_t page_id;
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  EXPECT_FALSE(bpm->DeletePage(first_page_id));
+  delete bpm;
+  delete disk_mgr;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, MappedScanTest) { MappedScan(3000); }
+
+TEST(TableHeapTest, DISABLED_MappedScanBenchmark) { MappedScan(30000); }
+
+static void CompressedScan(int row_nums) {
+  const size_t pool_size = 256;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::string map_file_name = DiskManager::PageMapFile(db_file_name);
+  for (bool compressed : {false, true}) {
+    remove(db_file_name.c_str());
+    remove(map_file_name.c_str());
+    page_id_t first_page_id;
+    {
+      auto disk_mgr = new DiskManager(db_file_name, false, compressed);
+      auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+      TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+      char characters[64];
+      for (int i = 0; i < row_nums; i++) {
+        // names share most of their bytes, like the text columns of real tables
+        snprintf(characters, sizeof(characters), "customer-%08d-%s", i % 1000, "zhejiang-university-hangzhou");
+        Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+        Row row(fields);
+        ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+      }
+      first_page_id = table_heap->GetFirstPageId();
+      delete table_heap;
+      delete bpm;
+      delete disk_mgr;
+    }
+    struct stat st;
+    off_t file_size = 0;
+    for (auto *name : {&db_file_name, &map_file_name}) {
+      if (stat(name->c_str(), &st) == 0) {
+        file_size += st.st_size;
+      }
+    }
+
+    for (bool read_only : {false, true}) {
+      auto disk_mgr = new DiskManager(db_file_name, read_only);
+      ASSERT_EQ(compressed, disk_mgr->IsCompressed());
+      auto bpm = new BufferPoolManager(pool_size, disk_mgr);
+      bpm->SetReadAhead(false);
+      TableHeap *table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr);
+      auto start = std::chrono::steady_clock::now();
+      const int scans = 3;
+      int64_t sum = 0;
+      for (int i = 0; i < scans; i++) {
+        for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+          sum += iter->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, 0)) == CmpBool::kTrue ? 1 : 0;
+        }
+      }
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+      ASSERT_EQ(scans, sum);
+      ASSERT_TRUE(bpm->CheckAllUnpinned());
+      std::cout << "[TableHeap] scan compressed=" << compressed << " mode=" << (read_only ? "read-only" : "buffered")
+                << " rows=" << row_nums << " file_bytes=" << file_size
+                << " bytes/row=" << static_cast<double>(file_size) / row_nums
+                << " ms/scan=" << elapsed.count() / scans << std::endl;
+      delete table_heap;
+      delete bpm;
+      delete disk_mgr;
+    }
+  }
+  remove(db_file_name.c_str());
+  remove(map_file_name.c_str());
+}
+
+TEST(TableHeapTest, CompressedScanTest) { CompressedScan(3000); }
+
+TEST(TableHeapTest, DISABLED_CompressedScanBenchmark) { CompressedScan(30000); }
+
+TEST(TableHeapTest, DISABLED_InsertLatencyBenchmark) {
+  remove(db_file_name.c_str());
+  const int max_rows = 1000000;
+  const size_t pool_size = 1024;  // much smaller than the table once it grows
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  auto disk_mgr = new DiskManager(db_file_name);
+  auto bpm = new BufferPoolManager(pool_size, disk_mgr);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  char characters[32];
+  memset(characters, 'a', sizeof(characters));
+  int inserted = 0;
+  for (int checkpoint = 1000; checkpoint <= max_rows; checkpoint *= 10) {
+    // time the last thousand inserts before every checkpoint
+    const int window = 1000;
+    std::chrono::duration<double, std::micro> elapsed{0};
+    for (; inserted < checkpoint; inserted++) {
+      Fields fields{Field(TypeId::kTypeInt, inserted), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+      Row row(fields);
+      auto start = std::chrono::steady_clock::now();
+      ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+      if (inserted >= checkpoint - window) {
+        elapsed += std::chrono::steady_clock::now() - start;
+      }
+    }
+    std::cout << "[TableHeap] insert rows=" << checkpoint << " us/insert=" << elapsed.count() / window << std::endl;
+  }
+  ASSERT_TRUE(bpm->CheckAllUnpinned());
+  // delete a slice of rows in the middle of the table, later inserts fill the holes before growing the table
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    last_page_id = std::max(last_page_id, iter->GetRowId().GetPageId());
+  }
+  int deleted = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End() && deleted < 20000; ++iter) {
+    if (iter->GetField(0)->CompareGreaterThanEquals(Field(TypeId::kTypeInt, max_rows / 2)) == CmpBool::kTrue) {
+      table_heap->ApplyDelete(iter->GetRowId(), nullptr);
+      deleted++;
+    }
+  }
+  for (int i = 0; i < deleted - 1000; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    ASSERT_LE(row.GetRowId().GetPageId(), last_page_id);
+  }
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, FreeSpaceMapTest) {
+  remove(db_file_name.c_str());
+  const int row_nums = 20000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  char characters[64];
+  memset(characters, 'a', sizeof(characters));
+  auto disk_mgr = new DiskManager(db_file_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  page_id_t first_page_id = table_heap->GetFirstPageId();
+  page_id_t map_page_id = table_heap->GetFreeSpaceMapPageId();
+  ASSERT_NE(INVALID_PAGE_ID, map_page_id);
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  // free every other row of the first half of the table
+  for (int i = 0; i < row_nums / 2; i += 2) {
+    table_heap->ApplyDelete(rids[i], nullptr);
+  }
+  page_id_t last_page_id = rids.back().GetPageId();
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+
+  // the map is persisted, and also rebuilt from the page chain when the heap is opened without it
+  int expected = row_nums - row_nums / 4;
+  for (page_id_t open_map_page_id : {map_page_id, INVALID_PAGE_ID}) {
+    disk_mgr = new DiskManager(db_file_name);
+    bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+    table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr, open_map_page_id);
+    EXPECT_EQ(open_map_page_id, table_heap->GetFreeSpaceMapPageId());
+    for (int i = 0; i < row_nums / 16; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+      Row row(fields);
+      ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+      ASSERT_LE(row.GetRowId().GetPageId(), rids[row_nums / 2].GetPageId());
+    }
+    int count = 0;
+    for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+      ASSERT_LE(iter->GetRowId().GetPageId(), last_page_id);
+      count++;
+    }
+    expected += row_nums / 16;
+    EXPECT_EQ(expected, count);
+    ASSERT_TRUE(bpm->CheckAllUnpinned());
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+  remove(db_file_name.c_str());
+}
+
+static void BulkInsert(int row_nums) {
+  const size_t batch_size = 1024;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  char characters[32];
+  memset(characters, 'a', sizeof(characters));
+  for (bool bulk : {false, true}) {
+    remove(db_file_name.c_str());
+    auto disk_mgr = new DiskManager(db_file_name);
+    auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+    TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+    std::vector<RowId> rids;
+    std::vector<Row> batch;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < row_nums; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), false)};
+      if (!bulk) {
+        Row row(fields);
+        ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+        rids.push_back(row.GetRowId());
+        continue;
+      }
+      batch.emplace_back(fields);
+      if (batch.size() == batch_size || i == row_nums - 1) {
+        ASSERT_EQ(batch.size(), table_heap->BulkInsert(batch, nullptr));
+        for (auto &row : batch) {
+          rids.push_back(row.GetRowId());
+        }
+        batch.clear();
+      }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[TableHeap] load mode=" << (bulk ? "bulk" : "row") << " rows=" << row_nums
+              << " ms=" << elapsed.count() << " rows/s=" << row_nums / elapsed.count() * 1000 << std::endl;
+
+    // rows come back in insertion order, from the rids they were given
+    ASSERT_TRUE(bpm->CheckAllUnpinned());
+    int count = 0;
+    for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+      ASSERT_EQ(rids[count].Get(), iter->GetRowId().Get());
+      ASSERT_EQ(CmpBool::kTrue, iter->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, count)));
+      count++;
+    }
+    ASSERT_EQ(row_nums, count);
+    delete table_heap;
+    delete bpm;
+    delete disk_mgr;
+  }
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, BulkInsertTest) { BulkInsert(5000); }
+
+TEST(TableHeapTest, DISABLED_BulkInsertBenchmark) { BulkInsert(200000); }